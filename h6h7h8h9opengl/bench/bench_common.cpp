@@ -0,0 +1,69 @@
+#include "bench_common.h"
+#include "mesh_io.h"
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <sys/resource.h>
+
+namespace meshbench {
+
+const std::vector<std::string>& benchmarkModels()
+{
+    static const std::vector<std::string> models = {
+        "bunny.obj",
+        "armadillo.obj",
+        "spot_triangulated_good.obj",
+        "Nefertiti_face.obj",
+    };
+    return models;
+}
+
+std::string modelPath(const std::string& name)
+{
+    const char* dir = std::getenv("MESHBENCH_MODELS");
+    return std::string(dir ? dir : MESHBENCH_MODELS_DIR) + "/" + name;
+}
+
+const Mesh* loadModel(const std::string& name)
+{
+    static std::map<std::string, std::unique_ptr<Mesh>> cache;
+    auto it = cache.find(name);
+    if (it != cache.end()) return it->second.get();
+
+    std::unique_ptr<Mesh> mesh(new Mesh);
+    if (!meshcore::loadMesh(*mesh, modelPath(name))) {
+        mesh.reset();
+    } else {
+        // 与查看器一致：中心化并缩放到[-1,1]
+        meshcore::normalizeMesh(*mesh);
+        mesh->update_normals();
+    }
+    return (cache[name] = std::move(mesh)).get();
+}
+
+void registerPerModel(const char* name, BenchmarkFn fn)
+{
+    for (const std::string& model : benchmarkModels()) {
+        benchmark::RegisterBenchmark((std::string(name) + "/" + model).c_str(), fn, model)
+            ->Unit(benchmark::kMillisecond);
+    }
+}
+
+// Linux下ru_maxrss单位为KB
+static double peakRssMegabytes()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+void reportThroughput(benchmark::State& state, size_t verticesPerIteration)
+{
+    state.counters["vertices/s"] = benchmark::Counter(
+        static_cast<double>(verticesPerIteration) * state.iterations(),
+        benchmark::Counter::kIsRate);
+    state.counters["vertices"] = static_cast<double>(verticesPerIteration);
+    state.counters["peak_rss_MB"] = peakRssMegabytes();
+}
+
+} // namespace meshbench
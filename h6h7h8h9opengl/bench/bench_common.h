@@ -0,0 +1,36 @@
+#ifndef MESHBENCH_BENCH_COMMON_H
+#define MESHBENCH_BENCH_COMMON_H
+
+#include "mesh_types.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace meshbench {
+
+// Models every kernel is run against (基准使用的模型)
+const std::vector<std::string>& benchmarkModels();
+
+// Absolute path of a bundled model (模型文件的绝对路径)
+std::string modelPath(const std::string& name);
+
+// Loaded and normalized mesh, cached for the whole run; nullptr if missing
+// 加载并归一化后的网格，整个运行期间缓存；文件不存在时返回nullptr
+const Mesh* loadModel(const std::string& name);
+
+// Benchmark body taking the model file name (以模型文件名为参数的基准函数)
+typedef void (*BenchmarkFn)(benchmark::State&, const std::string&);
+
+// Register `fn` once per benchmark model as "<name>/<model>" (为每个模型注册一次基准)
+void registerPerModel(const char* name, BenchmarkFn fn);
+
+// Registration entry points, one per bench_*.cpp (各bench_*.cpp的注册入口)
+void registerGeometryBenchmarks();
+void registerIoBenchmarks();
+
+// Attach vertices/s and peak RSS counters (添加顶点吞吐量与峰值内存计数器)
+void reportThroughput(benchmark::State& state, size_t verticesPerIteration);
+
+} // namespace meshbench
+
+#endif // MESHBENCH_BENCH_COMMON_H
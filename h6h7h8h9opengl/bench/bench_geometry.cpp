@@ -0,0 +1,508 @@
+// Throughput of the meshcore geometry kernels on the bundled models
+// 在自带模型上测量meshcore几何内核的吞吐量
+#include "bench_common.h"
+#include "arap_parameterization.h"
+#include "chart_atlas.h"
+#include "attribute_simplification.h"
+#include "conformal_parameterization.h"
+#include "curvature.h"
+#include "dirty_region.h"
+#include "laplacian.h"
+#include "jacobi_smoother.h"
+#include "mesh_distance.h"
+#include "minimal_surface.h"
+#include "loop_subdivision.h"
+#include "mesh_io.h"
+#include "mesh_simplification.h"
+#include "parallel_simplification.h"
+#include "parameterization.h"
+#include "progressive_mesh.h"
+#include "solver_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using meshbench::loadModel;
+using meshbench::reportThroughput;
+
+namespace {
+
+const int kSmoothingSteps = 10;   // 每次基准迭代执行的平滑步数
+
+// 模型缺失时跳过，返回nullptr
+const Mesh* requireModel(benchmark::State& state, const std::string& model)
+{
+    const Mesh* mesh = loadModel(model);
+    if (!mesh) {
+        state.SkipWithError(("cannot load " + meshbench::modelPath(model)).c_str());
+    }
+    return mesh;
+}
+
+// 对网格副本运行一次会修改网格的操作；复制不计入耗时
+void runOnCopy(benchmark::State& state, const Mesh& source, size_t verticesPerIteration,
+               const std::function<bool(Mesh&)>& op)
+{
+    Mesh work;
+    for (auto _ : state) {
+        state.PauseTiming();
+        work = source;
+        state.ResumeTiming();
+        if (!op(work)) {
+            state.SkipWithError("operation failed (mesh without boundary?)");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, verticesPerIteration);
+}
+
+void BM_Curvature(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    Mesh work = *source;
+    for (auto _ : state) {
+        meshcore::calculateCurvatures(work, meshcore::CurvatureType::Mean);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, work.n_vertices());
+}
+
+// 一次计算全部曲率场并写入顶点属性（查看器使用的路径）
+void BM_CurvatureFields(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    Mesh work = *source;
+    for (auto _ : state) {
+        meshcore::updateCurvatureProperties(work);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, work.n_vertices());
+}
+
+// 局部编辑后的增量更新：移动约1%的相邻顶点，只重新计算其附近的法线与曲率
+void BM_DirtyCurvatureUpdate(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    Mesh work = *source;
+    meshcore::updateCurvatureProperties(work);
+
+    std::vector<unsigned int> patch(1, 0);
+    while (patch.size() < work.n_vertices() / 100) {
+        const size_t before = patch.size();
+        meshcore::expandOneRing(work, patch);
+        if (patch.size() == before) break;
+    }
+
+    std::vector<unsigned int> updated;
+    float offset = 1e-4f;
+    for (auto _ : state) {
+        for (unsigned int v : patch) {
+            Mesh::VertexHandle vh(v);
+            work.set_point(vh, work.point(vh) + work.normal(vh) * offset);
+            meshcore::markDirty(work, vh);
+        }
+        offset = -offset;
+        meshcore::updateDirtyNormals(work);
+        meshcore::updateDirtyCurvature(work, updated);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, patch.size());
+}
+
+// 形状算子拟合的主曲率与主方向
+void BM_PrincipalCurvatures(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::PrincipalCurvatures result;
+    for (auto _ : state) {
+        meshcore::computePrincipalCurvatures(*source, result);
+        benchmark::DoNotOptimize(result.k1.data());
+    }
+    reportThroughput(state, source->n_vertices());
+}
+
+// 余切拉普拉斯算子的CSR组装（平滑与求解共用）
+void BM_LaplacianBuild(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::LaplacianOperator op;
+    for (auto _ : state) {
+        meshcore::buildLaplacian(*source, meshcore::LaplacianWeights::Cotangent, op);
+        benchmark::DoNotOptimize(op.values.data());
+    }
+    reportThroughput(state, source->n_vertices());
+}
+
+// 扁平Jacobi内核本身：1000步均匀拉普拉斯平滑（不含网格读写）
+void BM_JacobiKernel(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::LaplacianOperator op;
+    meshcore::buildLaplacian(*source, meshcore::LaplacianWeights::Uniform, op);
+    meshcore::SmoothingStep step;
+    step.weights.resize(op.nonZeros());
+    step.scale.assign(op.vertexCount(), 1.0f);
+    for (size_t i = 0; i < op.vertexCount(); ++i) {
+        for (unsigned int k = op.begin(i); k < op.end(i); ++k) {
+            step.weights[k] = 1.0f / (op.end(i) - op.begin(i));
+        }
+    }
+    meshcore::PositionArrays initial;
+    initial.resize(source->n_vertices());
+    for (auto vh : source->vertices()) {
+        const Mesh::Point& p = source->point(vh);
+        initial.x[vh.idx()] = p[0];
+        initial.y[vh.idx()] = p[1];
+        initial.z[vh.idx()] = p[2];
+    }
+    const int kIterations = 1000;
+    for (auto _ : state) {
+        state.PauseTiming();
+        meshcore::PositionArrays positions = initial;
+        state.ResumeTiming();
+        meshcore::jacobiSmooth(op, step, positions, kIterations, 0.5f);
+        benchmark::DoNotOptimize(positions.x.data());
+    }
+    state.SetLabel(meshcore::jacobiSmootherUsesAvx2() ? "avx2" : "scalar");
+    reportThroughput(state, source->n_vertices() * kIterations);
+}
+
+void BM_MixedArea(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    for (auto _ : state) {
+        float total = 0.0f;
+        for (auto vh : source->vertices()) {
+            total += meshcore::calculateMixedArea(*source, vh);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    reportThroughput(state, source->n_vertices());
+}
+
+void BM_UniformLaplacian(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices() * kSmoothingSteps, [](Mesh& mesh) {
+        meshcore::uniformLaplacianIteration(mesh, kSmoothingSteps, 0.1f);
+        return true;
+    });
+}
+
+void BM_CotangentWeights(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices() * kSmoothingSteps, [](Mesh& mesh) {
+        meshcore::cotangentWeightsIteration(mesh, kSmoothingSteps, 0.1f);
+        return true;
+    });
+}
+
+void BM_CotangentWithArea(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices() * kSmoothingSteps, [](Mesh& mesh) {
+        meshcore::cotangentWithAreaIteration(mesh, kSmoothingSteps, 0.1f);
+        return true;
+    });
+}
+
+// 隐式光顺：5个大步长（lambda = 10）
+void BM_ImplicitFairing(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    const int kSteps = 5;
+    runOnCopy(state, *source, source->n_vertices() * kSteps, [](Mesh& mesh) {
+        return meshcore::implicitFairingIteration(mesh, kSteps, 10.0f);
+    });
+}
+
+void BM_MinimalSurfaceSolve(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices(), [](Mesh& mesh) {
+        return meshcore::solveMinimalSurface(mesh);
+    });
+}
+
+// 同一网格重复求解：符号分析与数值分解都来自缓存，只剩分块回代
+void BM_MinimalSurfaceCachedSolve(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::DirichletSolverCache cache;
+    runOnCopy(state, *source, source->n_vertices(), [&cache](Mesh& mesh) {
+        return meshcore::solveMinimalSurface(mesh, &cache);
+    });
+    state.counters["factorizations"] = cache.numericCount();
+}
+
+// 预处理共轭梯度（不完全Cholesky），每次从原始位置出发
+void BM_MinimalSurfaceCG(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::DirichletSolverCache cache;
+    cache.setMethod(meshcore::DirichletMethod::ConjugateGradient);
+    runOnCopy(state, *source, source->n_vertices(), [&cache](Mesh& mesh) {
+        return meshcore::solveMinimalSurface(mesh, &cache);
+    });
+    state.counters["iterations"] = cache.lastStats().iterations;
+    state.counters["residual"] = cache.lastStats().residual;
+}
+
+// 代数多重网格预处理CG（大网格上Auto的选择）
+void BM_MinimalSurfaceAMG(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::DirichletSolverCache cache;
+    cache.setMethod(meshcore::DirichletMethod::Multigrid);
+    runOnCopy(state, *source, source->n_vertices(), [&cache](Mesh& mesh) {
+        return meshcore::solveMinimalSurface(mesh, &cache);
+    });
+    state.counters["iterations"] = cache.lastStats().iterations;
+    state.counters["levels"] = cache.lastStats().levels;
+}
+
+void BM_Parameterization(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices(), [](Mesh& mesh) {
+        return meshcore::parameterize(mesh, meshcore::ParamBoundary::Rectangle);
+    });
+}
+
+// 自由边界LSCM：每次迭代新建缓存，计入符号分析与分解
+void BM_ConformalParameterization(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices(), [](Mesh& mesh) {
+        return meshcore::conformalParameterize(mesh);
+    });
+}
+
+// LSCM初值加10次ARAP迭代；全局步的分解每次调用只做一次
+void BM_ArapParameterization(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices(), [](Mesh& mesh) {
+        return meshcore::arapParameterize(mesh, 10);
+    });
+}
+
+// 切分图块、并行LSCM与打包；封闭模型同样适用
+void BM_ChartAtlas(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::FlatMesh flat;
+    meshcore::toFlatMesh(*source, flat);
+    meshcore::ChartAtlas atlas;
+    for (auto _ : state) {
+        meshcore::buildChartAtlas(flat, meshcore::ChartAtlasOptions(), atlas);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, source->n_vertices());
+    state.counters["charts"] = static_cast<double>(atlas.chartCount);
+}
+
+// 只计打包：最多8个面一块得到上万个小图块，以图集结果为输入反复重新打包
+void BM_AtlasPacking(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::ChartAtlasOptions options;
+    options.maxChartFaces = 8;
+    meshcore::ChartAtlas atlas;
+    if (!meshcore::buildChartAtlas(*source, options, atlas)) {
+        state.SkipWithError("chart atlas failed");
+        return;
+    }
+    const std::vector<double> uv(atlas.texCoords.begin(), atlas.texCoords.end());
+    std::vector<float> texCoords;
+    meshcore::AtlasPackResult result;
+    for (auto _ : state) {
+        meshcore::packAtlas(atlas.chartBegin, uv, options.packing, texCoords, &result);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, uv.size() / 2);
+    state.counters["charts"] = static_cast<double>(atlas.chartCount);
+    state.counters["fill"] = result.fill;
+}
+
+void BM_LoopSubdivision(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    runOnCopy(state, *source, source->n_vertices(), [](Mesh& mesh) {
+        return meshcore::loopSubdivide(mesh, 1);
+    });
+}
+
+// 扁平内核连续细分三级并写出最后一级的边索引；吞吐量按输出顶点计
+void BM_FlatLoopSubdivision(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::FlatMesh control, work;
+    meshcore::toFlatMesh(*source, control);
+    std::vector<unsigned int> edges;
+    for (auto _ : state) {
+        state.PauseTiming();
+        work = control;
+        state.ResumeTiming();
+        meshcore::loopSubdivide(work, 3, &edges);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, work.vertexCount());
+}
+
+// 简化结果与原网格的双向Hausdorff距离，按原网格包围盒对角线归一化；不计入耗时
+void reportHausdorff(benchmark::State& state, const Mesh& source, const Mesh& simplified)
+{
+    meshcore::FlatMesh a, b;
+    meshcore::toFlatMesh(source, a);
+    meshcore::toFlatMesh(simplified, b);
+    float lo[3] = {a.positions[0], a.positions[1], a.positions[2]};
+    float hi[3] = {lo[0], lo[1], lo[2]};
+    for (size_t i = 0; i < a.positions.size(); ++i) {
+        lo[i % 3] = std::min(lo[i % 3], a.positions[i]);
+        hi[i % 3] = std::max(hi[i % 3], a.positions[i]);
+    }
+    const double diagonal = std::sqrt(double(hi[0] - lo[0]) * (hi[0] - lo[0]) + double(hi[1] - lo[1]) * (hi[1] - lo[1])
+                                      + double(hi[2] - lo[2]) * (hi[2] - lo[2]));
+    const meshcore::SurfaceDistance distance = meshcore::hausdorffDistance(a, b);
+    state.counters["hausdorff"] = diagonal > 0.0 ? distance.maximum / diagonal : 0.0;
+    state.counters["mean_dist"] = diagonal > 0.0 ? distance.mean / diagonal : 0.0;
+    state.counters["faces_out"] = static_cast<double>(simplified.n_faces());
+}
+
+// 简化一半顶点：串行OpenMesh简化器（ModQuadricT）与并行独立集分批，比较耗时与Hausdorff距离
+void runDecimation(benchmark::State& state, const std::string& model, bool (*simplify)(Mesh&, float))
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source || source->n_vertices() == 0) return;
+    Mesh work;
+    for (auto _ : state) {
+        state.PauseTiming();
+        work = *source;
+        state.ResumeTiming();
+        if (!simplify(work, 0.5f)) {
+            state.SkipWithError("simplification failed");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, source->n_vertices());
+    reportHausdorff(state, *source, work);
+}
+
+void BM_QemDecimation(benchmark::State& state, const std::string& model)
+{
+    runDecimation(state, model, meshcore::simplifyMesh);
+}
+
+void BM_ParallelQem(benchmark::State& state, const std::string& model)
+{
+    runDecimation(state, model, meshcore::simplifyMeshParallel);
+}
+
+void BM_AttributeQem(benchmark::State& state, const std::string& model)
+{
+    runDecimation(state, model, meshcore::simplifyMeshWithAttributes);
+}
+
+// 一次记录整条折叠序列（滑块首次使用时的后台开销）
+void BM_ProgressiveBuild(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::FlatMesh flat;
+    meshcore::toFlatMesh(*source, flat);
+    meshcore::ProgressiveMesh pm;
+    for (auto _ : state) {
+        pm.build(flat);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, flat.vertexCount());
+}
+
+// 滑块拖动：在50%附近来回移动约1%的顶点，每步只改写其间折叠涉及的索引
+void BM_ProgressiveScrub(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = requireModel(state, model);
+    if (!source) return;
+    meshcore::ProgressiveMesh pm;
+    pm.build(*source);
+    meshcore::ProgressiveMesh::Level level;
+    pm.reset(level);
+    const size_t low = pm.collapsesForRatio(0.5f);
+    const size_t high = pm.collapsesForRatio(0.51f);
+    pm.seek(level, low);
+    bool forward = true;
+    for (auto _ : state) {
+        pm.seek(level, forward ? high : low);
+        forward = !forward;
+        benchmark::DoNotOptimize(level.faces.data());
+    }
+    reportThroughput(state, high - low);
+}
+
+} // namespace
+
+namespace meshbench {
+
+void registerGeometryBenchmarks()
+{
+    const std::pair<const char*, BenchmarkFn> kernels[] = {
+        {"Curvature", BM_Curvature},
+        {"CurvatureFields", BM_CurvatureFields},
+        {"PrincipalCurvatures", BM_PrincipalCurvatures},
+        {"DirtyCurvatureUpdate", BM_DirtyCurvatureUpdate},
+        {"MixedArea", BM_MixedArea},
+        {"LaplacianBuild", BM_LaplacianBuild},
+        {"JacobiKernel", BM_JacobiKernel},
+        {"UniformLaplacian", BM_UniformLaplacian},
+        {"CotangentWeights", BM_CotangentWeights},
+        {"CotangentWithArea", BM_CotangentWithArea},
+        {"ImplicitFairing", BM_ImplicitFairing},
+        {"MinimalSurfaceSolve", BM_MinimalSurfaceSolve},
+        {"MinimalSurfaceCachedSolve", BM_MinimalSurfaceCachedSolve},
+        {"MinimalSurfaceCG", BM_MinimalSurfaceCG},
+        {"MinimalSurfaceAMG", BM_MinimalSurfaceAMG},
+        {"Parameterization", BM_Parameterization},
+        {"ConformalParameterization", BM_ConformalParameterization},
+        {"ArapParameterization", BM_ArapParameterization},
+        {"ChartAtlas", BM_ChartAtlas},
+        {"AtlasPacking", BM_AtlasPacking},
+        {"LoopSubdivision", BM_LoopSubdivision},
+        {"FlatLoopSubdivision", BM_FlatLoopSubdivision},
+        {"QemDecimation", BM_QemDecimation},
+        {"ParallelQem", BM_ParallelQem},
+        {"AttributeQem", BM_AttributeQem},
+        {"ProgressiveBuild", BM_ProgressiveBuild},
+        {"ProgressiveScrub", BM_ProgressiveScrub},
+    };
+    for (const auto& kernel : kernels) {
+        registerPerModel(kernel.first, kernel.second);
+    }
+}
+
+} // namespace meshbench
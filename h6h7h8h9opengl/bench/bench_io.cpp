@@ -0,0 +1,131 @@
+// Load-path throughput: parallel OBJ reader and .mcache versus OpenMesh::IO::read_mesh
+// 加载路径吞吐量：并行OBJ解析器、.mcache缓存对比OpenMesh::IO::read_mesh
+#include "bench_common.h"
+#include "mesh_io.h"
+#include "obj_reader.h"
+#include "mesh_cache.h"
+#include <filesystem>
+#include <OpenMesh/Core/IO/MeshIO.hh>
+#include <cstdio>
+#include <sys/stat.h>
+
+namespace {
+
+// 文件大小，用于计算MB/s；文件不存在时跳过
+bool requireFile(benchmark::State& state, const std::string& path, size_t& bytes)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        state.SkipWithError(("cannot open " + path).c_str());
+        return false;
+    }
+    bytes = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+// 只解析到扁平数组
+void BM_ObjParse(benchmark::State& state, const std::string& model)
+{
+    const std::string path = meshbench::modelPath(model);
+    size_t bytes = 0;
+    if (!requireFile(state, path, bytes)) return;
+    meshcore::ObjData data;
+    for (auto _ : state) {
+        if (!meshcore::readObj(path, data)) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+        benchmark::DoNotOptimize(data.positions.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes) * state.iterations());
+    meshbench::reportThroughput(state, data.vertexCount());
+}
+
+// 解析并构建OpenMesh网格（当前加载路径）
+void BM_ObjLoad(benchmark::State& state, const std::string& model)
+{
+    const std::string path = meshbench::modelPath(model);
+    size_t bytes = 0;
+    if (!requireFile(state, path, bytes)) return;
+    size_t vertices = 0;
+    for (auto _ : state) {
+        Mesh mesh;
+        if (!meshcore::loadMesh(mesh, path)) {
+            state.SkipWithError("load failed");
+            break;
+        }
+        vertices = mesh.n_vertices();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes) * state.iterations());
+    meshbench::reportThroughput(state, vertices);
+}
+
+// 原先的加载路径，作为对照
+void BM_ObjLoadOpenMesh(benchmark::State& state, const std::string& model)
+{
+    const std::string path = meshbench::modelPath(model);
+    size_t bytes = 0;
+    if (!requireFile(state, path, bytes)) return;
+    size_t vertices = 0;
+    for (auto _ : state) {
+        Mesh mesh;
+        OpenMesh::IO::Options opt = OpenMesh::IO::Options::Default;
+        if (!OpenMesh::IO::read_mesh(mesh, path, opt)) {
+            state.SkipWithError("load failed");
+            break;
+        }
+        mesh.update_normals();
+        vertices = mesh.n_vertices();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes) * state.iterations());
+    meshbench::reportThroughput(state, vertices);
+}
+
+// 从.mcache缓存重建网格（缓存写在临时目录，不污染models目录）
+void BM_CacheLoad(benchmark::State& state, const std::string& model)
+{
+    const Mesh* source = meshbench::loadModel(model);
+    if (!source) {
+        state.SkipWithError(("cannot load " + meshbench::modelPath(model)).c_str());
+        return;
+    }
+    Mesh withCurvature = *source;
+    meshcore::updateCurvatureProperties(withCurvature);
+    std::vector<unsigned int> faces, edges;
+    meshcore::buildFaceIndices(withCurvature, faces);
+    meshcore::buildEdgeIndices(withCurvature, edges);
+    const std::string cachePath = (std::filesystem::temp_directory_path() / (model + ".mcache")).string();
+    if (!meshcore::writeMeshCache(cachePath, meshbench::modelPath(model), withCurvature, faces, edges)) {
+        state.SkipWithError("cannot write cache");
+        return;
+    }
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        meshcore::MappedMeshCache cache;
+        Mesh mesh;
+        if (!cache.open(cachePath, meshbench::modelPath(model)) || !cache.restoreMesh(mesh)) {
+            state.SkipWithError("cache load failed");
+            break;
+        }
+        bytes = cache.vertexBlockBytes();
+        benchmark::DoNotOptimize(mesh.n_faces());
+    }
+    std::remove(cachePath.c_str());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes) * state.iterations());
+    meshbench::reportThroughput(state, source->n_vertices());
+}
+
+} // namespace
+
+namespace meshbench {
+
+void registerIoBenchmarks()
+{
+    registerPerModel("ObjParse", BM_ObjParse);
+    registerPerModel("ObjLoad", BM_ObjLoad);
+    registerPerModel("ObjLoadOpenMesh", BM_ObjLoadOpenMesh);
+    registerPerModel("CacheLoad", BM_CacheLoad);
+}
+
+} // namespace meshbench
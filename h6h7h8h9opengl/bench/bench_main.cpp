@@ -0,0 +1,18 @@
+// meshbench: benchmarks for the meshcore kernels on the bundled models
+// meshbench：在自带模型上运行meshcore内核基准
+//
+//   meshbench --benchmark_out=meshbench.json --benchmark_out_format=json
+//   (或 cmake --build . --target bench_json)
+#include "bench_common.h"
+
+int main(int argc, char** argv)
+{
+    meshbench::registerGeometryBenchmarks();
+    meshbench::registerIoBenchmarks();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
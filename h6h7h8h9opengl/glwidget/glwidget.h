@@ -11,7 +11,15 @@
 #include <QColor>
 #include <vector>
 #include <set>
-#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <memory>
+#include "../meshcore/mesh_types.h"
+#include "../meshcore/curvature.h"
+#include "../meshcore/mesh_cache.h"
+#include "../meshcore/solver_cache.h"
+#include "../meshcore/conformal_parameterization.h"
+#include "../meshcore/progressive_mesh.h"
+#include "../meshcore/lod_chain.h"
+#include "mesh_job_runner.h"
 #include <OpenMesh/Core/IO/MeshIO.hh>
 #include <queue>
 #include <Eigen/Sparse>
@@ -36,23 +44,6 @@ typedef K::Point_2 Point;
 #pragma GCC diagnostic pop
 #endif
 
-#define EPSILON 1E-4F 
-
-// Define OpenMesh mesh type with custom traits
-// 定义带有自定义特性的OpenMesh网格类型
-struct MyTraits : public OpenMesh::DefaultTraits {
-    VertexAttributes(OpenMesh::Attributes::Normal | 
-                     OpenMesh::Attributes::Status);
-    FaceAttributes(OpenMesh::Attributes::Normal | 
-                   OpenMesh::Attributes::Status);
-    // Add curvature attribute to vertices
-    // 为顶点添加曲率属性
-    VertexTraits {
-        float curvature;  // Stores curvature value per vertex (每个顶点的曲率值)
-    };
-};
-typedef OpenMesh::TriMesh_ArrayKernelT<MyTraits> Mesh;
-
 class GLWidget : public QOpenGLWidget, protected QOpenGLFunctions
 {
     Q_OBJECT
@@ -68,7 +59,8 @@ public:
         MaxCurvature,        // Maximum curvature visualization (最大曲率可视化)
         LoopSubdivision,     // Loop subdivision surface (Loop细分曲面)
         MeshSimplification,   // Mesh simplification view (网格简化视图)
-        TextureMapping       // 新增：纹理映射
+        TextureMapping,      // 新增：纹理映射
+        PrincipalDirections  // Max curvature with principal direction field (最大曲率与主方向场)
     };
     
     // Iteration methods for minimal surface
@@ -77,14 +69,27 @@ public:
         UniformLaplacian,    // Uniform Laplacian smoothing (均匀拉普拉斯平滑)
         CotangentWeights,    // Cotangent weight smoothing (余切权重平滑)
         CotangentWithArea,   // Area-weighted cotangent smoothing (带面积加权的余切平滑)
-        EigenSparseSolver    // Eigen sparse matrix solver (Eigen稀疏矩阵求解器)
+        EigenSparseSolver,   // Eigen sparse matrix solver (Eigen稀疏矩阵求解器)
+        ImplicitFairing      // Backward-Euler mean curvature flow (隐式欧拉平均曲率流)
     };
     
     // Boundary types for parameterization
     // 参数化边界类型
     enum BoundaryType {
         Rectangle,           // Rectangular boundary parameterization (矩形边界参数化)
-        Circle               // Circular boundary parameterization (圆形边界参数化)
+        Circle,              // Circular boundary parameterization (圆形边界参数化)
+        FreeBoundary,        // Least-squares conformal map, boundary left free (最小二乘保角映射，边界自由)
+        AsRigidAsPossible,   // ARAP iterations seeded by the conformal map (以保角映射为初值的ARAP迭代)
+        Atlas                // Disk charts cut from any mesh, packed into one atlas (任意网格切分为圆盘图块并打包为图集)
+    };
+    
+    // Algorithms behind the simplification slider
+    // 简化滑块使用的算法
+    enum SimplificationMethod {
+        ProgressiveQem,      // Precomputed collapse sequence, scrubbed by index edits (预计算折叠序列，改写索引拖动)
+        ParallelQem,         // Independent-set batches collapsed concurrently (独立集分批并发折叠)
+        OpenMeshDecimater,   // OpenMesh decimater with ModQuadricT (OpenMesh的ModQuadricT简化器)
+        AttributeQem         // Quadrics over position, texcoord and normal, seams locked (位置、纹理坐标与法线上的二次误差，锁定接缝)
     };
 
     // ========== CONSTRUCTOR/DESTRUCTOR ========== //
@@ -117,32 +122,35 @@ public:
 public:
     void loadOBJ(const QString &path);                // Load OBJ file (加载OBJ文件)
     void performLoopSubdivision();                    // Apply Loop subdivision (应用Loop细分)
+    void performAdaptiveSubdivision();                // Refine only curved or large-on-screen faces, one level (只细分弯曲或屏幕上过大的面，一级)
+    void setAdaptiveCreaseAngle(float degrees) { adaptiveCreaseAngle = degrees; } // Dihedral angle treated as a crease, 0 = tags only (视为折痕的二面角，0为只用标记)
     void performMeshSimplification(float ratio);       // Simplify mesh (0-1 ratio) (网格简化，0-1比例)
     void applyMeshOperation(int sliderValue);          // Apply mesh op based on UI slider (根据UI滑块应用网格操作)
     void resetMeshOperation();                        // Reset to original mesh (重置到原始网格)
+    void buildProgressiveMesh();                      // Record the collapse sequence of the original mesh on the worker (在工作线程中记录原始网格的折叠序列)
+    void seekProgressiveLevel(float ratio);           // Show a level by editing indices, then publish the exact mesh (改写索引显示某层级，随后发布精确网格)
+    void setLodEnabled(bool enabled);                 // Draw originalMesh through a LOD chain chosen per frame; refused once the mesh is edited (按帧选择LOD链层级绘制原始网格；网格被修改后拒绝)
+    void buildLodChain();                             // Cut the LOD chain from the progressive mesh on the worker (在工作线程中从渐进网格截取LOD链)
+    int currentLodLevel() const { return lodBuffers ? lodLevel : 0; } // Level drawn in the last frame (上一帧绘制的层级)
     void resetLoopSubdivision();                      // Reset subdivision state (重置细分状态)
     void setBoundaryType(BoundaryType type);          // Set parameterization boundary type (设置参数化边界类型)
+    void setSimplificationMethod(SimplificationMethod method) { simplificationMethod = method; } // Set slider algorithm (设置滑块使用的简化算法)
      int getCurrentSubdivisionLevel()                // Get current subdivision level (获取当前细分级别)
      const { return subdivisionLevel; }
+    static const int kMaxSubdivisionLevel = 5;        // Highest Loop subdivision level (Loop细分的最高级别)
     void clearMeshData(); // 清除当前网格数据
     bool loadOBJToOpenMesh(const QString &path); // 加载OBJ文件到OpenMesh
-    void computeBoundingBox(Mesh::Point& min, Mesh::Point& max); // 计算网格的边界框
-    void centerAndScaleMesh(const Mesh::Point& center, float maxSize); // 中心化并缩放网格
     void prepareFaceIndices(); // 准备面索引数据（包括三角剖分）
     void prepareEdgeIndices(); // 准备边索引数据
     void saveOriginalMesh(); // 保存原始网格状态           
+    bool loadFromMeshCache(const QString &path); // 从.mcache缓存加载（映射后直接上传GPU）
+    void writeMeshCacheFor(const QString &path); // 为当前网格写入.mcache缓存
 
     // ========== CURVATURE & GEOMETRY ========== //
 public:
-    void calculateCurvatures();                       // Compute curvature values (计算曲率值)
-    Mesh::Point computeMeanCurvatureVector(const Mesh::VertexHandle& vh);  // Calculate mean curvature vector (计算平均曲率向量)
-    float triangleArea(const Mesh::Point& p0,         // Compute triangle area (计算三角形面积)
-                      const Mesh::Point& p1, 
-                      const Mesh::Point& p2);
-    float cotangent(const Mesh::Point& a,             // Compute cotangent value (计算余切值)
-                   const Mesh::Point& b, 
-                   const Mesh::Point& c);
-    float calculateMixedArea(const Mesh::VertexHandle& vh);  // Compute mixed area for curvature (计算曲率混合面积)
+    void calculateCurvatures();                       // Compute all curvature fields into vertex properties (计算全部曲率场并存入顶点属性)
+    meshcore::CurvatureType currentCurvatureType() const; // Curvature shown by current mode (当前模式显示的曲率类型)
+    void updatePrincipalDirectionBuffer();            // Build line segments along both principal directions (生成沿两个主方向的线段)
 
     // ========== MINIMAL SURFACE ========== //
 public:
@@ -151,12 +159,32 @@ public:
     void performCotangentWeightsIteration(int iterations, float lambda); // Cotangent smoothing (余切权重平滑)
     void performCotangentWithAreaIteration(int iterations, float lambda); // Area-weighted smoothing (带面积加权的平滑)
     void performEigenSparseSolverIteration();         // Solve with Eigen sparse solver (使用Eigen稀疏求解器求解)
+    void performImplicitFairingIteration(int iterations, float lambda); // Implicit smoothing, large steps (大步长隐式平滑)
     void setIterationMethod(IterationMethod method) { iterationMethod = method; } // Set smoothing method (设置平滑方法)
+
+    // ========== BACKGROUND JOBS ========== //
+public:
+    void cancelMeshJobs() { meshJobs.cancelAll(); }  // Cancel running/queued mesh operations (取消运行中与排队的网格操作)
+    bool isMeshJobRunning() const { return meshJobs.busy(); } // A mesh operation is running or queued (有网格操作正在运行或排队)
+    void submitSmoothingJob(const QString& name, void (*smooth)(Mesh&, int, float),
+                            int iterations, float lambda);  // Explicit smoothing in cancellable chunks (分块执行、可取消的显式平滑)
+    void adoptMeshJobResult(MeshJobResult& result);   // Swap in a finished job's mesh, schedule upload (换入完成任务的网格并安排上传)
+    void flushPendingUpload();                        // Upload published results; needs a current context (上传已发布的结果，需要当前上下文)
+    void uploadProgressiveLevel();                    // Write the active index prefix of progressiveLevel (写入progressiveLevel的有效索引前缀)
+    void uploadLodChain();                            // Upload originalMesh with every level's indices (上传原始网格与全部层级的索引)
+    void selectDrawRange(const QMatrix4x4& model, const QMatrix4x4& view); // Pick this frame's index ranges (选择本帧绘制的索引区间)
+    void viewMatrices(QMatrix4x4& model, QMatrix4x4& view) const; // Current model and view transforms (当前的模型与视图变换)
+    float pixelsPerUnit(const QMatrix4x4& model, const QMatrix4x4& view, const QVector3D& point) const; // Screen pixels per model unit at point, 0 behind the camera (点处每单位模型长度的屏幕像素数，相机后方为0)
+
+signals:
+    void meshJobStarted(const QString& name);
+    void meshJobProgress(const QString& name, int percent);
+    void meshJobFinished(const QString& name, bool applied);
+    void parameterizationFinished();                  // paramTexCoords hold the new result (paramTexCoords已是新结果)
+
 // ========== PARAMETERIZATION ========== //
 public:
     void performParameterization();                   // Perform mesh parameterization (执行网格参数化)
-    void mapBoundaryToCircle();                      // Map boundary to circle (映射边界到圆形)
-    void mapBoundaryToRectangle();                   // Map boundary to rectangle (映射边界到矩形)
     void resetViewForParameterization()
     {
         rotationX = 0;
@@ -164,13 +192,20 @@ public:
         zoom = 1.0f;
         update();
     }                                                // 新增：为参数化重置视图
-    void solveParameterization();                    // Solve parameterization using Eigen (使用Eigen求解参数化)
     void generateCheckerboardTexture();              // 生成棋格纹理
     void updateTextureCoordinates();                 // 更新纹理坐标
     // ========== OPENGL RESOURCES ========== //
 public:
     void initializeShaders();                         // Compile/link shaders (编译/链接着色器)
     void updateBuffersFromOpenMesh();                 // Update GPU buffers from mesh data (从网格数据更新GPU缓冲区)
+    void bindCurvatureAttribute();                    // Point aCurvature at the current mode's field (将曲率属性指向当前模式的曲率场)
+    void uploadMeshBuffers(const float* vertexBlock, size_t vertexCount,
+                           const unsigned int* edgeIndices, size_t edgeIndexCount,
+                           const unsigned int* faceIndices, size_t faceIndexCount); // Upload [pos|normal|curvatures] block and indices (上传顶点块与索引)
+    void refreshAfterMeshChange();                    // Recompute curvature and re-upload buffers (重新计算曲率并上传缓冲区)
+    void refreshDirtyRegion();                        // Update curvature and buffers around dirty vertices only (只更新脏顶点附近的曲率与缓冲区)
+    void patchMeshBuffers(const std::vector<unsigned int>& vertices); // Rewrite VBO runs of the given sorted vertices (改写给定有序顶点的VBO区段)
+    void updateCurvatureRanges();                     // Per-field min/max for the shader (着色器使用的各曲率场范围)
     bool isParameterizationView = false;
 
     // ========== DATA STRUCTURES ========== //
@@ -192,6 +227,8 @@ public:
     QVector4D wireframeColor;             // Wireframe RGBA color (线框RGBA颜色)
     QColor bgColor;                       // Background color (背景颜色)
     RenderMode currentRenderMode;         // Current rendering mode (当前渲染模式)
+    float curvatureMin[meshcore::CurvatureFields::FieldCount] = {};  // Per-field range for shader normalization (着色器归一化用的曲率范围)
+    float curvatureMax[meshcore::CurvatureFields::FieldCount] = {};
     BoundaryType boundaryType = Rectangle;// Current boundary type (当前边界类型)
 
     // 纹理相关
@@ -204,6 +241,34 @@ public:
     bool hasOriginalMesh = false;         // Has original mesh been stored (是否存储了原始网格)
     int meshOperationValue = 50;          // UI mesh operation value (0-100) (UI网格操作值0-100)
     float simplificationRatio = 0.5f;     // Mesh simplification ratio (网格简化比例)
+    SimplificationMethod simplificationMethod = ProgressiveQem; // Slider algorithm (滑块使用的简化算法)
+    meshcore::DirichletSolverCache solverCache; // Factorization reused by repeated solves; used only by the running job (重复求解复用的分解，只由运行中的任务使用)
+    meshcore::ConformalSolverCache conformalCache; // LSCM factorization, same rules as solverCache (LSCM分解，规则同solverCache)
+    MeshJobRunner meshJobs;               // Worker for long mesh operations (长时间网格操作的工作线程)
+
+    // Upload scheduled by a published job, done in the next paintGL
+    // 已发布任务安排的上传，在下一次paintGL中执行
+    enum PendingUpload { NoUpload, PatchUpload, FullUpload, ProgressiveUpload, LodUpload };
+    PendingUpload pendingUpload = NoUpload;
+    std::vector<unsigned int> pendingVertices; // Sorted vertices for PatchUpload (局部上传的有序顶点)
+
+    // Progressive simplification of originalMesh, built on first use of the slider
+    // originalMesh的渐进简化，首次使用滑块时构建
+    std::shared_ptr<const meshcore::ProgressiveMesh> progressiveMesh;
+    meshcore::ProgressiveMesh::Level progressiveLevel; // Level chosen by the slider (滑块选择的层级)
+    bool progressiveBuildPending = false; // Build job queued or running (构建任务排队或运行中)
+    bool progressiveBuffers = false;      // GPU holds originalMesh's vertex block and level indices (GPU中是原始顶点块与层级索引)
+    std::shared_ptr<const std::vector<float>> originalTexCoords; // Parameterization texcoords of originalMesh, carried into extracted levels (originalMesh的参数化纹理坐标，带入提取的层级)
+
+    // LOD chain of originalMesh: one vertex block, every level's indices in the same buffers
+    // originalMesh的LOD链：共用顶点块，各层级索引位于同一缓冲
+    std::shared_ptr<const meshcore::LodChain> lodChain;
+    bool lodEnabled = false;              // Draw through the chain when it is uploaded (LOD链上传后按层级绘制)
+    bool lodBuildPending = false;         // Build job queued or running (构建任务排队或运行中)
+    bool lodBuffers = false;              // GPU index buffers hold the whole chain (GPU索引缓冲中是整条LOD链)
+    int lodLevel = 0;                     // Level drawn in the last frame (上一帧绘制的层级)
+    size_t drawFaceOffset = 0, drawFaceCount = 0; // Face index range drawn this frame (本帧绘制的面索引区间)
+    size_t drawEdgeOffset = 0, drawEdgeCount = 0; // Edge index range drawn this frame (本帧绘制的边索引区间)
     
     // Geometry buffers
     std::vector<unsigned int> faces;      // Face indices for rendering (渲染面索引)
@@ -215,12 +280,17 @@ public:
     float rotationX, rotationY;           // Rotation angles (旋转角度)
     float zoom;                           // Zoom level (缩放级别)
     int subdivisionLevel = 0;             // Current subdivision level (当前细分级别)
+    bool meshEdited = false;              // openMesh is no longer originalMesh (openMesh已不是原始网格)
+    int pendingSubdivisions = 0;          // Subdivision jobs queued or running (排队或运行中的细分任务数)
+    float adaptiveCreaseAngle = 0.0f;     // Crease angle for adaptive subdivision (自适应细分的折痕角)
     
     // UI state
     bool showWireframeOverlay;            // Show wireframe overlay (显示线框叠加)
     bool hideFaces;                       // Hide face rendering (隐藏面渲染)
     bool modelLoaded;                     // Is model loaded (模型是否加载)
     IterationMethod iterationMethod = UniformLaplacian; // Current iteration method (当前迭代方法)
+    bool hasPrincipalDirections = false;  // Direction properties match the mesh (主方向属性与当前网格一致)
+    bool directionBufferDirty = true;     // Direction lines need rebuilding (主方向线段需要重建)
 
     // ========== OPENGL OBJECTS ========== //
 protected:
@@ -236,6 +306,9 @@ protected:
     QOpenGLBuffer ebo;                    // Edge index buffer (边索引缓冲区)
     QOpenGLBuffer faceEbo;                // Face index buffer (面索引缓冲区)
     QOpenGLBuffer texCoordBuffer;         // 新增：纹理坐标缓冲区
+    QOpenGLVertexArrayObject vaoDirections; // Principal direction lines (主方向线段VAO)
+    QOpenGLBuffer directionVbo;           // [k1 segments | k2 segments] (主方向线段顶点)
+    int directionVertexCount = 0;         // Vertices per direction (每个方向的线段顶点数)
 
     // ========== INTERACTION STATE ========== //
 protected:
@@ -245,10 +318,14 @@ protected:
 // 添加以下成员和方法
 public:
     void setParameterizationTexCoords(const std::vector<float>& coords);
+    // Replace the mesh by an atlas seam mesh, then attach its texcoords
+    // 以图集的接缝网格替换当前网格，再附上其纹理坐标
+    void applyAtlasMesh(const std::shared_ptr<const Mesh>& mesh, const std::vector<float>& coords);
     
 public:
     std::vector<float> paramTexCoords; // 存储参数化生成的纹理坐标
     bool hasParamTexCoords = false;   // 是否有参数化纹理坐标
+    std::shared_ptr<const Mesh> atlasMesh; // 3D seam mesh of the last Atlas result, null otherwise (最近一次图集结果的三维接缝网格，否则为空)
     
 public:
     void drawWireframe(const QMatrix4x4& model, const QMatrix4x4& view, const QMatrix4x4& projection);
@@ -258,6 +335,7 @@ public:
     void drawCurvature(const QMatrix4x4& model, const QMatrix4x4& view, const QMatrix4x4& projection, const QMatrix3x3& normalMatrix);
     void drawBlinnPhong(const QMatrix4x4& model, const QMatrix4x4& view, const QMatrix4x4& projection, const QMatrix3x3& normalMatrix);
     void drawWireframeOverlay(const QMatrix4x4& model, const QMatrix4x4& view, const QMatrix4x4& projection);
+    void drawPrincipalDirections(const QMatrix4x4& model, const QMatrix4x4& view, const QMatrix4x4& projection);
 };
 
 #endif // GLWIDGET_H
\ No newline at end of file
@@ -6,9 +6,12 @@
 #include <QKeyEvent>
 #include <QSurfaceFormat>
 #include <QVector3D>
+#include <QVector2D>
 #include <QtMath>
 #include <QResource>
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
 #include <OpenMesh/Tools/Smoother/JacobiLaplaceSmootherT.hh>
 #include <OpenMesh/Core/IO/MeshIO.hh> // 添加OpenMesh IO头文件
@@ -22,6 +25,8 @@
 using namespace OpenMesh;
 
 GLWidget::GLWidget(QWidget *parent) : QOpenGLWidget(parent),
+    meshJobs([this](const MeshJob& job) { return job.fromOriginal ? originalMesh : openMesh; },
+             [this](MeshJobResult& result) { adoptMeshJobResult(result); }),
     vbo(QOpenGLBuffer::VertexBuffer),
     ebo(QOpenGLBuffer::IndexBuffer),
     faceEbo(QOpenGLBuffer::IndexBuffer),
@@ -45,6 +50,9 @@ GLWidget::GLWidget(QWidget *parent) : QOpenGLWidget(parent),
     meshOperationValue = 50;  // 默认居中
     subdivisionLevel = 0; // 确保初始化为0
 
+    connect(&meshJobs, &MeshJobRunner::jobStarted, this, &GLWidget::meshJobStarted);
+    connect(&meshJobs, &MeshJobRunner::progressChanged, this, &GLWidget::meshJobProgress);
+    connect(&meshJobs, &MeshJobRunner::jobFinished, this, &GLWidget::meshJobFinished);
 }
 
 void GLWidget::setHideFaces(bool hide)
@@ -67,12 +75,16 @@ void GLWidget::setWireframeColor(const QVector4D& color)
 
 GLWidget::~GLWidget()
 {
+    // 工作线程可能仍在使用solverCache与conformalCache
+    meshJobs.cancelAndWait();
     makeCurrent();
     vao.destroy();
     vbo.destroy();
     ebo.destroy();
     faceEbo.destroy();
     texCoordBuffer.destroy(); // 销毁纹理坐标缓冲区
+    vaoDirections.destroy();
+    directionVbo.destroy();
     if (checkerboardTexture) delete checkerboardTexture; // 删除纹理对象
     
 
@@ -100,16 +112,36 @@ void GLWidget::setRenderMode(RenderMode mode)
 {
     currentRenderMode = mode;
     if (modelLoaded) {
-        // 重新计算曲率
-        calculateCurvatures();
-        
+        // 三种曲率都已在缓冲区中，切换模式只需重新绑定曲率属性
         makeCurrent();
-        initializeShaders();  // 更新着色器和缓冲区
+        bindCurvatureAttribute();
         doneCurrent();
     }
     update();
 }
 
+// 将aCurvature指向顶点缓冲区中当前模式对应的曲率场
+void GLWidget::bindCurvatureAttribute()
+{
+    int field = meshcore::curvatureField(currentCurvatureType());
+    if (field < 0 || openMesh.n_vertices() == 0) return;
+    
+    int curvatureLoc = curvatureProgram.attributeLocation("aCurvature");
+    if (curvatureLoc == -1) {
+        qWarning() << "Failed to find attribute location for aCurvature in curvature shader";
+        return;
+    }
+    
+    vao.bind();
+    vbo.bind();
+    curvatureProgram.bind();
+    curvatureProgram.enableAttributeArray(curvatureLoc);
+    curvatureProgram.setAttributeBuffer(curvatureLoc, GL_FLOAT,
+                                        openMesh.n_vertices() * (6 + field) * sizeof(float), 1, sizeof(float));
+    curvatureProgram.release();
+    vao.release();
+}
+
 void GLWidget::initializeGL()
 {
     initializeOpenGLFunctions();
@@ -124,6 +156,8 @@ void GLWidget::initializeGL()
     ebo.create();
     faceEbo.create();
     texCoordBuffer.create(); // 创建纹理坐标缓冲区
+    vaoDirections.create();
+    directionVbo.create();
 
     // 生成棋格纹理
     generateCheckerboardTexture();
@@ -230,10 +264,11 @@ void GLWidget::updateBuffersFromOpenMesh()
 {
     if (openMesh.n_vertices() == 0) return;
     
-    // 准备顶点数据 - 按顶点索引顺序存储
-    std::vector<float> vertices(openMesh.n_vertices() * 3);
-    std::vector<float> normals(openMesh.n_vertices() * 3);
-    std::vector<float> curvatures(openMesh.n_vertices());
+    // 准备顶点数据 - 按顶点索引顺序存储：[位置 | 法线 | 高斯 | 平均 | 最大曲率]
+    const size_t vertexCount = openMesh.n_vertices();
+    std::vector<float> vertexBlock(vertexCount * meshcore::kVertexBlockFloats, 0.0f);
+    float* vertices = vertexBlock.data();
+    float* normals = vertices + vertexCount * 3;
     for (auto vh : openMesh.vertices()) {
         int idx = vh.idx();
         const auto& p = openMesh.point(vh);
@@ -245,22 +280,34 @@ void GLWidget::updateBuffersFromOpenMesh()
         normals[idx*3]   = n[0];
         normals[idx*3+1] = n[1];
         normals[idx*3+2] = n[2];
-        
-        curvatures[idx] = openMesh.data(vh).curvature;
     }
     
+    // 曲率场直接从顶点属性拷贝
+    for (int f = 0; f < meshcore::CurvatureFields::FieldCount; ++f) {
+        OpenMesh::VPropHandleT<float> handle;
+        if (!meshcore::getCurvatureProperty(openMesh, f, handle)) continue;
+        const std::vector<float>& values = openMesh.property(handle).data_vector();
+        std::copy(values.begin(), values.begin() + vertexCount, vertices + vertexCount * (6 + f));
+    }
+    updateCurvatureRanges();
+    
+    uploadMeshBuffers(vertexBlock.data(), vertexCount,
+                      edges.data(), edges.size(),
+                      faces.data(), faces.size());
+}
+
+// 上传顶点块与索引；数据可以直接来自内存映射的缓存文件
+void GLWidget::uploadMeshBuffers(const float* vertexBlock, size_t vertexCount,
+                                 const unsigned int* edgeIndices, size_t edgeIndexCount,
+                                 const unsigned int* faceIndices, size_t faceIndexCount)
+{
     // 绑定主VAO (用于非纹理渲染)
     vao.bind();
     vbo.bind();
     
     // 分配缓冲区
-    int vertexSize = vertices.size() * sizeof(float);
-    int normalSize = normals.size() * sizeof(float);
-    int curvatureSize = curvatures.size() * sizeof(float);
-    vbo.allocate(vertexSize + normalSize + curvatureSize);
-    vbo.write(0, vertices.data(), vertexSize);
-    vbo.write(vertexSize, normals.data(), normalSize);
-    vbo.write(vertexSize + normalSize, curvatures.data(), curvatureSize);
+    int vertexSize = vertexCount * 3 * sizeof(float);
+    vbo.allocate(vertexBlock, vertexCount * meshcore::kVertexBlockFloats * sizeof(float));
     
     // 设置线框着色器属性
     wireframeProgram.bind();
@@ -300,14 +347,6 @@ void GLWidget::updateBuffersFromOpenMesh()
         curvatureProgram.setAttributeBuffer(normalLoc, GL_FLOAT, vertexSize, 3, 3 * sizeof(float));
     }
     
-    int curvatureLoc = curvatureProgram.attributeLocation("aCurvature");
-    if (curvatureLoc != -1) {
-        curvatureProgram.enableAttributeArray(curvatureLoc);
-        curvatureProgram.setAttributeBuffer(curvatureLoc, GL_FLOAT, vertexSize + normalSize, 1, sizeof(float));
-    } else {
-        qWarning() << "Failed to find attribute location for aCurvature in curvature shader";
-    }
-    
     // 设置Loop细分着色器属性 (使用主VAO)
     loopSubdivisionProgram.bind();
     posLoc = loopSubdivisionProgram.attributeLocation("aPos");
@@ -323,12 +362,18 @@ void GLWidget::updateBuffersFromOpenMesh()
     }
 
     ebo.bind();
-    ebo.allocate(edges.data(), edges.size() * sizeof(unsigned int));
+    ebo.allocate(edgeIndices, edgeIndexCount * sizeof(unsigned int));
     
     faceEbo.bind();
-    faceEbo.allocate(faces.data(), faces.size() * sizeof(unsigned int));
+    faceEbo.allocate(faceIndices, faceIndexCount * sizeof(unsigned int));
     
     vao.release();
+    progressiveBuffers = false;
+    lodBuffers = false;
+    
+    // 曲率属性指向当前模式的曲率场
+    bindCurvatureAttribute();
+    directionBufferDirty = true;
     
     // ===== 设置纹理专用VAO =====
     vaoTexture.bind();
@@ -370,6 +415,152 @@ void GLWidget::updateBuffersFromOpenMesh()
     textureProgram.release();
 }
 
+// 网格几何或拓扑变化后：重新计算曲率并更新OpenGL缓冲区
+void GLWidget::refreshAfterMeshChange()
+{
+    calculateCurvatures();
+    
+    makeCurrent();
+    updateBuffersFromOpenMesh();
+    doneCurrent();
+    
+    update();
+}
+
+// 后台任务完成：换入其网格（双缓冲的后台副本），GPU上传推迟到下一次paintGL
+void GLWidget::adoptMeshJobResult(MeshJobResult& result)
+{
+    openMesh = std::move(result.mesh);
+    meshEdited = true;
+    if (result.indicesRebuilt) {
+        faces.swap(result.faces);
+        edges.swap(result.edges);
+    } else if (progressiveBuffers) {
+        // 当前索引是原始网格的某个渐进层级，不属于新网格：重建并整体上传
+        prepareFaceIndices();
+        prepareEdgeIndices();
+        pendingUpload = FullUpload;
+        pendingVertices.clear();
+    }
+    if (result.fullUpload) {
+        hasPrincipalDirections = true;
+        pendingUpload = FullUpload;
+        pendingVertices.clear();
+    } else if (pendingUpload != FullUpload && !result.updated.empty()) {
+        // 两次发布之间没有重绘时合并两组脏顶点
+        std::vector<unsigned int> merged;
+        merged.reserve(pendingVertices.size() + result.updated.size());
+        std::set_union(pendingVertices.begin(), pendingVertices.end(),
+                       result.updated.begin(), result.updated.end(), std::back_inserter(merged));
+        pendingVertices.swap(merged);
+        pendingUpload = PatchUpload;
+    }
+    update();
+}
+
+void GLWidget::flushPendingUpload()
+{
+    if (pendingUpload == ProgressiveUpload) {
+        uploadProgressiveLevel();
+    } else if (pendingUpload == LodUpload) {
+        uploadLodChain();
+    } else if (pendingUpload == FullUpload) {
+        updateBuffersFromOpenMesh();
+    } else if (pendingUpload == PatchUpload) {
+        patchMeshBuffers(pendingVertices);
+    }
+    pendingUpload = NoUpload;
+    pendingVertices.clear();
+}
+
+// 只移动了部分顶点：局部重新计算曲率，并只改写顶点缓冲区中受影响的区段
+void GLWidget::refreshDirtyRegion()
+{
+    std::vector<unsigned int> updated;
+    if (!meshcore::updateDirtyCurvature(openMesh, updated)) {
+        // 脏区域过大，已整体重新计算
+        hasPrincipalDirections = true;
+        makeCurrent();
+        updateBuffersFromOpenMesh();
+        doneCurrent();
+        update();
+        return;
+    }
+    if (updated.empty()) return;
+    
+    makeCurrent();
+    patchMeshBuffers(updated);
+    doneCurrent();
+    update();
+}
+
+// 按有序顶点索引把相邻区段合并后用glBufferSubData改写[位置 | 法线 | 曲率场]
+void GLWidget::patchMeshBuffers(const std::vector<unsigned int>& vertices)
+{
+    const size_t vertexCount = openMesh.n_vertices();
+    const unsigned int kMaxGap = 32;     // 间隔不超过该值的区段合并为一次写入
+    
+    std::vector<float> staging;
+    OpenMesh::VPropHandleT<float> handles[meshcore::CurvatureFields::FieldCount];
+    bool hasField[meshcore::CurvatureFields::FieldCount];
+    for (int f = 0; f < meshcore::CurvatureFields::FieldCount; ++f) {
+        hasField[f] = meshcore::getCurvatureProperty(openMesh, f, handles[f]);
+    }
+    
+    vbo.bind();
+    size_t i = 0;
+    while (i < vertices.size()) {
+        const unsigned int first = vertices[i];
+        unsigned int last = first;
+        while (i < vertices.size() && vertices[i] <= last + kMaxGap) {
+            last = vertices[i++];
+        }
+        const int count = last - first + 1;
+        
+        staging.resize(count * 3);
+        for (int k = 0; k < count; ++k) {
+            const Mesh::Point& p = openMesh.point(Mesh::VertexHandle(first + k));
+            staging[3 * k] = p[0];
+            staging[3 * k + 1] = p[1];
+            staging[3 * k + 2] = p[2];
+        }
+        vbo.write(first * 3 * sizeof(float), staging.data(), count * 3 * sizeof(float));
+        
+        for (int k = 0; k < count; ++k) {
+            const Mesh::Normal& n = openMesh.normal(Mesh::VertexHandle(first + k));
+            staging[3 * k] = n[0];
+            staging[3 * k + 1] = n[1];
+            staging[3 * k + 2] = n[2];
+        }
+        vbo.write((vertexCount * 3 + first * 3) * sizeof(float), staging.data(), count * 3 * sizeof(float));
+        
+        for (int f = 0; f < meshcore::CurvatureFields::FieldCount; ++f) {
+            if (!hasField[f]) continue;
+            const float* values = openMesh.property(handles[f]).data_vector().data();
+            vbo.write((vertexCount * (6 + f) + first) * sizeof(float), values + first, count * sizeof(float));
+        }
+    }
+    vbo.release();
+    
+    updateCurvatureRanges();
+    directionBufferDirty = true;
+}
+
+// 着色器归一化用的各曲率场范围（顺序扫描，开销远小于曲率计算）
+void GLWidget::updateCurvatureRanges()
+{
+    const size_t vertexCount = openMesh.n_vertices();
+    for (int f = 0; f < meshcore::CurvatureFields::FieldCount; ++f) {
+        OpenMesh::VPropHandleT<float> handle;
+        curvatureMin[f] = curvatureMax[f] = 0.0f;
+        if (vertexCount == 0 || !meshcore::getCurvatureProperty(openMesh, f, handle)) continue;
+        const std::vector<float>& values = openMesh.property(handle).data_vector();
+        auto range = std::minmax_element(values.begin(), values.begin() + vertexCount);
+        curvatureMin[f] = *range.first;
+        curvatureMax[f] = *range.second;
+    }
+}
+
 void GLWidget::resizeGL(int w, int h)
 {
     glViewport(0, 0, w, h);
@@ -377,8 +568,19 @@ void GLWidget::resizeGL(int w, int h)
 
 void GLWidget::updateTextureCoordinates()
 {
-        // 如果已有参数化纹理坐标，则直接使用
-    if (hasParamTexCoords && !paramTexCoords.empty()) {
+    // 参数化纹理坐标存放在网格的顶点属性中，简化后仍与顶点一一对应
+    if (hasParamTexCoords && openMesh.has_vertex_texcoords2D()) {
+        texCoords.resize(2 * openMesh.n_vertices());
+        for (auto vh : openMesh.vertices()) {
+            const Mesh::TexCoord2D& t = openMesh.texcoord2D(vh);
+            texCoords[2 * vh.idx()] = t[0];
+            texCoords[2 * vh.idx() + 1] = t[1];
+        }
+        return;
+    }
+    
+    // 如果已有参数化纹理坐标且与顶点数一致，则直接使用
+    if (hasParamTexCoords && paramTexCoords.size() == 2 * openMesh.n_vertices()) {
         texCoords = paramTexCoords;
         return;
     }
@@ -397,25 +599,45 @@ void GLWidget::updateTextureCoordinates()
     }
 }
 
+void GLWidget::viewMatrices(QMatrix4x4& model, QMatrix4x4& view) const
+{
+    model.setToIdentity();
+    model.translate(0, 0, -2.5);
+    model.rotate(rotationX, 1, 0, 0);
+    model.rotate(rotationY, 0, 1, 0);
+    model.scale(zoom);
+    
+    view.setToIdentity();
+    view.lookAt(QVector3D(0, 0, 5), QVector3D(0, 0, 0), QVector3D(0, 1, 0));
+}
+
+float GLWidget::pixelsPerUnit(const QMatrix4x4& model, const QMatrix4x4& view, const QVector3D& point) const
+{
+    // 透视投影的垂直视场为45°；模型矩阵含缩放zoom
+    const float distance = -(view * model).map(point).z();
+    if (distance <= 0.0f) return 0.0f;
+    const float halfHeight = 0.5f * height() * devicePixelRatioF();
+    return zoom * halfHeight / (distance * std::tan(qDegreesToRadians(22.5f)));
+}
+
 void GLWidget::paintGL()
 {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // 后台任务发布的网格在这里上传，绘制时上下文已是当前的
+    flushPendingUpload();
+
     if (!modelLoaded || openMesh.n_vertices() == 0) {
         return;
     }
 
     // 设置变换矩阵
     QMatrix4x4 model, view, projection;
-    model.translate(0, 0, -2.5);
-    model.rotate(rotationX, 1, 0, 0);
-    model.rotate(rotationY, 0, 1, 0);
-    model.scale(zoom);
-    
-    view.lookAt(QVector3D(0, 0, 5), QVector3D(0, 0, 0), QVector3D(0, 1, 0));
+    viewMatrices(model, view);
     projection.perspective(45.0f, width() / float(height()), 0.1f, 100.0f);
     
     QMatrix3x3 normalMatrix = model.normalMatrix();
+    selectDrawRange(model, view);
 
     GLint oldPolygonMode[2];
     glGetIntegerv(GL_POLYGON_MODE, oldPolygonMode);
@@ -438,6 +660,10 @@ void GLWidget::paintGL()
         case MaxCurvature:
             drawCurvature(model, view, projection, normalMatrix);
             break;
+        case PrincipalDirections:
+            drawCurvature(model, view, projection, normalMatrix);
+            drawPrincipalDirections(model, view, projection);
+            break;
         default: // BlinnPhong and others
             drawBlinnPhong(model, view, projection, normalMatrix);
             break;
@@ -555,13 +781,20 @@ void GLWidget::resetLoopSubdivision()
 {
     if (!hasOriginalMesh) return;
     
+    // 直接替换网格，之前的后台任务结果作废
+    meshJobs.cancelAndWait();
+    pendingUpload = NoUpload;
+    
     // 恢复原始网格
     openMesh = originalMesh;
+    meshEdited = false;
     
     // 重置细分级别
     subdivisionLevel = 0;
     
-    // 更新网格数据
+    // 更新网格数据；索引可能属于细分或简化后的网格
+    prepareFaceIndices();
+    prepareEdgeIndices();
     updateBuffersFromOpenMesh();
     update();
 }
@@ -662,14 +895,34 @@ void GLWidget::generateCheckerboardTexture()
 }
 
 // glwidget_core.cpp
+// 顶点数一致时把纹理坐标写入网格的顶点属性，之后的网格操作随顶点一起带着它们
+static bool attachTexCoords(Mesh& mesh, const std::vector<float>& coords)
+{
+    if (mesh.n_vertices() == 0 || coords.size() != 2 * mesh.n_vertices()) return false;
+    mesh.request_vertex_texcoords2D();
+    for (auto vh : mesh.vertices()) {
+        mesh.set_texcoord2D(vh, Mesh::TexCoord2D(coords[2 * vh.idx()], coords[2 * vh.idx() + 1]));
+    }
+    return true;
+}
+
 void GLWidget::setParameterizationTexCoords(const std::vector<float>& coords) {
     paramTexCoords = coords;
     hasParamTexCoords = true;
     
+    // 原始网格带上纹理坐标后，简化滑块从它得到的层级也带着纹理坐标
+    if (hasOriginalMesh && attachTexCoords(originalMesh, coords)) {
+        originalTexCoords = std::make_shared<const std::vector<float>>(coords);
+    } else {
+        originalTexCoords.reset();
+    }
+    attachTexCoords(openMesh, coords);
+    
     // 更新纹理坐标缓冲区
+    updateTextureCoordinates();
     makeCurrent();
     texCoordBuffer.bind();
-    texCoordBuffer.allocate(paramTexCoords.data(), paramTexCoords.size() * sizeof(float));
+    texCoordBuffer.allocate(texCoords.data(), texCoords.size() * sizeof(float));
     doneCurrent();
     update();
 }
@@ -686,7 +939,8 @@ void GLWidget::drawWireframe(const QMatrix4x4& model, const QMatrix4x4& view, co
     wireframeProgram.setUniformValue("projection", projection);
     wireframeProgram.setUniformValue("lineColor", wireframeColor);
 
-    glDrawElements(GL_LINES, edges.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_LINES, drawEdgeCount, GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(drawEdgeOffset * sizeof(unsigned int)));
     
     ebo.release();
     vao.release();
@@ -709,7 +963,8 @@ void GLWidget::drawTextureMapping(const QMatrix4x4& model, const QMatrix4x4& vie
         textureProgram.setUniformValue("textureSampler", 0);
     }
     
-    glDrawElements(GL_TRIANGLES, faces.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, drawFaceCount, GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(drawFaceOffset * sizeof(unsigned int)));
     
     faceEbo.release();
     vao.release();
@@ -763,8 +1018,13 @@ void GLWidget::drawCurvature(const QMatrix4x4& model, const QMatrix4x4& view, co
     curvatureProgram.setUniformValue("projection", projection);
     curvatureProgram.setUniformValue("normalMatrix", normalMatrix);
     curvatureProgram.setUniformValue("curvatureType", static_cast<int>(currentRenderMode));
+    int field = meshcore::curvatureField(currentCurvatureType());
+    if (field >= 0) {
+        curvatureProgram.setUniformValue("curvatureRange", QVector2D(curvatureMin[field], curvatureMax[field]));
+    }
     
-    glDrawElements(GL_TRIANGLES, faces.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, drawFaceCount, GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(drawFaceOffset * sizeof(unsigned int)));
     
     faceEbo.release();
     vao.release();
@@ -787,7 +1047,8 @@ void GLWidget::drawBlinnPhong(const QMatrix4x4& model, const QMatrix4x4& view, c
     blinnPhongProgram.setUniformValue("objectColor", surfaceColor);
     blinnPhongProgram.setUniformValue("specularEnabled", specularEnabled);
 
-    glDrawElements(GL_TRIANGLES, faces.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, drawFaceCount, GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(drawFaceOffset * sizeof(unsigned int)));
 
     faceEbo.release();
     vao.release();
@@ -809,7 +1070,8 @@ void GLWidget::drawWireframeOverlay(const QMatrix4x4& model, const QMatrix4x4& v
     wireframeProgram.setUniformValue("projection", projection);
     wireframeProgram.setUniformValue("lineColor", wireframeColor);
 
-    glDrawElements(GL_LINES, edges.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_LINES, drawEdgeCount, GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(drawEdgeOffset * sizeof(unsigned int)));
     
     ebo.release();
     vao.release();
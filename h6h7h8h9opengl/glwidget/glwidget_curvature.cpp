@@ -1,277 +1,100 @@
 #include "glwidget.h"
-#include <cmath>
-#include <algorithm>
 
+// 当前渲染模式对应的曲率类型
+meshcore::CurvatureType GLWidget::currentCurvatureType() const
+{
+    switch (currentRenderMode) {
+    case GaussianCurvature:
+        return meshcore::CurvatureType::Gaussian;
+    case MeanCurvature:
+        return meshcore::CurvatureType::Mean;
+    case MaxCurvature:
+    case PrincipalDirections:
+        return meshcore::CurvatureType::Max;
+    default:
+        return meshcore::CurvatureType::None;
+    }
+}
 
+// 一次并行计算全部曲率场，切换渲染模式时不再重新计算
 void GLWidget::calculateCurvatures()
 {
-    if (openMesh.n_vertices() == 0) return;
-    
-    // 标记边界顶点
-    std::vector<bool> isBoundary(openMesh.n_vertices(), false);
-    for (auto vh : openMesh.vertices()) {
-        if (openMesh.is_boundary(vh)) {
-            isBoundary[vh.idx()] = true;
-            openMesh.data(vh).curvature = 0.0f; // 边界顶点曲率设为0
-            continue;
-        }
-        
-        // 计算高斯曲率
-        float angleDefect = 2 * M_PI;
-        float area = 0.0f;
-        
-        for (auto vf_it = openMesh.vf_begin(vh); vf_it != openMesh.vf_end(vh); ++vf_it) {
-            // 计算角度
-            auto heh = openMesh.halfedge_handle(*vf_it);
-            while (openMesh.to_vertex_handle(heh) != vh) {
-                heh = openMesh.next_halfedge_handle(heh);
-            }
-            
-            auto v1 = openMesh.point(openMesh.from_vertex_handle(heh));
-            auto v2 = openMesh.point(openMesh.to_vertex_handle(heh));
-            auto heh_next = openMesh.next_halfedge_handle(heh);
-            auto v3 = openMesh.point(openMesh.to_vertex_handle(heh_next));
-            
-            auto vec1 = (v1 - v2).normalize();
-            auto vec2 = (v3 - v2).normalize();
-            float angle = acos(std::max(-1.0f, std::min(1.0f, dot(vec1, vec2))));
-            angleDefect -= angle;
-            
-            // 计算三角形面积
-            auto cross = (v1 - v2) % (v3 - v2);
-            area += cross.length() / 6.0f;
-        }
-        
-        float gaussianCurvature = 0.0f;
-        if (area > EPSILON) {
-            gaussianCurvature = angleDefect / area;
-        }
-        
-        // 计算混合面积用于平均曲率
-        float A_mixed = calculateMixedArea(vh);
-        
-        // 计算平均曲率向量
-        Mesh::Point H = computeMeanCurvatureVector(vh);
-        
-        // 平均曲率值是曲率向量长度的一半
-        float meanCurvature = H.length() / 2.0f;
-        
-        // 计算最大曲率
-        float maxCurvature = gaussianCurvature + meanCurvature;
-        
-        // 根据当前渲染模式设置曲率
-        switch (currentRenderMode) {
-        case GaussianCurvature:
-            openMesh.data(vh).curvature = gaussianCurvature;
-            break;
-        case MeanCurvature:
-            openMesh.data(vh).curvature = meanCurvature;
-            break;
-        case MaxCurvature:
-            openMesh.data(vh).curvature = maxCurvature;
-            break;
-        default:
-            openMesh.data(vh).curvature = 0.0f;
-            break;
-        }
+    meshcore::updateCurvatureProperties(openMesh);
+    hasPrincipalDirections = true;
+}
+
+// 每个顶点沿k1、k2方向各生成一条线段，长度取平均边长，沿法线略微抬起避免被表面遮挡
+void GLWidget::updatePrincipalDirectionBuffer()
+{
+    directionBufferDirty = false;
+    directionVertexCount = 0;
+    if (openMesh.n_vertices() == 0 || openMesh.n_edges() == 0) return;
+
+    // 从缓存加载时没有主方向属性，首次显示时再计算
+    if (!hasPrincipalDirections) {
+        meshcore::updatePrincipalDirections(openMesh);
+        hasPrincipalDirections = true;
     }
-    
-    // 归一化曲率值到 [0,1] 范围
-    auto normalize = [](std::vector<float>& values) {
-        if (values.empty()) return;
-        
-        auto minmax = std::minmax_element(values.begin(), values.end());
-        float minVal = *minmax.first;
-        float maxVal = *minmax.second;
-        float range = maxVal - minVal;
-        
-        if (range > 0) {
-            for (float& val : values) {
-                val = (val - minVal) / range;
-            }
-        }
-    };
-    
-    // 只归一化非边界顶点
-    std::vector<float> curvatures;
-    for (auto vh : openMesh.vertices()) {
-        if (!isBoundary[vh.idx()]) {
-            curvatures.push_back(openMesh.data(vh).curvature);
-        }
+    OpenMesh::VPropHandleT<Mesh::Normal> dir1, dir2;
+    if (!meshcore::getPrincipalDirectionProperties(openMesh, dir1, dir2)) return;
+
+    float edgeLength = 0.0f;
+    for (auto eh : openMesh.edges()) {
+        edgeLength += openMesh.calc_edge_length(eh);
     }
-    
-    // 归一化非边界顶点
-    normalize(curvatures);
-    
-    // 将归一化值复制回顶点
-    size_t idx = 0;
+    edgeLength /= openMesh.n_edges();
+    const float halfLength = 0.4f * edgeLength;
+    const float lift = 0.05f * edgeLength;
+
+    const size_t n = openMesh.n_vertices();
+    std::vector<float> lines(n * 12);
+    float* out[2] = {lines.data(), lines.data() + n * 6};
     for (auto vh : openMesh.vertices()) {
-        if (!isBoundary[vh.idx()]) {
-            openMesh.data(vh).curvature = curvatures[idx++];
+        const Mesh::Point center = openMesh.point(vh) + openMesh.normal(vh) * lift;
+        const Mesh::Normal dirs[2] = {openMesh.property(dir1, vh), openMesh.property(dir2, vh)};
+        for (int d = 0; d < 2; ++d) {
+            const Mesh::Point a = center - dirs[d] * halfLength;
+            const Mesh::Point b = center + dirs[d] * halfLength;
+            float* p = out[d] + vh.idx() * 6;
+            p[0] = a[0]; p[1] = a[1]; p[2] = a[2];
+            p[3] = b[0]; p[4] = b[1]; p[5] = b[2];
         }
-        // 边界顶点保持为0
     }
-}
+    directionVertexCount = static_cast<int>(n * 2);
 
-Mesh::Point GLWidget::computeMeanCurvatureVector(const Mesh::VertexHandle& vh) {
-    Mesh::Point H(0, 0, 0);
-    if(openMesh.is_boundary(vh)) {
-        return H;
-    }
-    float A_mixed = calculateMixedArea(vh);
-    if (A_mixed < EPSILON) {
-        return H;
-    }
-    // 遍历邻接顶点
-    for (auto vv_it = openMesh.vv_begin(vh); vv_it != openMesh.vv_end(vh); ++vv_it) {
-        auto adjV = *vv_it;
-        
-        // 找到前一个顶点(pp)和后一个顶点(np)
-        Mesh::VertexHandle pp, np;
-        auto heh = openMesh.find_halfedge(vh, adjV);
-        if (!heh.is_valid()) continue;
-        
-        // 获取前一个顶点(pp)
-        if (!openMesh.is_boundary(heh)) {
-            auto prev_heh = openMesh.prev_halfedge_handle(heh);
-            pp = openMesh.from_vertex_handle(prev_heh);
-        } else {
-            auto opp_heh = openMesh.opposite_halfedge_handle(heh);
-            if (!openMesh.is_boundary(opp_heh)) {
-                auto prev_opp_heh = openMesh.prev_halfedge_handle(opp_heh);
-                pp = openMesh.from_vertex_handle(prev_opp_heh);
-            } else {
-                continue; // 无效边界
-            }
-        }
-        
-        // 获取后一个顶点(np)
-        if (!openMesh.is_boundary(heh)) {
-            auto next_heh = openMesh.next_halfedge_handle(heh);
-            np = openMesh.to_vertex_handle(next_heh);
-        } else {
-            auto opp_heh = openMesh.opposite_halfedge_handle(heh);
-            if (!openMesh.is_boundary(opp_heh)) {
-                auto next_opp_heh = openMesh.next_halfedge_handle(opp_heh);
-                np = openMesh.to_vertex_handle(next_opp_heh);
-            } else {
-                continue; // 无效边界
-            }
-        }
-        
-        // 计算两个相邻三角形的面积
-        float area1 = triangleArea(openMesh.point(vh), openMesh.point(adjV), openMesh.point(pp));
-        float area2 = triangleArea(openMesh.point(vh), openMesh.point(adjV), openMesh.point(np));
-        
-        if (area1 > EPSILON && area2 > EPSILON) {
-            // 计算余切权重
-            auto vec1 = openMesh.point(adjV) - openMesh.point(pp);
-            auto vec2 = openMesh.point(vh) - openMesh.point(pp);
-            float cot_alpha = dot(vec1, vec2) / cross(vec1, vec2).length();
-            
-            auto vec3 = openMesh.point(adjV) - openMesh.point(np);
-            auto vec4 = openMesh.point(vh) - openMesh.point(np);
-            float cot_beta = dot(vec3, vec4) / cross(vec3, vec4).length();
-            
-            H += (cot_alpha + cot_beta) * (openMesh.point(vh) - openMesh.point(adjV));
-        }
+    vaoDirections.bind();
+    directionVbo.bind();
+    directionVbo.allocate(lines.data(), lines.size() * sizeof(float));
+    wireframeProgram.bind();
+    int posLoc = wireframeProgram.attributeLocation("aPos");
+    if (posLoc != -1) {
+        wireframeProgram.enableAttributeArray(posLoc);
+        wireframeProgram.setAttributeBuffer(posLoc, GL_FLOAT, 0, 3, 3 * sizeof(float));
     }
-    
-    return H / (2.0f * A_mixed);
+    wireframeProgram.release();
+    vaoDirections.release();
 }
 
-float GLWidget::triangleArea(const Mesh::Point& p0, const Mesh::Point& p1, const Mesh::Point& p2) {
-    auto e1 = p1 - p0;
-    auto e2 = p2 - p0;
-    auto cross = e1 % e2;
-    return cross.length() / 2.0f;
-}
+// 最大主方向为白色，最小主方向为黑色
+void GLWidget::drawPrincipalDirections(const QMatrix4x4& model, const QMatrix4x4& view, const QMatrix4x4& projection)
+{
+    if (directionBufferDirty) {
+        updatePrincipalDirectionBuffer();
+    }
+    if (directionVertexCount == 0) return;
 
-// 计算混合面积（参考GetAmixed函数）
-float GLWidget::calculateMixedArea(const Mesh::VertexHandle& vh) {
-    float A_mixed = 0.f;
+    wireframeProgram.bind();
+    vaoDirections.bind();
+    glLineWidth(1.0f);
+    wireframeProgram.setUniformValue("model", model);
+    wireframeProgram.setUniformValue("view", view);
+    wireframeProgram.setUniformValue("projection", projection);
 
-    // 遍历邻接顶点（参考GetAmixed中的adjV）
-    for (auto vv_it = openMesh.vv_begin(vh); vv_it != openMesh.vv_end(vh); ++vv_it) {
-        auto adjV = *vv_it;
-        
-        // 找到共享边的下一个顶点np（参考GetAmixed中的np）
-        Mesh::VertexHandle np;
-        auto heh = openMesh.find_halfedge(vh, adjV);
-        if (!heh.is_valid()) continue;
-        
-        if (!openMesh.is_boundary(heh)) {
-            // 获取同一面上的下一个顶点
-            auto next_heh = openMesh.next_halfedge_handle(heh);
-            np = openMesh.to_vertex_handle(next_heh);
-        } else {
-            // 边界边处理：获取对边上的顶点
-            auto opp_heh = openMesh.opposite_halfedge_handle(heh);
-            if (!openMesh.is_boundary(opp_heh)) {
-                auto next_opp_heh = openMesh.next_halfedge_handle(opp_heh);
-                np = openMesh.to_vertex_handle(next_opp_heh);
-            } else {
-                continue; // 无效边界
-            }
-        }
+    wireframeProgram.setUniformValue("lineColor", QVector4D(1.0f, 1.0f, 1.0f, 1.0f));
+    glDrawArrays(GL_LINES, 0, directionVertexCount);
+    wireframeProgram.setUniformValue("lineColor", QVector4D(0.0f, 0.0f, 0.0f, 1.0f));
+    glDrawArrays(GL_LINES, directionVertexCount, directionVertexCount);
 
-        auto p_v = openMesh.point(vh);
-        auto p_adjV = openMesh.point(adjV);
-        auto p_np = openMesh.point(np);
-        
-        // 计算向量
-        auto vec_adjV = p_adjV - p_v;
-        auto vec_np = p_np - p_v;
-        auto vec_adjV_np = p_np - p_adjV;
-        auto vec_np_adjV = p_adjV - p_np;
-        
-        // 检查是否非钝角三角形（点积>=0）
-        bool nonObtuse = 
-            (vec_adjV | vec_np) >= 0.0f &&
-            (p_v - p_adjV | p_np - p_adjV) >= 0.0f &&
-            (p_v - p_np | p_adjV - p_np) >= 0.0f;
-        
-        if (nonObtuse) {
-            // 锐角三角形处理
-            float area = triangleArea(p_v, p_adjV, p_np);
-            if (area > EPSILON) {
-                // 计算余切权重
-                float cotA = dot(vec_adjV, vec_np) / cross(vec_adjV, vec_np).length();
-                float cotB = dot(vec_np, vec_adjV) / cross(vec_np, vec_adjV).length();
-                
-                // 计算距离平方
-                float dist2_adjV = vec_adjV.sqrnorm();
-                float dist2_np = vec_np.sqrnorm();
-                
-                A_mixed += (dist2_adjV * cotB + dist2_np * cotA) / 8.0f;
-            }
-        } else {
-            // 钝角三角形处理
-            float area = triangleArea(p_v, p_adjV, p_np);
-            if (area > EPSILON) {
-                // 检查顶点vh处的角是否钝角
-                if ((vec_adjV | vec_np) < 0.0f) {
-                    A_mixed += area / 2.0f;
-                } else {
-                    A_mixed += area / 4.0f;
-                }
-            }
-        }
-    }
-    return A_mixed;
+    vaoDirections.release();
+    wireframeProgram.release();
 }
-
-// 辅助函数：计算三角形中某个角的余切值
-float GLWidget::cotangent(const Mesh::Point& a, const Mesh::Point& b, const Mesh::Point& c) {
-    Mesh::Point vec1 = b - a;
-    Mesh::Point vec2 = c - a;
-    float dotProduct = vec1 | vec2;
-    float crossNorm = (vec1 % vec2).norm();
-    
-    // 避免除以零
-    if (fabs(crossNorm) < EPSILON) {
-        return 0.0f;
-    }
-    
-    return dotProduct / crossNorm;
-}
\ No newline at end of file
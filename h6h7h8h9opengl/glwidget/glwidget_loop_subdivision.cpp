@@ -1,75 +1,87 @@
 #include "glwidget.h"
-#include <OpenMesh/Core/Geometry/VectorT.hh>
-#include <OpenMesh/Tools/Subdivider/Uniform/LoopT.hh>
+#include "../meshcore/loop_subdivision.h"
+#include "../meshcore/adaptive_subdivision.h"
+#include "../meshcore/mesh_io.h"
 
-// Loop细分权重常量
-const float LOOP_BETA = 3.0f / (8.0f * 3.0f); // 3/(8*valence)
-const float LOOP_ALPHA = 3.0f / 8.0f;
-typedef OpenMesh::Subdivider::Uniform::LoopT<Mesh> LoopSubdivider;
+namespace {
+
+// 最长边在屏幕上超过此像素数的面被自适应细分
+const float kAdaptiveEdgePixels = 40.0f;
+
+} // namespace
 
 void GLWidget::performLoopSubdivision()
 {
     if (!modelLoaded || openMesh.n_vertices() == 0) return;
     
-    // 检查是否达到最大细分级别
-    if (subdivisionLevel >= 3) {
-        qWarning() << "Maximum subdivision level (3) reached";
+    // 检查是否达到最大细分级别（包括已排队的细分）
+    if (subdivisionLevel + pendingSubdivisions >= kMaxSubdivisionLevel) {
+        qWarning() << "Maximum subdivision level (" << kMaxSubdivisionLevel << ") reached";
         return;
     }
     
-    try {
-        // 创建Loop细分器
-        LoopSubdivider loopSubdivider;
-        
-        // 附加网格到细分器
-        loopSubdivider.attach(openMesh);
-        
-        // 执行一次细分
-        if (!loopSubdivider(1)) {  // 每次只细分一级
+    // 每次只细分一级，在工作线程中执行；扁平内核同时写出面与边索引，只有曲率在之后重建
+    ++pendingSubdivisions;
+    MeshJob job;
+    job.name = "Loop subdivision";
+    job.run = [](Mesh& mesh, MeshJobContext& context) {
+        meshcore::FlatMesh flat;
+        meshcore::toFlatMesh(mesh, flat);
+        std::vector<unsigned int> edges;
+        if (!meshcore::loopSubdivide(flat, 1, &edges) || !meshcore::fromFlatMesh(flat, mesh)) {
             qCritical() << "Loop subdivision failed";
-            return;
-        }
-        
-        // 从细分器分离网格
-        loopSubdivider.detach();
-        
-        // 增加细分级别
-        subdivisionLevel++;
-        
-        // 更新边索引（用于线框渲染）
-        edges.clear();
-        for (auto eh : openMesh.edges()) {
-            auto heh = openMesh.halfedge_handle(eh, 0);
-            auto v0 = openMesh.from_vertex_handle(heh);
-            auto v1 = openMesh.to_vertex_handle(heh);
-            edges.push_back(v0.idx());
-            edges.push_back(v1.idx());
+            return false;
         }
-        
-        // 更新面索引（用于三角面渲染）
-        faces.clear();
-        for (auto fh : openMesh.faces()) {
-            for (auto fv_it = openMesh.fv_ccwbegin(fh); fv_it != openMesh.fv_ccwend(fh); ++fv_it) {
-                faces.push_back(fv_it->idx());
-            }
+        // 半边网格的顶点与面和扁平网格一一对应时，细分写出的索引可直接上传
+        if (mesh.n_vertices() == flat.vertexCount() && mesh.n_faces() == flat.triangleCount()) {
+            context.setIndices(std::move(flat.triangles), std::move(edges));
         }
-        
-        // 更新法线
-        openMesh.update_normals();
-        
-        // 重新计算曲率
-        calculateCurvatures();
-        
-        // 更新OpenGL缓冲区
-        makeCurrent();
-        updateBuffersFromOpenMesh();
-        doneCurrent();
-        
+        return true;
+    };
+    job.done = [this](bool applied) {
+        --pendingSubdivisions;
+        if (!applied) return;
+        subdivisionLevel++;
         qDebug() << "Loop subdivision applied. Current level:" << subdivisionLevel;
-    } catch (const std::exception& e) {
-        qCritical() << "Loop subdivision failed:" << e.what();
+    };
+    meshJobs.submit(std::move(job));
+}
+
+void GLWidget::performAdaptiveSubdivision()
+{
+    if (!modelLoaded || openMesh.n_vertices() == 0) return;
+    
+    // 自适应细分与均匀细分共用级别上限：每一步最多让局部三角形数翻四倍
+    if (subdivisionLevel + pendingSubdivisions >= kMaxSubdivisionLevel) {
+        qWarning() << "Maximum subdivision level (" << kMaxSubdivisionLevel << ") reached";
         return;
     }
     
-    update();
-}
\ No newline at end of file
+    // 屏幕尺寸按当前视角在模型中心（归一化后为原点）处估计，在提交前于界面线程取得
+    QMatrix4x4 model, view;
+    viewMatrices(model, view);
+    meshcore::AdaptiveSubdivisionOptions options;
+    options.maxEdgePixels = kAdaptiveEdgePixels;
+    options.pixelsPerUnit = pixelsPerUnit(model, view, QVector3D(0, 0, 0));
+    options.creaseAngle = adaptiveCreaseAngle;
+    
+    ++pendingSubdivisions;
+    MeshJob job;
+    job.name = "Adaptive subdivision";
+    job.run = [options](Mesh& mesh, MeshJobContext&) {
+        size_t refined = 0;
+        if (!meshcore::adaptiveSubdivide(mesh, options, &refined)) {
+            qWarning() << "Adaptive subdivision: no face exceeds the curvature or screen-size threshold";
+            return false;
+        }
+        qDebug() << "Adaptive subdivision refined" << refined << "faces";
+        return true;
+    };
+    job.done = [this](bool applied) {
+        --pendingSubdivisions;
+        if (!applied) return;
+        subdivisionLevel++;
+        qDebug() << "Adaptive subdivision applied. Current level:" << subdivisionLevel;
+    };
+    meshJobs.submit(std::move(job));
+}
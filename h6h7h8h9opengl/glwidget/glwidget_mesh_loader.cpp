@@ -1,12 +1,35 @@
 #include "glwidget.h"
 #include <QFile>
 #include <QDebug>
-#include <OpenMesh/Core/IO/MeshIO.hh>
+#include "../meshcore/mesh_io.h"
+#include "../meshcore/mesh_simplification.h"
+#include "../meshcore/parallel_simplification.h"
+#include "../meshcore/attribute_simplification.h"
 
 // 清除当前网格数据
 void GLWidget::clearMeshData()
 {
+    // 旧网格上的后台任务结果已无意义
+    meshJobs.cancelAndWait();
+    pendingUpload = NoUpload;
+    pendingVertices.clear();
+    progressiveMesh.reset();
+    progressiveBuildPending = false;
+    progressiveBuffers = false;
+    lodChain.reset();
+    lodBuildPending = false;
+    lodBuffers = false;
+    lodLevel = 0;
+    // 参数化纹理坐标属于旧网格
+    originalTexCoords.reset();
+    paramTexCoords.clear();
+    hasParamTexCoords = false;
+    atlasMesh.reset();
+    if (openMesh.has_vertex_texcoords2D()) openMesh.release_vertex_texcoords2D();
     openMesh.clear();
+    solverCache.clear();
+    conformalCache.clear();
+    hasPrincipalDirections = false;
     faces.clear();
     edges.clear();
     modelLoaded = false;
@@ -15,87 +38,19 @@ void GLWidget::clearMeshData()
 // 加载OBJ文件到OpenMesh
 bool GLWidget::loadOBJToOpenMesh(const QString &path)
 {
-    OpenMesh::IO::Options opt = OpenMesh::IO::Options::Default;
-    return OpenMesh::IO::read_mesh(openMesh, path.toStdString(), opt);
-}
-
-// 计算网格的边界框
-void GLWidget::computeBoundingBox(Mesh::Point& min, Mesh::Point& max)
-{
-    if (openMesh.n_vertices() > 0) {
-        min = max = openMesh.point(*openMesh.vertices_begin());
-        for (auto vh : openMesh.vertices()) {
-            min.minimize(openMesh.point(vh));
-            max.maximize(openMesh.point(vh));
-        }
-    }
-}
-
-// 中心化并缩放网格
-void GLWidget::centerAndScaleMesh(const Mesh::Point& center, float maxSize)
-{
-    float scaleFactor = 2.0f / maxSize;
-    for (auto vh : openMesh.vertices()) {
-        Mesh::Point p = openMesh.point(vh);
-        p = (p - center) * scaleFactor;
-        openMesh.set_point(vh, p);
-    }
+    return meshcore::loadMesh(openMesh, path.toStdString());
 }
 
 // 准备面索引数据（包括三角剖分）
 void GLWidget::prepareFaceIndices()
 {
-    for (auto fh : openMesh.faces()) {
-        auto fv_it = openMesh.fv_ccwbegin(fh);
-        auto fv_end = openMesh.fv_ccwend(fh);
-        int vertexCount = openMesh.valence(fh);
-        
-        if (vertexCount < 3) {
-            qWarning() << "Face with less than 3 vertices, skipping";
-            continue;
-        }
-        
-        if (vertexCount == 3) {
-            faces.push_back((*fv_it).idx()); ++fv_it;
-            faces.push_back((*fv_it).idx()); ++fv_it;
-            faces.push_back((*fv_it).idx());
-        }
-        else {
-            unsigned int centerIdx = (*fv_it).idx();
-            ++fv_it;
-            unsigned int prevIdx = (*fv_it).idx();
-            ++fv_it;
-            
-            for (int i = 2; i < vertexCount; i++) {
-                unsigned int currentIdx = (*fv_it).idx();
-                faces.push_back(centerIdx);
-                faces.push_back(prevIdx);
-                faces.push_back(currentIdx);
-                prevIdx = currentIdx;
-                ++fv_it;
-            }
-        }
-    }
+    meshcore::buildFaceIndices(openMesh, faces);
 }
 
 // 准备边索引数据
 void GLWidget::prepareEdgeIndices()
 {
-    std::set<std::pair<unsigned int, unsigned int>> uniqueEdges;
-    for (auto heh : openMesh.halfedges()) {
-        if (openMesh.is_boundary(heh) || heh.idx() < openMesh.opposite_halfedge_handle(heh).idx()) {
-            unsigned int from = openMesh.from_vertex_handle(heh).idx();
-            unsigned int to = openMesh.to_vertex_handle(heh).idx();
-            
-            if (from > to) std::swap(from, to);
-            uniqueEdges.insert({from, to});
-        }
-    }
-    
-    for (const auto& edge : uniqueEdges) {
-        edges.push_back(edge.first);
-        edges.push_back(edge.second);
-    }
+    meshcore::buildEdgeIndices(openMesh, edges);
 }
 
 // 保存原始网格状态
@@ -103,7 +58,55 @@ void GLWidget::saveOriginalMesh()
 {
     originalMesh = openMesh;
     hasOriginalMesh = true;
+    meshEdited = false;
     subdivisionLevel = 0;
+    if (lodEnabled) buildLodChain();
+}
+
+// 从.mcache缓存加载：重建半边结构，顶点块与索引直接从映射内存上传GPU。
+// 缓存缺失、过期或损坏（索引越界、不成组）时返回false，由loadOBJ改为解析OBJ
+bool GLWidget::loadFromMeshCache(const QString &path)
+{
+    const std::string source = path.toStdString();
+    meshcore::MappedMeshCache cache;
+    if (!cache.open(meshcore::meshCachePath(source), source)) {
+        return false;
+    }
+    if (!cache.restoreMesh(openMesh)) {
+        openMesh.clear();
+        return false;
+    }
+    faces.assign(cache.faceIndices(), cache.faceIndices() + cache.faceIndexCount());
+    edges.assign(cache.edgeIndices(), cache.edgeIndices() + cache.edgeIndexCount());
+    for (int f = 0; f < meshcore::CurvatureFields::FieldCount; ++f) {
+        curvatureMin[f] = cache.curvatureMin(f);
+        curvatureMax[f] = cache.curvatureMax(f);
+    }
+    saveOriginalMesh();
+
+    makeCurrent();
+    initializeShaders();
+    uploadMeshBuffers(cache.vertexBlock(), cache.vertexCount(),
+                      cache.edgeIndices(), cache.edgeIndexCount(),
+                      cache.faceIndices(), cache.faceIndexCount());
+    doneCurrent();
+    modelLoaded = true;
+
+    qDebug() << "Loaded mesh cache for" << path
+             << "\nVertices:" << openMesh.n_vertices()
+             << "Faces:" << openMesh.n_faces()
+             << "\nEdges:" << edges.size() / 2;
+    return true;
+}
+
+// 为当前（已归一化、已计算法线与曲率的）网格写入缓存；目录不可写时仅给出警告
+void GLWidget::writeMeshCacheFor(const QString &path)
+{
+    const std::string source = path.toStdString();
+    if (!meshcore::writeMeshCache(meshcore::meshCachePath(source), source,
+                                  openMesh, faces, edges)) {
+        qWarning() << "Failed to write mesh cache for" << path;
+    }
 }
 
 // 主加载函数
@@ -111,6 +114,15 @@ void GLWidget::loadOBJ(const QString &path)
 {
     // 1. 清除旧数据
     clearMeshData();
+    
+    // 优先使用有效的二进制缓存
+    if (loadFromMeshCache(path)) {
+        rotationX = rotationY = 0;
+        zoom = 1.0f;
+        update();
+        return;
+    }
+    
     // 2. 加载OBJ文件
     if (!loadOBJToOpenMesh(path)) {
         qWarning() << "Failed to load mesh:" << path;
@@ -119,13 +131,13 @@ void GLWidget::loadOBJ(const QString &path)
     
     // 3. 计算边界框
     Mesh::Point min, max;
-    computeBoundingBox(min, max);
+    meshcore::computeBoundingBox(openMesh, min, max);
     
     // 4. 中心化和缩放
     Mesh::Point center = (min + max) * 0.5f;
     Mesh::Point size = max - min;
     float maxSize = std::max({size[0], size[1], size[2]});
-    centerAndScaleMesh(center, maxSize);
+    meshcore::centerAndScaleMesh(openMesh, center, maxSize);
     
     // 5. 更新网格属性
     openMesh.request_vertex_normals();
@@ -139,9 +151,10 @@ void GLWidget::loadOBJ(const QString &path)
     // 7. 计算曲率
     calculateCurvatures();
     
-    // 8. 保存状态
+    // 8. 保存状态并写入缓存
     saveOriginalMesh();
     modelLoaded = true;
+    writeMeshCacheFor(path);
     
     // 9. 更新UI和渲染
     qDebug() << "Loaded OBJ file:" << path
@@ -164,16 +177,20 @@ void GLWidget::resetMeshOperation()
 {
     if (!hasOriginalMesh) return;
     
-    // 恢复原始网格
-    openMesh = originalMesh;
-    
-    // 更新网格数据
+    // 与滑块共用合并键：之前未完成的简化请求被取代
     meshOperationValue = 0;
-    subdivisionLevel = 0;    
-    performMeshSimplification(0);
-    updateBuffersFromOpenMesh();
-
-    update();
+    MeshJob job;
+    job.name = "Reset mesh";
+    job.coalesceKey = "simplification";
+    job.fromOriginal = true;
+    job.run = [](Mesh& mesh, MeshJobContext&) { return meshcore::simplifyMesh(mesh, 0.0f); };
+    job.done = [this](bool applied) {
+        if (applied) {
+            meshEdited = false;
+            subdivisionLevel = 0;
+        }
+    };
+    meshJobs.submit(std::move(job));
 }
 
 void GLWidget::applyMeshOperation(int sliderValue)
@@ -183,13 +200,29 @@ void GLWidget::applyMeshOperation(int sliderValue)
     // 保存新值
     meshOperationValue = sliderValue;
     
-    // 恢复原始网格
-    openMesh = originalMesh;
-    
-    float ratio = sliderValue / 100.0f;
-    performMeshSimplification(ratio);
+    const float ratio = sliderValue / 100.0f;
+    if (simplificationMethod != ProgressiveQem) {
+        // 每次从原始网格整体重新简化，拖动时只保留最新的请求
+        bool (*simplify)(Mesh&, float) = meshcore::simplifyMesh;
+        if (simplificationMethod == ParallelQem) simplify = meshcore::simplifyMeshParallel;
+        else if (simplificationMethod == AttributeQem) simplify = meshcore::simplifyMeshWithAttributes;
+        MeshJob job;
+        job.name = "Simplification";
+        job.coalesceKey = "simplification";
+        job.fromOriginal = true;
+        job.run = [ratio, simplify](Mesh& mesh, MeshJobContext&) {
+            const bool ok = simplify(mesh, ratio);
+            if (!ok) qCritical() << "Mesh simplification failed";
+            return ok;
+        };
+        meshJobs.submit(std::move(job));
+        return;
+    }
     
-    // 更新网格数据
-    updateBuffersFromOpenMesh();
-    update();
-}
\ No newline at end of file
+    // 渐进网格就绪后拖动滑块只改写索引；首次使用时先在后台构建，完成后显示最新的滑块位置
+    if (progressiveMesh) {
+        seekProgressiveLevel(ratio);
+    } else {
+        buildProgressiveMesh();
+    }
+}
@@ -1,91 +1,205 @@
 #include "glwidget.h"
-#include <queue>
-#include <map>
-#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
-#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
-
-#include "glwidget.h"
-#include <queue>
-#include <map>
-#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
-#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+#include "../meshcore/mesh_simplification.h"
+#include "../meshcore/attribute_simplification.h"
 
 void GLWidget::performMeshSimplification(float ratio) {
     if (!modelLoaded || openMesh.n_vertices() == 0) return;
     
-    // 备份原始网格（用于可能的撤销操作）
-    Mesh originalMesh = openMesh;
-    
-    try {
-        // 创建简化器实例
-        OpenMesh::Decimater::DecimaterT<Mesh> decimater(openMesh);
-        
-        // 添加QEM模块
-        OpenMesh::Decimater::ModQuadricT<Mesh>::Handle quadricModule;
-        if (!decimater.add(quadricModule)) {
-            qWarning() << "Failed to add Quadric module to decimater";
-            return;
-        }
-        
-        // 初始化简化器
-        if (!decimater.initialize()) {
-            qWarning() << "Failed to initialize decimater";
-            return;
+    // 在工作线程中简化当前网格的快照；失败时meshcore会恢复原始网格，结果被丢弃
+    // 索引与曲率在工作线程中重建，不改变当前渲染模式。带参数化纹理坐标的网格用保留属性的简化，
+    // 纹理坐标随顶点一起折叠
+    const bool keepTexCoords = openMesh.has_vertex_texcoords2D();
+    MeshJob job;
+    job.name = "Simplification";
+    job.coalesceKey = "simplification";
+    job.run = [ratio, keepTexCoords](Mesh& mesh, MeshJobContext&) {
+        const bool ok = keepTexCoords ? meshcore::simplifyMeshWithAttributes(mesh, ratio)
+                                      : meshcore::simplifyMesh(mesh, ratio);
+        if (!ok) {
+            qCritical() << "Mesh simplification failed";
+            return false;
         }
-        
-        // 计算目标顶点数
-        size_t originalVertices = openMesh.n_vertices();
-        size_t targetVertices = static_cast<size_t>(originalVertices * (1.0f - ratio));
-        if (targetVertices < 4) {
-            qWarning() << "Target vertices too low:" << targetVertices;
-            targetVertices = 4; // 保持最小网格
-        }
-        
-        // 执行简化
-        decimater.decimate_to(targetVertices);
-        
-        // 垃圾收集
-        openMesh.garbage_collection();
-        
-        // 更新法线
-        openMesh.update_normals();
-        
-        // qDebug() << "Mesh simplification completed:"
-        //          << "Original vertices:" << originalVertices
-        //          << "Target vertices:" << targetVertices
-        //          << "Actual vertices:" << openMesh.n_vertices();
-    } catch (const std::exception& e) {
-        qCritical() << "Mesh simplification failed:" << e.what();
-        openMesh = originalMesh; // 恢复原始网格
-        return;
-    }
+        return true;
+    };
+    meshJobs.submit(std::move(job));
+}
+
+// 在工作线程中记录原始网格的整条折叠序列；只读任务，不改变当前网格
+void GLWidget::buildProgressiveMesh()
+{
+    if (progressiveBuildPending) return;
+    progressiveBuildPending = true;
+    
+    std::shared_ptr<meshcore::ProgressiveMesh> built = std::make_shared<meshcore::ProgressiveMesh>();
+    MeshJob job;
+    job.name = "Progressive mesh";
+    job.fromOriginal = true;
+    job.refresh = MeshJobRefresh::None;
+    job.run = [built](Mesh& mesh, MeshJobContext&) { return built->build(mesh); };
+    job.done = [this, built](bool applied) {
+        progressiveBuildPending = false;
+        // 取消或失败（没有面）时不显示；下次拖动滑块重新构建
+        if (!applied) return;
+        progressiveMesh = built;
+        progressiveMesh->reset(progressiveLevel);
+        applyMeshOperation(meshOperationValue);
+    };
+    meshJobs.submit(std::move(job));
+}
+
+// 滑块拖动：在GUI线程中按增量重放或撤销折叠，下一次paintGL只写入索引缓冲；
+// 紧凑的精确网格（新曲率、可供后续操作使用）在工作线程中提取，拖动时只保留最新的请求
+void GLWidget::seekProgressiveLevel(float ratio)
+{
+    const size_t collapses = progressiveMesh->collapsesForRatio(ratio);
+    progressiveMesh->seek(progressiveLevel, collapses);
+    pendingUpload = ProgressiveUpload;
+    pendingVertices.clear();
+    update();
     
-    // 更新边索引（用于线框渲染）
-    edges.clear();
-    for (auto eh : openMesh.edges()) {
-        auto heh = openMesh.halfedge_handle(eh, 0);
-        auto v0 = openMesh.from_vertex_handle(heh);
-        auto v1 = openMesh.to_vertex_handle(heh);
-        edges.push_back(v0.idx());
-        edges.push_back(v1.idx());
+    std::shared_ptr<const meshcore::ProgressiveMesh> source = progressiveMesh;
+    std::shared_ptr<const std::vector<float>> texCoords = originalTexCoords;
+    MeshJob job;
+    job.name = "Simplification";
+    job.coalesceKey = "simplification";
+    job.copyMesh = false;
+    job.run = [source, texCoords, collapses](Mesh& mesh, MeshJobContext&) {
+        return source->extract(collapses, mesh, texCoords.get());
+    };
+    meshJobs.submit(std::move(job));
+}
+
+// 首次显示渐进层级时换回原始网格并上传其顶点块，索引缓冲按全分辨率分配；
+// 之后顶点缓冲不变，只写入有效的索引前缀
+void GLWidget::uploadProgressiveLevel()
+{
+    if (!progressiveBuffers) {
+        openMesh = originalMesh;
+        meshEdited = false;
+        subdivisionLevel = 0;
+        hasPrincipalDirections = false;
+        faces = progressiveLevel.faces;
+        edges = progressiveLevel.edges;
+        updateBuffersFromOpenMesh();
+        progressiveBuffers = true;
     }
     
-    // 更新面索引（用于三角面渲染）
-    faces.clear();
-    for (auto fh : openMesh.faces()) {
-        for (auto fv_it = openMesh.fv_ccwbegin(fh); fv_it != openMesh.fv_ccwend(fh); ++fv_it) {
-            faces.push_back(fv_it->idx());
+    const size_t faceCount = progressiveMesh->faceIndexCount(progressiveLevel.collapses);
+    const size_t edgeCount = progressiveMesh->edgeIndexCount(progressiveLevel.collapses);
+    faces.assign(progressiveLevel.faces.begin(), progressiveLevel.faces.begin() + faceCount);
+    edges.assign(progressiveLevel.edges.begin(), progressiveLevel.edges.begin() + edgeCount);
+    faceEbo.bind();
+    faceEbo.write(0, faces.data(), faceCount * sizeof(unsigned int));
+    faceEbo.release();
+    ebo.bind();
+    ebo.write(0, edges.data(), edgeCount * sizeof(unsigned int));
+    ebo.release();
+}
+
+void GLWidget::setLodEnabled(bool enabled)
+{
+    // LOD链取自原始网格：细分、平滑或简化后的网格不能被它悄悄替换
+    if (enabled && meshEdited) {
+        qWarning() << "Automatic LOD needs the original mesh; reset the mesh first";
+        enabled = false;
+    }
+    lodEnabled = enabled;
+    if (!hasOriginalMesh) return;
+    if (!enabled) {
+        // 换回单一层级：当前索引就是第0层，整体重新上传
+        if (lodBuffers) {
+            pendingUpload = FullUpload;
+            pendingVertices.clear();
+            update();
         }
+        return;
     }
+    if (lodChain) {
+        pendingUpload = LodUpload;
+        pendingVertices.clear();
+        update();
+    } else {
+        buildLodChain();
+    }
+}
+
+// 在工作线程中截取LOD链；渐进网格已存在时直接使用，否则先构建它并留给简化滑块复用
+void GLWidget::buildLodChain()
+{
+    if (lodBuildPending || !hasOriginalMesh) return;
+    lodBuildPending = true;
     
-    // 重新计算曲率（适配曲率可视化）
-    calculateCurvatures();
-    
-    // 更新OpenGL缓冲区（适配所有渲染模式）
-    makeCurrent();
+    std::shared_ptr<const meshcore::ProgressiveMesh> existing = progressiveMesh;
+    std::shared_ptr<meshcore::ProgressiveMesh> built = std::make_shared<meshcore::ProgressiveMesh>();
+    std::shared_ptr<meshcore::LodChain> chain = std::make_shared<meshcore::LodChain>();
+    MeshJob job;
+    job.name = "LOD chain";
+    job.fromOriginal = true;
+    job.copyMesh = !existing;
+    job.refresh = MeshJobRefresh::None;
+    job.run = [existing, built, chain](Mesh& mesh, MeshJobContext&) {
+        if (existing) return chain->build(*existing);
+        return built->build(mesh) && chain->build(*built);
+    };
+    job.done = [this, existing, built, chain](bool applied) {
+        lodBuildPending = false;
+        if (!applied) return;
+        if (!existing && !progressiveMesh) {
+            progressiveMesh = built;
+            progressiveMesh->reset(progressiveLevel);
+        }
+        lodChain = chain;
+        if (lodEnabled) {
+            pendingUpload = LodUpload;
+            pendingVertices.clear();
+            update();
+        }
+    };
+    meshJobs.submit(std::move(job));
+}
+
+// 换回原始网格并上传其顶点块；索引缓冲装入全部层级，CPU端的faces/edges保留第0层。
+// 细分级别与依赖当前网格的显示状态一起重置。等待上传期间网格若已被修改则保留修改，不替换
+void GLWidget::uploadLodChain()
+{
+    if (!lodChain || lodChain->levels().empty() || meshEdited) return;
+    const meshcore::LodChain::Level& full = lodChain->levels().front();
+    openMesh = originalMesh;
+    meshEdited = false;
+    subdivisionLevel = 0;
+    hasPrincipalDirections = false;
+    faces.assign(lodChain->faces().begin(), lodChain->faces().begin() + full.faceCount);
+    edges.assign(lodChain->edges().begin(), lodChain->edges().begin() + full.edgeCount);
     updateBuffersFromOpenMesh();
-    doneCurrent();
     
-    // 不改变当前渲染模式，保持一致性
-    update();
-}
\ No newline at end of file
+    faceEbo.bind();
+    faceEbo.allocate(lodChain->faces().data(), lodChain->faces().size() * sizeof(unsigned int));
+    faceEbo.release();
+    ebo.bind();
+    ebo.allocate(lodChain->edges().data(), lodChain->edges().size() * sizeof(unsigned int));
+    ebo.release();
+    lodBuffers = true;
+}
+
+// 包围球按当前模型视图矩阵投影到屏幕，按其像素半径选择层级；相机在球内时画完整网格
+void GLWidget::selectDrawRange(const QMatrix4x4& model, const QMatrix4x4& view)
+{
+    drawFaceOffset = 0;
+    drawFaceCount = faces.size();
+    drawEdgeOffset = 0;
+    drawEdgeCount = edges.size();
+    lodLevel = 0;
+    if (!lodBuffers || !lodChain) return;
+    
+    const float* c = lodChain->center();
+    const QVector3D center(c[0], c[1], c[2]);
+    // 相机在包围球内时绘制完整网格
+    if (-(view * model).map(center).z() > lodChain->radius() * zoom) {
+        lodLevel = lodChain->select(lodChain->radius() * pixelsPerUnit(model, view, center));
+    }
+    const meshcore::LodChain::Level& level = lodChain->levels()[lodLevel];
+    drawFaceOffset = level.faceOffset;
+    drawFaceCount = level.faceCount;
+    drawEdgeOffset = level.edgeOffset;
+    drawEdgeCount = level.edgeCount;
+}
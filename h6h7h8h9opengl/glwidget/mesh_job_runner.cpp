@@ -0,0 +1,160 @@
+#include "mesh_job_runner.h"
+#include <QMetaObject>
+#include <QRunnable>
+#include "../meshcore/curvature.h"
+#include "../meshcore/mesh_io.h"
+
+// 运行中任务的共享状态：GUI线程与工作线程各持有一份引用
+struct MeshJobState {
+    MeshJob job;
+    MeshJobResult result;
+    std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+    bool ok = false;
+};
+
+namespace {
+
+void notifyDone(MeshJob& job, bool applied)
+{
+    if (job.done) job.done(applied);
+}
+
+// 在工作线程中准备渲染数据，GUI线程只剩下上传
+void prepareRenderData(MeshJobRefresh refresh, MeshJobResult& result)
+{
+    if (refresh == MeshJobRefresh::None) return;
+    if (refresh == MeshJobRefresh::Positions) {
+        // 脏区域过大时updateDirtyCurvature已整体重算，需要整体上传
+        result.fullUpload = !meshcore::updateDirtyCurvature(result.mesh, result.updated);
+        return;
+    }
+    if (!result.indicesRebuilt) {
+        meshcore::buildFaceIndices(result.mesh, result.faces);
+        meshcore::buildEdgeIndices(result.mesh, result.edges);
+    }
+    meshcore::updateCurvatureProperties(result.mesh);
+    result.indicesRebuilt = true;
+    result.fullUpload = true;
+}
+
+} // namespace
+
+class MeshJobTask : public QRunnable {
+public:
+    MeshJobTask(MeshJobRunner* runner, const std::shared_ptr<MeshJobState>& state)
+        : runner_(runner), state_(state) {}
+
+    void run() override
+    {
+        MeshJobContext context(runner_, &state_->result, state_->cancelled, state_->job.name);
+        state_->ok = state_->job.run(state_->result.mesh, context) && !context.cancelled();
+        if (state_->ok) {
+            prepareRenderData(state_->job.refresh, state_->result);
+        }
+        // 排队回到GUI线程；runner析构前会等待本任务结束
+        MeshJobRunner* runner = runner_;
+        std::shared_ptr<MeshJobState> state = state_;
+        QMetaObject::invokeMethod(runner, [runner, state]() { runner->finish(state); },
+                                  Qt::QueuedConnection);
+    }
+
+private:
+    MeshJobRunner* runner_;
+    std::shared_ptr<MeshJobState> state_;
+};
+
+void MeshJobContext::setProgress(int percent)
+{
+    if (percent == lastPercent_) return;
+    lastPercent_ = percent;
+    MeshJobRunner* runner = runner_;
+    const QString name = name_;
+    QMetaObject::invokeMethod(runner, [runner, name, percent]() {
+        emit runner->progressChanged(name, percent);
+    }, Qt::QueuedConnection);
+}
+
+void MeshJobContext::setIndices(std::vector<unsigned int>&& faces, std::vector<unsigned int>&& edges)
+{
+    result_->faces = std::move(faces);
+    result_->edges = std::move(edges);
+    result_->indicesRebuilt = true;
+}
+
+MeshJobRunner::MeshJobRunner(SnapshotSource snapshot, ResultSink adopt, QObject* parent)
+    : QObject(parent), snapshot_(std::move(snapshot)), adopt_(std::move(adopt))
+{
+    // 同一网格上的任务必须串行；几何内核内部已用OpenMP并行
+    pool_.setMaxThreadCount(1);
+}
+
+MeshJobRunner::~MeshJobRunner()
+{
+    cancelAll();
+    pool_.waitForDone();
+}
+
+void MeshJobRunner::submit(MeshJob job)
+{
+    if (!job.coalesceKey.isEmpty()) {
+        // 滑块拖动等连续请求只保留最新的一个；运行中的旧请求结果已过时
+        if (running_ && running_->job.coalesceKey == job.coalesceKey) {
+            running_->cancelled->store(true);
+        }
+        for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+            if (it->coalesceKey == job.coalesceKey) {
+                notifyDone(*it, false);
+                *it = std::move(job);
+                return;
+            }
+        }
+    }
+    queue_.push_back(std::move(job));
+    startNext();
+}
+
+void MeshJobRunner::cancelAll()
+{
+    std::deque<MeshJob> dropped;
+    dropped.swap(queue_);
+    for (MeshJob& job : dropped) {
+        notifyDone(job, false);
+    }
+    if (running_) running_->cancelled->store(true);
+}
+
+void MeshJobRunner::cancelAndWait()
+{
+    cancelAll();
+    pool_.waitForDone();
+    // 已排队的完成回调会因为状态不匹配而被忽略
+    if (running_) {
+        std::shared_ptr<MeshJobState> state = running_;
+        running_.reset();
+        notifyDone(state->job, false);
+        emit jobFinished(state->job.name, false);
+    }
+}
+
+void MeshJobRunner::startNext()
+{
+    if (running_ || queue_.empty()) return;
+    running_ = std::make_shared<MeshJobState>();
+    running_->job = std::move(queue_.front());
+    queue_.pop_front();
+    if (running_->job.copyMesh) running_->result.mesh = snapshot_(running_->job);
+    emit jobStarted(running_->job.name);
+    pool_.start(new MeshJobTask(this, running_));
+}
+
+void MeshJobRunner::finish(const std::shared_ptr<MeshJobState>& state)
+{
+    if (state != running_) return;
+    running_.reset();
+    const bool applied = state->ok && !state->cancelled->load();
+    if (applied && state->job.refresh != MeshJobRefresh::None) adopt_(state->result);
+    notifyDone(state->job, applied);
+    // 先启动下一个任务再通知，界面据此判断是否仍然忙碌
+    startNext();
+    emit jobFinished(state->job.name, applied);
+}
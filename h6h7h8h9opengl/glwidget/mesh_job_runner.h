@@ -0,0 +1,110 @@
+#ifndef MESH_JOB_RUNNER_H
+#define MESH_JOB_RUNNER_H
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "../meshcore/mesh_types.h"
+
+class MeshJobRunner;
+struct MeshJobState;
+struct MeshJobResult;
+
+// Render data the worker prepares after the operation (任务完成后工作线程准备的渲染数据)
+enum class MeshJobRefresh {
+    Positions,   // Vertices moved: dirty-region curvature, VBO patch (顶点移动：脏区域曲率，局部改写VBO)
+    Topology,    // Connectivity changed: indices and all curvature rebuilt (拓扑改变：重建索引与全部曲率)
+    None         // Read-only job: the mesh is not adopted (只读任务：不采用网格)
+};
+
+// Handed to the operation on the worker thread (传给工作线程中操作的上下文)
+class MeshJobContext {
+public:
+    bool cancelled() const { return cancelled_->load(std::memory_order_relaxed); }
+    // 0-100; forwarded to the GUI thread only when the value changes (仅在数值变化时转发到GUI线程)
+    void setProgress(int percent);
+    // Index buffers the operation built for the returned mesh; Topology jobs then skip rebuilding them
+    // 操作已为返回的网格写出的索引；拓扑任务随后不再重建
+    void setIndices(std::vector<unsigned int>&& faces, std::vector<unsigned int>&& edges);
+
+private:
+    friend class MeshJobTask;
+    MeshJobContext(MeshJobRunner* runner, MeshJobResult* result,
+                   const std::shared_ptr<std::atomic<bool>>& cancelled, const QString& name)
+        : runner_(runner), result_(result), cancelled_(cancelled), name_(name) {}
+
+    MeshJobRunner* runner_;
+    MeshJobResult* result_;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    QString name_;
+    int lastPercent_ = -1;
+};
+
+// Output of a finished job, adopted on the GUI thread (完成的任务结果，在GUI线程中采用)
+struct MeshJobResult {
+    Mesh mesh;                              // Edited snapshot (编辑后的网格快照)
+    bool indicesRebuilt = false;            // faces/edges are valid (faces/edges有效)
+    bool fullUpload = false;                // Whole vertex block must be uploaded (需要整体上传顶点块)
+    std::vector<unsigned int> faces;
+    std::vector<unsigned int> edges;
+    std::vector<unsigned int> updated;      // Sorted vertices to patch when !fullUpload (局部改写的有序顶点)
+};
+
+// One geometry operation. run() works on a private copy of the mesh on a worker thread and
+// must not touch the widget; done() runs on the GUI thread once the job is over, with
+// applied = true after its result was adopted (false if it failed, was cancelled or replaced).
+// 一次几何操作。run()在工作线程中处理网格的私有副本，不得访问控件；done()在任务结束后于GUI线程执行，
+// 结果已被采用时applied为true（失败、取消或被取代时为false）
+struct MeshJob {
+    QString name;                           // Shown with the progress (进度显示的名称)
+    QString coalesceKey;                    // Newer jobs with the same key replace queued/running ones (相同键的新任务取代排队或运行中的旧任务)
+    bool fromOriginal = false;              // Snapshot the original mesh instead of the current one (以原始网格而非当前网格为快照)
+    bool copyMesh = true;                   // false: run() fills an empty mesh, no snapshot is taken (为false时不取快照，run()填充空网格)
+    MeshJobRefresh refresh = MeshJobRefresh::Topology;
+    std::function<bool(Mesh&, MeshJobContext&)> run;
+    std::function<void(bool applied)> done;
+};
+
+// Runs mesh jobs one at a time on a worker thread, in submission order. The snapshot is taken
+// on the GUI thread when a job starts, i.e. after the previous job was published, so every job
+// sees the result of the one before. Finished results are handed back through a queued call.
+// 在工作线程中按提交顺序逐个执行网格任务。快照在任务开始时于GUI线程获取，即上一个任务发布之后，
+// 因此每个任务都能看到前一个任务的结果。完成的结果通过排队调用交还GUI线程
+class MeshJobRunner : public QObject {
+    Q_OBJECT
+
+public:
+    typedef std::function<Mesh(const MeshJob&)> SnapshotSource;
+    typedef std::function<void(MeshJobResult&)> ResultSink;
+
+    MeshJobRunner(SnapshotSource snapshot, ResultSink adopt, QObject* parent = nullptr);
+    ~MeshJobRunner();
+
+    void submit(MeshJob job);
+    void cancelAll();                       // Cancel the running job and drop queued ones (取消运行中的任务并丢弃排队任务)
+    void cancelAndWait();                   // cancelAll, then wait until the worker is idle (并等待工作线程空闲)
+    bool busy() const { return running_ != nullptr || !queue_.empty(); }
+
+signals:
+    void jobStarted(const QString& name);
+    void progressChanged(const QString& name, int percent);
+    void jobFinished(const QString& name, bool applied);
+
+private:
+    friend class MeshJobTask;
+    void startNext();
+    void finish(const std::shared_ptr<MeshJobState>& state);
+
+    SnapshotSource snapshot_;
+    ResultSink adopt_;
+    QThreadPool pool_;
+    std::deque<MeshJob> queue_;
+    std::shared_ptr<MeshJobState> running_;
+};
+
+#endif // MESH_JOB_RUNNER_H
@@ -4,6 +4,7 @@ in vec3 Normal;
 in float Curvature;
 out vec4 FragColor;
 uniform int curvatureType;
+uniform vec2 curvatureRange;    // 当前曲率场的[min, max]，在此归一化
 
 vec3 mapToColor(float c) {
     c = clamp(c, 0.0, 1.0);
@@ -39,6 +40,8 @@ vec3 mapToColor(float c) {
 }
 
 void main() {
-    vec3 color = mapToColor(Curvature);
+    float range = curvatureRange.y - curvatureRange.x;
+    float c = range > 0.0 ? (Curvature - curvatureRange.x) / range : 0.0;
+    vec3 color = mapToColor(c);
     FragColor = vec4(color, 1.0);
 }
\ No newline at end of file
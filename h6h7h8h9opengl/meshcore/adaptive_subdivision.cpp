@@ -0,0 +1,261 @@
+#include "adaptive_subdivision.h"
+#include "curvature.h"
+#include "loop_subdivision.h"
+#include "mesh_io.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace meshcore {
+
+namespace {
+
+const unsigned int kNone = ~0u;
+
+// 二等分得到的面；之后只允许一分为四
+const char* kGreenProperty = "subdivision:green";
+
+struct CreaseEdge {
+    unsigned int a, b;
+};
+
+} // namespace
+
+bool adaptiveSubdivide(Mesh& mesh, const AdaptiveSubdivisionOptions& options, size_t* refinedFaces)
+{
+    const size_t nv = mesh.n_vertices();
+    const size_t nf = mesh.n_faces();
+    const size_t ne = mesh.n_edges();
+    if (nv == 0 || nf == 0) return false;
+
+    OpenMesh::VPropHandleT<float> meanHandle, maxHandle;
+    if (!getCurvatureProperty(mesh, CurvatureFields::Mean, meanHandle) ||
+        !getCurvatureProperty(mesh, CurvatureFields::Max, maxHandle)) {
+        updateCurvatureProperties(mesh);
+        getCurvatureProperty(mesh, CurvatureFields::Mean, meanHandle);
+        getCurvatureProperty(mesh, CurvatureFields::Max, maxHandle);
+    }
+    OpenMesh::FPropHandleT<bool> greenHandle;
+    const bool hasGreen = mesh.get_property_handle(greenHandle, kGreenProperty);
+
+    // 三角形：角k的顶点，以及从角k到角k+1的边
+    std::vector<unsigned int> tri(3 * nf), triEdge(3 * nf);
+    for (auto fh : mesh.faces()) {
+        auto heh = mesh.halfedge_handle(fh);
+        for (int k = 0; k < 3; ++k) {
+            tri[3 * fh.idx() + k] = mesh.from_vertex_handle(heh).idx();
+            triEdge[3 * fh.idx() + k] = mesh.edge_handle(heh).idx();
+            heh = mesh.next_halfedge_handle(heh);
+        }
+    }
+
+    // 折痕：带标记的边与（可选）二面角过尖的边；边界边在位置规则中同样按折痕处理
+    const float creaseCos = std::cos(options.creaseAngle * 3.14159265f / 180.0f);
+    const bool tagged = mesh.has_edge_status();
+    std::vector<unsigned char> crease(ne, 0), sharp(ne, 0);
+    #pragma omp parallel for schedule(static)
+    for (long long e = 0; e < static_cast<long long>(ne); ++e) {
+        const Mesh::EdgeHandle eh(static_cast<int>(e));
+        if (mesh.is_boundary(eh)) {
+            sharp[e] = 1;
+            continue;
+        }
+        bool isCrease = tagged && mesh.status(eh).feature();
+        if (!isCrease && options.creaseAngle > 0.0f) {
+            const Mesh::Normal n0 = mesh.calc_face_normal(mesh.face_handle(mesh.halfedge_handle(eh, 0)));
+            const Mesh::Normal n1 = mesh.calc_face_normal(mesh.face_handle(mesh.halfedge_handle(eh, 1)));
+            isCrease = OpenMesh::dot(n0, n1) < creaseCos;
+        }
+        crease[e] = sharp[e] = isCrease ? 1 : 0;
+    }
+
+    // 按曲率与屏幕尺寸选择要一分为四的面：|曲率|×边长近似面内法线的转角
+    std::vector<unsigned char> refine(nf, 0);
+    const std::vector<float>& mean = mesh.property(meanHandle).data_vector();
+    const std::vector<float>& kmax = mesh.property(maxHandle).data_vector();
+    const float* points = reinterpret_cast<const float*>(mesh.points());
+    #pragma omp parallel for schedule(static)
+    for (long long f = 0; f < static_cast<long long>(nf); ++f) {
+        float kappa = 0.0f, longest = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            const unsigned int v = tri[3 * f + k];
+            const float* a = points + 3 * v;
+            const float* b = points + 3 * tri[3 * f + (k + 1) % 3];
+            const float dx = b[0] - a[0], dy = b[1] - a[1], dz = b[2] - a[2];
+            longest = std::max(longest, dx * dx + dy * dy + dz * dz);
+            kappa = std::max(kappa, std::max(std::fabs(mean[v]), std::fabs(kmax[v])));
+        }
+        longest = std::sqrt(longest);
+        const bool curved = kappa * longest > options.curvatureTolerance;
+        const bool large = options.maxEdgePixels > 0.0f && longest * options.pixelsPerUnit > options.maxEdgePixels;
+        refine[f] = (curved || large) ? 1 : 0;
+    }
+
+    // 红绿闭包：有两条被分边、或带二等分标记且有被分边的面也一分为四，沿新被分的边向外传播
+    std::vector<unsigned char> split(ne, 0);
+    std::vector<unsigned int> work;
+    auto splitFace = [&](unsigned int f) {
+        for (int k = 0; k < 3; ++k) {
+            const unsigned int e = triEdge[3 * f + k];
+            if (split[e]) continue;
+            split[e] = 1;
+            const Mesh::EdgeHandle eh(static_cast<int>(e));
+            for (int side = 0; side < 2; ++side) {
+                const Mesh::FaceHandle neighbour = mesh.face_handle(mesh.halfedge_handle(eh, side));
+                if (neighbour.is_valid() && !refine[neighbour.idx()]) work.push_back(neighbour.idx());
+            }
+        }
+    };
+    for (size_t f = 0; f < nf; ++f) {
+        if (refine[f]) splitFace(static_cast<unsigned int>(f));
+    }
+    while (!work.empty()) {
+        const unsigned int f = work.back();
+        work.pop_back();
+        if (refine[f]) continue;
+        const int count = split[triEdge[3 * f]] + split[triEdge[3 * f + 1]] + split[triEdge[3 * f + 2]];
+        const bool green = hasGreen && mesh.property(greenHandle, Mesh::FaceHandle(static_cast<int>(f)));
+        if (count >= 2 || (count == 1 && green)) {
+            refine[f] = 1;
+            splitFace(f);
+        }
+    }
+    const size_t refined = std::count(refine.begin(), refine.end(), 1);
+    if (refined == 0) return false;
+
+    // 新顶点：被分边e的边点编号为edgePoint[e]
+    std::vector<unsigned int> edgePoint(ne, kNone);
+    unsigned int vertexCount = static_cast<unsigned int>(nv);
+    for (size_t e = 0; e < ne; ++e) {
+        if (split[e]) edgePoint[e] = vertexCount++;
+    }
+    FlatMesh flat;
+    flat.positions.resize(3 * static_cast<size_t>(vertexCount));
+
+    #pragma omp parallel for schedule(static)
+    for (long long e = 0; e < static_cast<long long>(ne); ++e) {
+        if (!split[e]) continue;
+        const Mesh::EdgeHandle eh(static_cast<int>(e));
+        const auto h0 = mesh.halfedge_handle(eh, 0), h1 = mesh.halfedge_handle(eh, 1);
+        const float* a = points + 3 * mesh.to_vertex_handle(h0).idx();
+        const float* b = points + 3 * mesh.to_vertex_handle(h1).idx();
+        float* out = &flat.positions[3 * static_cast<size_t>(edgePoint[e])];
+        if (sharp[e]) {
+            for (int k = 0; k < 3; ++k) out[k] = 0.5f * (a[k] + b[k]);
+        } else {
+            const float* c = points + 3 * mesh.to_vertex_handle(mesh.next_halfedge_handle(h0)).idx();
+            const float* d = points + 3 * mesh.to_vertex_handle(mesh.next_halfedge_handle(h1)).idx();
+            for (int k = 0; k < 3; ++k) out[k] = 0.375f * (a[k] + b[k]) + 0.125f * (c[k] + d[k]);
+        }
+    }
+
+    // 旧顶点：只有1环全部一分为四的顶点移动，其余保持原位
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < static_cast<long long>(nv); ++v) {
+        const Mesh::VertexHandle vh(static_cast<int>(v));
+        const float* p = points + 3 * v;
+        float* out = &flat.positions[3 * v];
+        for (int k = 0; k < 3; ++k) out[k] = p[k];
+
+        bool inside = !mesh.is_isolated(vh);
+        for (auto fh : mesh.vf_range(vh)) {
+            if (!refine[fh.idx()]) {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside) continue;
+
+        float sum[3] = {0.0f, 0.0f, 0.0f};
+        unsigned int valence = 0, sharpCount = 0;
+        const float* sharpEnds[2] = {nullptr, nullptr};
+        for (auto heh : mesh.voh_range(vh)) {
+            const float* q = points + 3 * mesh.to_vertex_handle(heh).idx();
+            for (int k = 0; k < 3; ++k) sum[k] += q[k];
+            ++valence;
+            if (sharp[mesh.edge_handle(heh).idx()]) {
+                if (sharpCount < 2) sharpEnds[sharpCount] = q;
+                ++sharpCount;
+            }
+        }
+        if (sharpCount == 2) {
+            for (int k = 0; k < 3; ++k) out[k] = 0.75f * p[k] + 0.125f * (sharpEnds[0][k] + sharpEnds[1][k]);
+        } else if (sharpCount < 2) {
+            // 没有折痕或只有一条（dart）时用光滑规则
+            const float beta = loopBeta(valence);
+            const float self = 1.0f - valence * beta;
+            for (int k = 0; k < 3; ++k) out[k] = self * p[k] + beta * sum[k];
+        }
+    }
+
+    // 新三角形：一分为四的面与Loop内核的子三角形顺序相同，只有一条被分边的面二等分
+    std::vector<unsigned char> green;
+    flat.triangles.reserve(3 * (nf + 3 * refined + nf / 4));
+    green.reserve(nf + 3 * refined + nf / 4);
+    for (size_t f = 0; f < nf; ++f) {
+        const unsigned int* v = &tri[3 * f];
+        unsigned int m[3];
+        int splitCorner = -1;
+        for (int k = 0; k < 3; ++k) {
+            m[k] = edgePoint[triEdge[3 * f + k]];
+            if (m[k] != kNone) splitCorner = k;
+        }
+        if (refine[f]) {
+            for (int c = 0; c < 3; ++c) {
+                flat.triangles.insert(flat.triangles.end(), {v[c], m[c], m[(c + 2) % 3]});
+            }
+            flat.triangles.insert(flat.triangles.end(), {m[0], m[1], m[2]});
+            green.insert(green.end(), 4, 0);
+        } else if (splitCorner >= 0) {
+            const int k = splitCorner;
+            flat.triangles.insert(flat.triangles.end(), {v[k], m[k], v[(k + 2) % 3]});
+            flat.triangles.insert(flat.triangles.end(), {m[k], v[(k + 1) % 3], v[(k + 2) % 3]});
+            green.insert(green.end(), 2, 1);
+        } else {
+            flat.triangles.insert(flat.triangles.end(), v, v + 3);
+            const bool wasGreen = hasGreen && mesh.property(greenHandle, Mesh::FaceHandle(static_cast<int>(f)));
+            green.push_back(wasGreen ? 1 : 0);
+        }
+    }
+
+    // 折痕标记传给两半
+    std::vector<CreaseEdge> creases;
+    for (size_t e = 0; e < ne; ++e) {
+        if (!crease[e]) continue;
+        const auto h0 = mesh.halfedge_handle(Mesh::EdgeHandle(static_cast<int>(e)), 0);
+        const unsigned int a = mesh.from_vertex_handle(h0).idx(), b = mesh.to_vertex_handle(h0).idx();
+        if (split[e]) {
+            creases.push_back({a, edgePoint[e]});
+            creases.push_back({edgePoint[e], b});
+        } else {
+            creases.push_back({a, b});
+        }
+    }
+
+    Mesh result;
+    if (!fromFlatMesh(flat, result)) {
+        std::cerr << "Adaptive subdivision failed: could not rebuild the mesh" << std::endl;
+        return false;
+    }
+    if (!creases.empty()) {
+        result.request_edge_status();
+        for (const CreaseEdge& c : creases) {
+            const auto heh = result.find_halfedge(Mesh::VertexHandle(c.a), Mesh::VertexHandle(c.b));
+            if (heh.is_valid()) result.status(result.edge_handle(heh)).set_feature(true);
+        }
+    }
+    // 非流形面被复制顶点时面序号可能错位，此时放弃二等分标记
+    if (result.n_faces() == green.size()) {
+        OpenMesh::FPropHandleT<bool> handle;
+        result.add_property(handle, kGreenProperty);
+        for (auto fh : result.faces()) {
+            result.property(handle, fh) = green[fh.idx()] != 0;
+        }
+    }
+    mesh = std::move(result);
+    if (refinedFaces) *refinedFaces = refined;
+    return true;
+}
+
+} // namespace meshcore
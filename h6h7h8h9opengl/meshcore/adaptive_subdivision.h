@@ -0,0 +1,37 @@
+#ifndef MESHCORE_ADAPTIVE_SUBDIVISION_H
+#define MESHCORE_ADAPTIVE_SUBDIVISION_H
+
+#include "mesh_types.h"
+#include <cstddef>
+
+namespace meshcore {
+
+// Which faces one adaptive step refines (一次自适应细分选择细分哪些面)
+struct AdaptiveSubdivisionOptions {
+    float curvatureTolerance = 0.05f;   // Refine where |curvature| * longest edge exceeds this (|曲率|×最长边超过此值时细分)
+    float maxEdgePixels = 0.0f;         // Also refine faces whose longest edge covers more pixels, 0 = off (最长边超过此像素数也细分，0为关闭)
+    float pixelsPerUnit = 0.0f;         // Screen pixels per model unit for maxEdgePixels (每单位模型长度的屏幕像素数)
+    float creaseAngle = 0.0f;           // Also treat edges with a sharper dihedral angle (degrees) as creases, 0 = tags only (二面角更尖的边也视为折痕（度），0为只用标记)
+};
+
+// One step of red-green Loop refinement. Faces whose curvature (the stored "curvature:mean"
+// and "curvature:max" fields, computed first if missing) or screen size exceeds the options
+// are split 1-to-4; a face with two split edges is split as well, and a face with one split
+// edge is bisected so the result has no T-junctions. Bisected faces are tagged and are split
+// 1-to-4 rather than bisected again, so their angles degrade at most once. New edge points
+// and the vertices whose whole 1-ring was split take Loop positions; other vertices stay in
+// place so the unrefined part of the surface does not move. Crease edges (edge status feature
+// flag, see buildMesh) and boundary edges use the crease rules: edge points at the midpoint,
+// vertices on two creases 3/4-1/8-1/8, corners fixed; their halves stay creases.
+// Returns false and leaves the mesh unchanged when no face needs refining.
+// 一步红绿Loop细分。曲率（已存的"curvature:mean"与"curvature:max"场，缺失时先计算）或屏幕尺寸
+// 超过阈值的面一分为四；有两条被分边的面同样一分为四，只有一条被分边的面二等分，结果没有T形连接。
+// 二等分出的面带有标记，之后只会一分为四而不会再被二等分，因此角度至多退化一次。新的边点与
+// 1环全部被细分的顶点取Loop位置；其余顶点不动，未细分部分的曲面保持不变。折痕边（边状态的feature
+// 标记，见buildMesh）与边界边使用折痕规则：边点取中点，位于两条折痕上的顶点取3/4-1/8-1/8，
+// 角点固定；折痕的两半仍是折痕。没有需要细分的面时返回false，网格不变
+bool adaptiveSubdivide(Mesh& mesh, const AdaptiveSubdivisionOptions& options, size_t* refinedFaces = nullptr);
+
+} // namespace meshcore
+
+#endif // MESHCORE_ADAPTIVE_SUBDIVISION_H
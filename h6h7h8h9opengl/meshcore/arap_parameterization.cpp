@@ -0,0 +1,270 @@
+#include "arap_parameterization.h"
+#include "conformal_parameterization.h"
+#include "dirty_region.h"
+#include "mesh_io.h"
+#include "parameterization.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace meshcore {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double kMinDoubleArea = 1e-12;   // 小于该值的三角形视为退化，余切取0
+
+// 三角形数据按SoA存放：角k的对边d_k = x_{k+2} - x_{k+1}（三角形自身平面内的二维坐标）及其余切
+struct ArapTriangles {
+    std::vector<double> dx[3], dy[3], cot[3];
+    std::vector<double> area;
+    double totalArea = 0.0;
+};
+
+void buildTriangles(const FlatMesh& mesh, ArapTriangles& data)
+{
+    const long long nt = static_cast<long long>(mesh.triangleCount());
+    for (int k = 0; k < 3; ++k) {
+        data.dx[k].resize(nt);
+        data.dy[k].resize(nt);
+        data.cot[k].resize(nt);
+    }
+    data.area.resize(nt);
+    const float* pos = mesh.positions.data();
+    const unsigned int* tri = mesh.triangles.data();
+
+    #pragma omp parallel for schedule(static)
+    for (long long t = 0; t < nt; ++t) {
+        const float* p[3] = {pos + 3 * tri[3 * t], pos + 3 * tri[3 * t + 1], pos + 3 * tri[3 * t + 2]};
+        double e1[3], e2[3];
+        for (int a = 0; a < 3; ++a) {
+            e1[a] = p[1][a] - p[0][a];
+            e2[a] = p[2][a] - p[0][a];
+        }
+        const double cx = e1[1] * e2[2] - e1[2] * e2[1];
+        const double cy = e1[2] * e2[0] - e1[0] * e2[2];
+        const double cz = e1[0] * e2[1] - e1[1] * e2[0];
+        const double doubleArea = std::sqrt(cx * cx + cy * cy + cz * cz);
+        const double length = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+        const bool degenerate = doubleArea <= kMinDoubleArea || length <= 0.0;
+
+        // 局部坐标：x0在原点，x1在x轴上，x2在上半平面（保持三角形的朝向）
+        double x[3][2] = {{0.0, 0.0}, {length, 0.0}, {0.0, 0.0}};
+        if (!degenerate) {
+            x[2][0] = (e1[0] * e2[0] + e1[1] * e2[1] + e1[2] * e2[2]) / length;
+            x[2][1] = doubleArea / length;
+        }
+        for (int k = 0; k < 3; ++k) {
+            const double* a = x[(k + 1) % 3];
+            const double* b = x[(k + 2) % 3];
+            data.dx[k][t] = b[0] - a[0];
+            data.dy[k][t] = b[1] - a[1];
+            // 角k的余切：两条邻边的点积除以两倍面积
+            const double* o = x[k];
+            const double ux = a[0] - o[0], uy = a[1] - o[1], vx = b[0] - o[0], vy = b[1] - o[1];
+            data.cot[k][t] = degenerate ? 0.0 : (ux * vx + uy * vy) / doubleArea;
+        }
+        data.area[t] = 0.5 * doubleArea;
+    }
+    data.totalArea = 0.0;
+    for (double a : data.area) data.totalArea += a;
+}
+
+} // namespace
+
+bool arapParameterize(const FlatMesh& mesh, std::vector<double>& uv, int iterations,
+                      std::vector<ArapIteration>* log)
+{
+    const size_t n = mesh.vertexCount();
+    const long long nt = static_cast<long long>(mesh.triangleCount());
+    if (n == 0 || nt == 0 || uv.size() != 2 * n || iterations <= 0) return false;
+
+    ArapTriangles data;
+    buildTriangles(mesh, data);
+    VertexCorners adjacency;
+    adjacency.build(mesh);
+    const unsigned int* tri = mesh.triangles.data();
+
+    // 未知量：固定第一个非孤立顶点（消除平移）与全部孤立顶点
+    std::vector<int> unknown(n, -1);
+    int freeCount = 0;
+    bool pinned = false;
+    for (size_t v = 0; v < n; ++v) {
+        if (adjacency.begin(v) == adjacency.end(v)) continue;
+        if (!pinned) {
+            pinned = true;
+            continue;
+        }
+        unknown[v] = freeCount++;
+    }
+    if (freeCount == 0) return false;
+
+    // 全局步的矩阵只依赖三维网格：余切拉普拉斯的自由块只分解一次
+    typedef Eigen::Triplet<double> Entry;
+    std::vector<Entry> system, coupling;
+    system.reserve(12 * nt);
+    auto add = [&](unsigned int i, unsigned int j, double w) {
+        if (unknown[i] < 0) return;
+        system.emplace_back(unknown[i], unknown[i], w);
+        if (unknown[j] >= 0) system.emplace_back(unknown[i], unknown[j], -w);
+        else coupling.emplace_back(unknown[i], j, w);
+    };
+    for (long long t = 0; t < nt; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const unsigned int i = tri[3 * t + (k + 1) % 3], j = tri[3 * t + (k + 2) % 3];
+            add(i, j, data.cot[k][t]);
+            add(j, i, data.cot[k][t]);
+        }
+    }
+    Eigen::SparseMatrix<double> matrix(freeCount, freeCount), couplingMatrix(freeCount, n);
+    matrix.setFromTriplets(system.begin(), system.end());
+    couplingMatrix.setFromTriplets(coupling.begin(), coupling.end());
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(matrix);
+    if (solver.info() != Eigen::Success) {
+        std::cerr << "ARAP global system factorization failed (is the mesh connected?)" << std::endl;
+        return false;
+    }
+
+    // 固定顶点对右端的贡献在迭代中不变
+    Eigen::MatrixXd fixedValues = Eigen::MatrixXd::Zero(n, 2);
+    for (size_t v = 0; v < n; ++v) {
+        if (unknown[v] < 0) fixedValues.row(v) << uv[2 * v], uv[2 * v + 1];
+    }
+    const Eigen::MatrixXd fixedRhs = couplingMatrix * fixedValues;
+
+    std::vector<double> rotCos(nt), rotSin(nt), triangleEnergy(nt);
+    std::vector<double> cornerRhs(6 * nt);
+    Eigen::MatrixXd rhs(freeCount, 2);
+    if (log) log->clear();
+
+    for (int iteration = 0; iteration <= iterations; ++iteration) {
+        const auto start = Clock::now();
+
+        // 局部步：S = sum_k cot_k du_k dx_k^T，最近的旋转R(θ)满足(cosθ, sinθ) ∝ (S00 + S11, S10 - S01)。
+        // 二维极分解是闭式的，无需SVD与分支，逐三角形的循环可被编译器向量化
+        const double* u = uv.data();
+        #pragma omp parallel for simd schedule(static)
+        for (long long t = 0; t < nt; ++t) {
+            double du[3][2];
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int a = tri[3 * t + (k + 1) % 3], b = tri[3 * t + (k + 2) % 3];
+                du[k][0] = u[2 * b] - u[2 * a];
+                du[k][1] = u[2 * b + 1] - u[2 * a + 1];
+            }
+            double s00 = 0.0, s01 = 0.0, s10 = 0.0, s11 = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                const double c = data.cot[k][t];
+                s00 += c * du[k][0] * data.dx[k][t];
+                s01 += c * du[k][0] * data.dy[k][t];
+                s10 += c * du[k][1] * data.dx[k][t];
+                s11 += c * du[k][1] * data.dy[k][t];
+            }
+            const double p = s00 + s11, q = s10 - s01;
+            const double r = std::sqrt(p * p + q * q);
+            const double cs = r > 0.0 ? p / r : 1.0;
+            const double sn = r > 0.0 ? q / r : 0.0;
+            rotCos[t] = cs;
+            rotSin[t] = sn;
+
+            // 能量：1/2 sum_k cot_k |du_k - R dx_k|^2 = ∫|J - R|^2
+            double energy = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                const double rx = cs * data.dx[k][t] - sn * data.dy[k][t];
+                const double ry = sn * data.dx[k][t] + cs * data.dy[k][t];
+                const double ex = du[k][0] - rx, ey = du[k][1] - ry;
+                energy += 0.5 * data.cot[k][t] * (ex * ex + ey * ey);
+            }
+            triangleEnergy[t] = energy;
+
+            // 全局步右端的逐角贡献：角k的顶点 i 得到 c_{k+1} R d_{k+1} - c_{k+2} R d_{k+2}
+            for (int k = 0; k < 3; ++k) {
+                const int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+                const double x = data.cot[k1][t] * data.dx[k1][t] - data.cot[k2][t] * data.dx[k2][t];
+                const double y = data.cot[k1][t] * data.dy[k1][t] - data.cot[k2][t] * data.dy[k2][t];
+                cornerRhs[6 * t + 2 * k] = cs * x - sn * y;
+                cornerRhs[6 * t + 2 * k + 1] = sn * x + cs * y;
+            }
+        }
+        double energy = 0.0;
+        for (double e : triangleEnergy) energy += e;
+        energy /= data.totalArea > 0.0 ? data.totalArea : 1.0;
+        // 局部步给出的是上一次全局步结果的能量
+        if (log && iteration > 0) (*log)[iteration - 1].energy = energy;
+        if (iteration == iterations) break;
+
+        // 全局步：按顶点收集各角的贡献，用已有分解回代u、v两列
+        #pragma omp parallel for schedule(static)
+        for (long long v = 0; v < static_cast<long long>(n); ++v) {
+            if (unknown[v] < 0) continue;
+            double bx = 0.0, by = 0.0;
+            for (unsigned int i = adjacency.begin(v); i < adjacency.end(v); ++i) {
+                const unsigned int c = adjacency.corners[i];
+                bx += cornerRhs[2 * c];
+                by += cornerRhs[2 * c + 1];
+            }
+            rhs(unknown[v], 0) = bx + fixedRhs(unknown[v], 0);
+            rhs(unknown[v], 1) = by + fixedRhs(unknown[v], 1);
+        }
+        const Eigen::MatrixXd solution = solver.solve(rhs);
+        if (solver.info() != Eigen::Success) {
+            std::cerr << "ARAP global step failed" << std::endl;
+            return false;
+        }
+        for (size_t v = 0; v < n; ++v) {
+            if (unknown[v] < 0) continue;
+            uv[2 * v] = solution(unknown[v], 0);
+            uv[2 * v + 1] = solution(unknown[v], 1);
+        }
+
+        if (log) {
+            ArapIteration entry;
+            entry.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            log->push_back(entry);
+        }
+    }
+    return true;
+}
+
+bool arapParameterize(Mesh& mesh, int iterations, ArapInit init, std::vector<ArapIteration>* log,
+                      DirichletSolverCache* harmonicCache, ConformalSolverCache* conformalCache)
+{
+    if (mesh.n_vertices() == 0) return false;
+
+    // 先保存三维网格，初始映射会覆盖顶点坐标
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    auto restore = [&]() {
+        for (auto vh : mesh.vertices()) {
+            const float* p = &flat.positions[3 * vh.idx()];
+            mesh.set_point(vh, Mesh::Point(p[0], p[1], p[2]));
+        }
+    };
+    const bool seeded = init == ArapInit::Conformal ? conformalParameterize(mesh, conformalCache)
+                                                    : parameterize(mesh, ParamBoundary::Circle, harmonicCache);
+    if (!seeded) {
+        restore();
+        return false;
+    }
+
+    std::vector<double> uv(2 * mesh.n_vertices());
+    for (auto vh : mesh.vertices()) {
+        const Mesh::Point& p = mesh.point(vh);
+        uv[2 * vh.idx()] = p[0];
+        uv[2 * vh.idx() + 1] = p[1];
+    }
+    if (!arapParameterize(flat, uv, iterations, log)) {
+        std::cerr << "ARAP parameterization failed" << std::endl;
+        restore();
+        return false;
+    }
+    for (auto vh : mesh.vertices()) {
+        mesh.set_point(vh, Mesh::Point(uv[2 * vh.idx()], uv[2 * vh.idx() + 1], 0.0f));
+    }
+    markAllDirty(mesh);
+    return true;
+}
+
+} // namespace meshcore
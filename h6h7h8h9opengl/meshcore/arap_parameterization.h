@@ -0,0 +1,49 @@
+#ifndef MESHCORE_ARAP_PARAMETERIZATION_H
+#define MESHCORE_ARAP_PARAMETERIZATION_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include <vector>
+
+namespace meshcore {
+
+class ConformalSolverCache;
+class DirichletSolverCache;
+
+// Map that seeds the ARAP iterations (ARAP迭代的初始映射)
+enum class ArapInit {
+    Harmonic,            // Tutte/harmonic map onto a circle (映射到圆形的调和参数化)
+    Conformal            // Free-boundary LSCM (自由边界LSCM)
+};
+
+// One local/global iteration (一次局部/全局迭代)
+struct ArapIteration {
+    double energy = 0.0;        // Area-weighted mean of |J - R|^2 over the triangles (三角形上|J - R|^2的面积加权平均)
+    double milliseconds = 0.0;  // Local + global step (局部与全局步的耗时)
+};
+
+// As-rigid-as-possible parameterization (Liu et al. 2008) on a flat 3D mesh. uv holds the
+// initial map (2 values per vertex) and receives the result. The local step fits the closest
+// rotation to each triangle's Jacobian in closed form, over structure-of-arrays triangle data
+// in one parallel, vectorizable pass; the global step solves the cotangent Laplacian system,
+// which does not depend on the map, so it is factored once and every iteration is a single
+// back-substitution. One vertex is pinned to remove the translation.
+// 扁平三维网格上的尽可能刚性参数化（Liu等 2008）。uv为初始映射（每个顶点2个值）并接收结果。
+// 局部步以闭式解拟合每个三角形雅可比矩阵最近的旋转，三角形数据按SoA存放，一遍并行、可向量化；
+// 全局步求解余切拉普拉斯系统，它与映射无关，因此只分解一次，之后每次迭代只做一次回代。
+// 固定一个顶点以消除平移
+bool arapParameterize(const FlatMesh& mesh, std::vector<double>& uv, int iterations,
+                      std::vector<ArapIteration>* log = nullptr);
+
+// ARAP parameterization of mesh seeded by the harmonic or LSCM map; vertex positions become
+// (u, v, 0) and keep the scale of the model. The caches are used by the initial map only
+// 以调和或LSCM映射为初值的ARAP参数化；顶点坐标被替换为(u, v, 0)，保持模型的尺度。
+// 缓存只用于初始映射
+bool arapParameterize(Mesh& mesh, int iterations, ArapInit init = ArapInit::Conformal,
+                      std::vector<ArapIteration>* log = nullptr,
+                      DirichletSolverCache* harmonicCache = nullptr,
+                      ConformalSolverCache* conformalCache = nullptr);
+
+} // namespace meshcore
+
+#endif // MESHCORE_ARAP_PARAMETERIZATION_H
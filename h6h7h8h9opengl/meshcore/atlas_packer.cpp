@@ -0,0 +1,309 @@
+#include "atlas_packer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace meshcore {
+
+namespace {
+
+// 图块在自身最小包围矩形坐标系中的位置：先按(c, s)旋转，再减去(minX, minY)
+struct ChartFrame {
+    double c = 1.0, s = 0.0;
+    double minX = 0.0, minY = 0.0;
+    double width = 0.0, height = 0.0;
+};
+
+inline double cross(const double* o, const double* a, const double* b)
+{
+    return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+}
+
+// 单调链凸包；hull按逆时针存放点坐标
+void convexHull(std::vector<double>& points, std::vector<double>& hull)
+{
+    const size_t n = points.size() / 2;
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return points[2 * a] < points[2 * b] || (points[2 * a] == points[2 * b] && points[2 * a + 1] < points[2 * b + 1]);
+    });
+    hull.assign(2 * (2 * n + 1), 0.0);
+    size_t k = 0;
+    auto push = [&](size_t i, size_t lower) {
+        const double* p = &points[2 * i];
+        while (k >= lower + 2 && cross(&hull[2 * (k - 2)], &hull[2 * (k - 1)], p) <= 0.0) --k;
+        hull[2 * k] = p[0];
+        hull[2 * k + 1] = p[1];
+        ++k;
+    };
+    for (size_t i = 0; i < n; ++i) push(order[i], 0);
+    const size_t lower = k - 1;
+    for (size_t i = n - 1; i-- > 0;) push(order[i], lower);
+    hull.resize(2 * (n > 1 ? k - 1 : k));
+}
+
+// 旋转卡壳：最小面积包围矩形的一条边与凸包的某条边共线，逐边尝试
+void fitFrame(const double* uv, size_t count, ChartFrame& frame)
+{
+    std::vector<double> points(uv, uv + 2 * count), hull;
+    convexHull(points, hull);
+    const size_t h = hull.size() / 2;
+    double bestArea = std::numeric_limits<double>::max();
+    for (size_t e = 0; e < std::max<size_t>(h, 1); ++e) {
+        double c = 1.0, s = 0.0;
+        if (h > 1) {
+            const double dx = hull[2 * ((e + 1) % h)] - hull[2 * e], dy = hull[2 * ((e + 1) % h) + 1] - hull[2 * e + 1];
+            const double length = std::sqrt(dx * dx + dy * dy);
+            if (length == 0.0) continue;
+            c = dx / length;
+            s = dy / length;
+        }
+        double lo[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        double hi[2] = {-lo[0], -lo[1]};
+        for (size_t i = 0; i < h; ++i) {
+            const double x = c * hull[2 * i] + s * hull[2 * i + 1];
+            const double y = -s * hull[2 * i] + c * hull[2 * i + 1];
+            lo[0] = std::min(lo[0], x);
+            lo[1] = std::min(lo[1], y);
+            hi[0] = std::max(hi[0], x);
+            hi[1] = std::max(hi[1], y);
+        }
+        const double area = (hi[0] - lo[0]) * (hi[1] - lo[1]);
+        if (area < bestArea) {
+            bestArea = area;
+            frame.c = c;
+            frame.s = s;
+            frame.minX = lo[0];
+            frame.minY = lo[1];
+            frame.width = hi[0] - lo[0];
+            frame.height = hi[1] - lo[1];
+        }
+    }
+    // 所有点重合时没有非零长度的边：图块退化为该点本身
+    if (bestArea == std::numeric_limits<double>::max()) {
+        frame.c = 1.0;
+        frame.s = 0.0;
+        frame.minX = hull[0];
+        frame.minY = hull[1];
+        frame.width = frame.height = 0.0;
+    }
+}
+
+// 天际线：覆盖[0, width)的水平线段，按x排序
+class Skyline {
+public:
+    explicit Skyline(int width) : width_(width) { segments_.push_back({0, 0, width}); }
+
+    // 矩形左端对齐第i段时的底边高度，放不下时为-1
+    int fit(size_t i, int w) const
+    {
+        const int x = segments_[i].x;
+        if (x + w > width_) return -1;
+        int y = 0;
+        for (int remaining = w; remaining > 0; ++i) {
+            y = std::max(y, segments_[i].y);
+            remaining -= segments_[i].width;
+        }
+        return y;
+    }
+
+    // 左下优先：顶边最低，其次底边最低（浪费的空隙最少）
+    bool find(int w, int h, size_t& segment, int& y) const
+    {
+        int bestTop = std::numeric_limits<int>::max(), bestY = 0;
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            const int bottom = fit(i, w);
+            if (bottom < 0) break;
+            if (bottom + h < bestTop || (bottom + h == bestTop && bottom < bestY)) {
+                bestTop = bottom + h;
+                bestY = bottom;
+                segment = i;
+            }
+        }
+        y = bestY;
+        return bestTop != std::numeric_limits<int>::max();
+    }
+
+    // 在第i段左端放下宽w、顶边为top的矩形，返回其x
+    int place(size_t i, int w, int top)
+    {
+        const int x = segments_[i].x;
+        segments_.insert(segments_.begin() + i, {x, top, w});
+        // 裁掉被新线段覆盖的部分
+        while (i + 1 < segments_.size() && segments_[i + 1].x < x + w) {
+            Segment& next = segments_[i + 1];
+            const int overlap = x + w - next.x;
+            if (overlap < next.width) {
+                next.x += overlap;
+                next.width -= overlap;
+                break;
+            }
+            segments_.erase(segments_.begin() + i + 1);
+        }
+        // 合并等高的相邻线段
+        if (i + 1 < segments_.size() && segments_[i + 1].y == top) {
+            segments_[i].width += segments_[i + 1].width;
+            segments_.erase(segments_.begin() + i + 1);
+        }
+        if (i > 0 && segments_[i - 1].y == top) {
+            segments_[i - 1].width += segments_[i].width;
+            segments_.erase(segments_.begin() + i);
+        }
+        return x;
+    }
+
+private:
+    struct Segment {
+        int x, y, width;
+    };
+    int width_;
+    std::vector<Segment> segments_;
+};
+
+// 按给定密度放置所有图块，返回图集高度；position为每个图块的(x, y)纹素位置
+int packRects(const std::vector<ChartFrame>& frames, const std::vector<unsigned int>& order, double density,
+              int padding, bool allowRotation, int width, std::vector<int>& position,
+              std::vector<unsigned char>& rotated)
+{
+    Skyline skyline(width);
+    int height = 0;
+    for (unsigned int c : order) {
+        const int w = static_cast<int>(std::ceil(frames[c].width * density)) + padding;
+        const int h = static_cast<int>(std::ceil(frames[c].height * density)) + padding;
+        size_t segment = 0, turnedSegment = 0;
+        int y = 0, turnedY = 0;
+        const bool upright = skyline.find(w, h, segment, y);
+        const bool turned = allowRotation && w != h && skyline.find(h, w, turnedSegment, turnedY);
+        if (!upright && !turned) return std::numeric_limits<int>::max();
+        const bool turn = turned && (!upright || turnedY + w < y + h);
+        if (turn) {
+            segment = turnedSegment;
+            y = turnedY;
+        }
+        const int placedWidth = turn ? h : w, placedHeight = turn ? w : h;
+        rotated[c] = turn;
+        position[2 * c] = skyline.place(segment, placedWidth, y + placedHeight);
+        position[2 * c + 1] = y;
+        height = std::max(height, y + placedHeight);
+    }
+    return height;
+}
+
+} // namespace
+
+bool packAtlas(const std::vector<unsigned int>& chartBegin, const std::vector<double>& uv,
+               const AtlasPackOptions& options, std::vector<float>& texCoords, AtlasPackResult* result)
+{
+    if (chartBegin.size() < 2 || uv.size() < 2 * static_cast<size_t>(chartBegin.back())) {
+        std::cerr << "Atlas packing requires at least one chart with uv" << std::endl;
+        return false;
+    }
+    const size_t charts = chartBegin.size() - 1;
+    const long long chartCount = static_cast<long long>(charts);
+
+    // 各图块的最小包围矩形互不相关；凸包大小差异大，采用动态调度
+    std::vector<ChartFrame> frames(charts);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long c = 0; c < chartCount; ++c) {
+        const size_t count = chartBegin[c + 1] - chartBegin[c];
+        if (count > 0) fitFrame(&uv[2 * chartBegin[c]], count, frames[c]);
+    }
+
+    // 允许旋转时先统一为横向，再按高、宽降序放置；widest为图块横跨图集至少需要的宽度
+    double area = 0.0, widest = 0.0;
+    for (ChartFrame& frame : frames) {
+        if (options.allowRotation && frame.height > frame.width) {
+            // 旋转-90度：(x, y) -> (y, -x)
+            const double c = frame.c, s = frame.s;
+            frame.c = -s;
+            frame.s = c;
+            const double minX = frame.minY;
+            frame.minY = -(frame.minX + frame.width);
+            frame.minX = minX;
+            std::swap(frame.width, frame.height);
+        }
+        area += frame.width * frame.height;
+        widest = std::max(widest, options.allowRotation ? frame.height : frame.width);
+    }
+    std::vector<unsigned int> order(charts);
+    for (size_t c = 0; c < charts; ++c) order[c] = static_cast<unsigned int>(c);
+    std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+        if (frames[a].height != frames[b].height) return frames[a].height > frames[b].height;
+        return frames[a].width > frames[b].width;
+    });
+
+    const int padding = std::max(options.padding, 0);
+    std::vector<int> position(2 * charts);
+    std::vector<unsigned char> rotated(charts);
+    double density = options.texelsPerUnit;
+    int width = 0, height = 0;
+    if (density > 0.0) {
+        // 固定密度：宽度取总面积的平方根，高度按需增长
+        double rects = 0.0;
+        for (const ChartFrame& frame : frames) {
+            rects += (frame.width * density + padding + 1) * (frame.height * density + padding + 1);
+        }
+        width = std::max(static_cast<int>(std::ceil(std::sqrt(rects))),
+                         static_cast<int>(std::ceil(widest * density)) + padding + 1);
+        height = packRects(frames, order, density, padding, options.allowRotation, width, position, rotated);
+    } else {
+        // 自动密度：从面积估计出发，放不下resolution时按高度超出的比例缩小后重排
+        width = std::max(options.resolution, padding + 2);
+        const double usable = std::max(1.0, static_cast<double>(width - padding));
+        density = area > 0.0 ? 0.9 * usable / std::sqrt(area) : 1.0;
+        if (widest > 0.0) density = std::min(density, (usable - 1.0) / widest);
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            height = packRects(frames, order, density, padding, options.allowRotation, width, position, rotated);
+            if (height <= width) break;
+            const double shrink = height == std::numeric_limits<int>::max()
+                                      ? 0.5 : std::sqrt(static_cast<double>(width) / height);
+            density *= std::min(0.98, shrink);
+        }
+    }
+    if (height == std::numeric_limits<int>::max()) {
+        std::cerr << "Atlas packing failed: a chart is wider than the atlas" << std::endl;
+        return false;
+    }
+    // 自动密度下图集不得超过resolution；缩小到极限仍放不下（图块数乘间隔已超过面积）时失败
+    if (options.texelsPerUnit <= 0.0f && height > width) {
+        std::cerr << "Atlas packing failed: " << charts << " charts do not fit a "
+                  << width << "x" << width << " atlas" << std::endl;
+        return false;
+    }
+    height = std::max(height, 1);
+
+    // 写出归一化纹理坐标：图块内坐标按密度缩放，旋转90度时(x, y) -> (h - y, x)，再平移到放置位置
+    const size_t nv = chartBegin.back();
+    texCoords.assign(2 * nv, 0.0f);
+    const double inset = 0.5 * padding;
+    size_t turned = 0;
+    double used = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+ : turned, used)
+    for (long long c = 0; c < chartCount; ++c) {
+        const ChartFrame& frame = frames[c];
+        const double h = frame.height * density;
+        turned += rotated[c];
+        used += (frame.width * density + padding) * (h + padding);
+        for (unsigned int v = chartBegin[c]; v < chartBegin[c + 1]; ++v) {
+            const double x = (frame.c * uv[2 * v] + frame.s * uv[2 * v + 1] - frame.minX) * density;
+            const double y = (-frame.s * uv[2 * v] + frame.c * uv[2 * v + 1] - frame.minY) * density;
+            const double u = rotated[c] ? h - y : x;
+            const double w = rotated[c] ? x : y;
+            texCoords[2 * v] = static_cast<float>((position[2 * c] + inset + u) / width);
+            texCoords[2 * v + 1] = static_cast<float>((position[2 * c + 1] + inset + w) / height);
+        }
+    }
+
+    if (result) {
+        result->width = width;
+        result->height = height;
+        result->texelsPerUnit = static_cast<float>(density);
+        result->fill = static_cast<float>(used / (static_cast<double>(width) * height));
+        result->rotated = turned;
+    }
+    return true;
+}
+
+} // namespace meshcore
@@ -0,0 +1,43 @@
+#ifndef MESHCORE_ATLAS_PACKER_H
+#define MESHCORE_ATLAS_PACKER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace meshcore {
+
+// Layout of the packed atlas (图集排布参数)
+struct AtlasPackOptions {
+    float texelsPerUnit = 0.0f;   // Target texel density in texels per model unit, 0 = largest that fits resolution (目标纹素密度，每模型单位的纹素数，0为适配resolution的最大密度)
+    int resolution = 1024;        // Atlas side in texels when the density is chosen automatically (自动选择密度时的图集边长，纹素)
+    int padding = 2;              // Texels between charts (图块间的纹素间隔)
+    bool allowRotation = true;    // Try each chart turned by 90 degrees as well (同时尝试将图块旋转90度)
+};
+
+// What the packer produced (打包结果)
+struct AtlasPackResult {
+    int width = 0;                // Atlas size in texels (图集尺寸，纹素)
+    int height = 0;
+    float texelsPerUnit = 0.0f;   // Density actually used (实际使用的纹素密度)
+    float fill = 0.0f;            // Chart rectangles / atlas area (图块矩形面积占图集面积的比例)
+    size_t rotated = 0;           // Charts placed turned by 90 degrees (旋转90度放置的图块数)
+};
+
+// Pack charts into one texture atlas. Chart c owns the vertices [chartBegin[c], chartBegin[c+1])
+// and uv holds 2 values per vertex in model units. Each chart is first turned to its minimum-area
+// bounding rectangle (rotating calipers over the convex hull of its uv), scaled to the texel
+// density, and the rectangles are then placed by a bottom-left skyline packer that tries both
+// orientations. texCoords receives u,v per vertex normalized by the atlas size, the layout the
+// texture coordinate buffer takes as is. With automatic density, returns false when the charts
+// do not fit resolution even at the smallest density the packer tries.
+// 将图块打包到一张纹理图集。图块c拥有顶点[chartBegin[c], chartBegin[c+1])，uv每个顶点2个值，
+// 单位为模型单位。每个图块先旋转到面积最小的包围矩形（对uv凸包使用旋转卡壳），按纹素密度缩放，
+// 再由左下优先的天际线算法放置矩形，两种朝向都会尝试。texCoords为按图集尺寸归一化的每顶点u,v，
+// 可直接作为纹理坐标缓冲区的数据。自动密度下，缩小到尝试的最小密度仍放不下resolution时返回false
+bool packAtlas(const std::vector<unsigned int>& chartBegin, const std::vector<double>& uv,
+               const AtlasPackOptions& options, std::vector<float>& texCoords,
+               AtlasPackResult* result = nullptr);
+
+} // namespace meshcore
+
+#endif // MESHCORE_ATLAS_PACKER_H
@@ -0,0 +1,417 @@
+#include "attribute_simplification.h"
+#include "dirty_region.h"
+#include "qem_common.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace meshcore {
+
+namespace {
+
+const int kDim = 8;                     // x y z u v nx ny nz
+const double kTexCoordWeight = 1.0;     // 纹理坐标相对位置（按包围盒对角线归一化）的权重
+const double kNormalWeight = 0.1;       // 法线分量的权重
+const double kFeatureCos = 0.5;         // 相邻面法线夹角超过60°的边为折痕接缝
+const double kMinRcond = 1e-9;          // 最优位置求解的条件数倒数下限，低于它改在候选点中选
+const size_t kMinVertices = 4;
+
+typedef Eigen::Matrix<double, kDim, 1> Vector;
+typedef Eigen::Matrix<double, kDim, kDim> Matrix;
+
+inline int packed(int i, int j)
+{
+    if (i > j) std::swap(i, j);
+    return i * kDim - i * (i - 1) / 2 + (j - i);
+}
+
+// 8维二次误差 v^T A v + 2 b^T v + c；对称矩阵A只存上三角36项
+struct Quadric {
+    double a[kDim * (kDim + 1) / 2] = {};
+    double b[kDim] = {};
+    double c = 0.0;
+
+    Quadric& operator+=(const Quadric& o)
+    {
+        for (int k = 0; k < kDim * (kDim + 1) / 2; ++k) a[k] += o.a[k];
+        for (int k = 0; k < kDim; ++k) b[k] += o.b[k];
+        c += o.c;
+        return *this;
+    }
+    Matrix matrix() const
+    {
+        Matrix m;
+        for (int i = 0; i < kDim; ++i)
+            for (int j = 0; j < kDim; ++j) m(i, j) = a[packed(i, j)];
+        return m;
+    }
+    double evaluate(const Vector& v) const
+    {
+        double value = c;
+        for (int i = 0; i < kDim; ++i) {
+            value += 2.0 * b[i] * v[i] + a[packed(i, i)] * v[i] * v[i];
+            for (int j = i + 1; j < kDim; ++j) value += 2.0 * a[packed(i, j)] * v[i] * v[j];
+        }
+        return value;
+    }
+
+    // 三点张成的8维平面：A = I - e1e1^T - e2e2^T，b = (p·e1)e1 + (p·e2)e2 - p，
+    // c = p·p - (p·e1)^2 - (p·e2)^2（Garland-Heckbert 1998）
+    void addTriangle(const Vector& p, const Vector& q, const Vector& r, double weight)
+    {
+        Vector e1 = q - p;
+        const double l1 = e1.norm();
+        if (l1 <= 0.0) return;
+        e1 /= l1;
+        Vector e2 = r - p;
+        e2 -= e1.dot(e2) * e1;
+        const double l2 = e2.norm();
+        if (l2 <= 0.0) return;
+        e2 /= l2;
+        const double pe1 = p.dot(e1), pe2 = p.dot(e2);
+        for (int i = 0; i < kDim; ++i) {
+            for (int j = i; j < kDim; ++j) {
+                a[packed(i, j)] += weight * ((i == j ? 1.0 : 0.0) - e1[i] * e1[j] - e2[i] * e2[j]);
+            }
+            b[i] += weight * (pe1 * e1[i] + pe2 * e2[i] - p[i]);
+        }
+        c += weight * (p.dot(p) - pe1 * pe1 - pe2 * pe2);
+    }
+
+    // 只约束位置的三维平面 n·x + d = 0
+    void addPlane(const Eigen::Vector3d& n, double d, double weight)
+    {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = i; j < 3; ++j) a[packed(i, j)] += weight * n[i] * n[j];
+            b[i] += weight * d * n[i];
+        }
+        c += weight * d * d;
+    }
+};
+
+// 一次折叠：沿halfedge把from顶点并到to顶点，to顶点取target；symmetric为真时方向可反转
+struct CollapsePlan {
+    Mesh::HalfedgeHandle halfedge;
+    Vector target;
+    double cost = 0.0;
+    bool symmetric = false;
+};
+
+struct Candidate {
+    double cost;
+    unsigned int edge;
+    unsigned int stamp;
+    bool operator>(const Candidate& o) const { return cost > o.cost; }
+};
+
+class AttributeSimplifier {
+public:
+    explicit AttributeSimplifier(Mesh& mesh) : mesh_(mesh) {}
+
+    bool run(float ratio);
+
+private:
+    Eigen::Vector3d position(const Vector& v) const { return origin_ + scale_ * v.head<3>(); }
+    Eigen::Vector3d scaledPoint(Mesh::VertexHandle v) const { return attributes_[v.idx()].head<3>(); }
+    void initializeAttributes();
+    void initializeQuadrics();
+    void initializeSeams();
+    int seamDegree(Mesh::VertexHandle v) const;
+    bool plan(Mesh::EdgeHandle e, CollapsePlan& out) const;
+    bool flips(Mesh::HalfedgeHandle h, const Eigen::Vector3d& target) const;
+    void collapse(const CollapsePlan& plan);
+    void push(Mesh::EdgeHandle e);
+
+    Mesh& mesh_;
+    bool hasTexCoords_ = false;
+    Eigen::Vector3d origin_;
+    double scale_ = 1.0;
+    std::vector<Vector> attributes_;        // 每个顶点的8维坐标（位置已归一化）
+    std::vector<Quadric> quadrics_;
+    std::vector<unsigned char> seam_;       // 每条边是否为接缝
+    std::vector<unsigned int> stamps_;      // 边的版本号，堆中旧版本的条目被跳过
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> heap_;
+};
+
+// 位置平移缩放到单位包围盒对角线，使纹理坐标与位置的误差可以相加
+void AttributeSimplifier::initializeAttributes()
+{
+    Eigen::Vector3d lo = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+    Eigen::Vector3d hi = -lo;
+    for (auto vh : mesh_.vertices()) {
+        const Mesh::Point& p = mesh_.point(vh);
+        const Eigen::Vector3d q(p[0], p[1], p[2]);
+        lo = lo.cwiseMin(q);
+        hi = hi.cwiseMax(q);
+    }
+    origin_ = lo;
+    scale_ = std::max((hi - lo).norm(), 1e-12);
+
+    attributes_.assign(mesh_.n_vertices(), Vector::Zero());
+    for (auto vh : mesh_.vertices()) {
+        Vector& a = attributes_[vh.idx()];
+        const Mesh::Point& p = mesh_.point(vh);
+        for (int k = 0; k < 3; ++k) a[k] = (p[k] - origin_[k]) / scale_;
+        if (hasTexCoords_) {
+            const Mesh::TexCoord2D& t = mesh_.texcoord2D(vh);
+            a[3] = kTexCoordWeight * t[0];
+            a[4] = kTexCoordWeight * t[1];
+        }
+        const Mesh::Normal& n = mesh_.normal(vh);
+        for (int k = 0; k < 3; ++k) a[5 + k] = kNormalWeight * n[k];
+    }
+}
+
+// 面二次误差按面积加权；边界边另加过该边且垂直于面的约束平面。每个顶点只写自己的二次误差
+void AttributeSimplifier::initializeQuadrics()
+{
+    quadrics_.assign(mesh_.n_vertices(), Quadric());
+    const long long nv = static_cast<long long>(mesh_.n_vertices());
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long i = 0; i < nv; ++i) {
+        const Mesh::VertexHandle vh(static_cast<int>(i));
+        Quadric& q = quadrics_[i];
+        for (auto fh : mesh_.vf_range(vh)) {
+            Mesh::VertexHandle corners[3];
+            int k = 0;
+            for (auto fv : mesh_.fv_range(fh)) corners[k++] = fv;
+            const Eigen::Vector3d p0 = scaledPoint(corners[0]);
+            const double area = 0.5 * (scaledPoint(corners[1]) - p0).cross(scaledPoint(corners[2]) - p0).norm();
+            q.addTriangle(attributes_[corners[0].idx()], attributes_[corners[1].idx()],
+                          attributes_[corners[2].idx()], area);
+        }
+        for (auto heh : mesh_.voh_range(vh)) {
+            if (!mesh_.is_boundary(mesh_.edge_handle(heh))) continue;
+            const Mesh::FaceHandle fh = mesh_.is_boundary(heh) ? mesh_.face_handle(mesh_.opposite_halfedge_handle(heh))
+                                                               : mesh_.face_handle(heh);
+            const Mesh::Normal& fn = mesh_.normal(fh);
+            const Eigen::Vector3d n(fn[0], fn[1], fn[2]);
+            const Eigen::Vector3d from = scaledPoint(vh);
+            const Eigen::Vector3d to = scaledPoint(mesh_.to_vertex_handle(heh));
+            double plane[4], weight;
+            if (!qem::boundaryPlane(from.data(), to.data(), n.data(), plane, weight)) continue;
+            q.addPlane(Eigen::Vector3d(plane[0], plane[1], plane[2]), plane[3], weight);
+        }
+    }
+}
+
+// 边界边与两侧面法线夹角过大的折痕边为接缝
+void AttributeSimplifier::initializeSeams()
+{
+    seam_.assign(mesh_.n_edges(), 0);
+    for (auto eh : mesh_.edges()) {
+        if (mesh_.is_boundary(eh)) {
+            seam_[eh.idx()] = 1;
+            continue;
+        }
+        const Mesh::Normal& n0 = mesh_.normal(mesh_.face_handle(mesh_.halfedge_handle(eh, 0)));
+        const Mesh::Normal& n1 = mesh_.normal(mesh_.face_handle(mesh_.halfedge_handle(eh, 1)));
+        seam_[eh.idx()] = (n0 | n1) < kFeatureCos;
+    }
+}
+
+int AttributeSimplifier::seamDegree(Mesh::VertexHandle v) const
+{
+    int degree = 0;
+    for (auto eh : mesh_.ve_range(v)) degree += seam_[eh.idx()];
+    return degree;
+}
+
+// 两端都不在接缝上时取8维最优点；一端在接缝上时并到该端且它保持不动；
+// 两端都在接缝上时只能沿接缝边把接缝度为2的一端并到另一端，接缝拐角与分叉点不删除
+bool AttributeSimplifier::plan(Mesh::EdgeHandle e, CollapsePlan& out) const
+{
+    const Mesh::HalfedgeHandle h0 = mesh_.halfedge_handle(e, 0);
+    const Mesh::VertexHandle a = mesh_.from_vertex_handle(h0), b = mesh_.to_vertex_handle(h0);
+    const int da = seamDegree(a), db = seamDegree(b);
+    Quadric q = quadrics_[a.idx()];
+    q += quadrics_[b.idx()];
+    out.symmetric = false;
+
+    if (da == 0 && db == 0) {
+        out.halfedge = h0;
+        out.symmetric = true;
+        const Vector& va = attributes_[a.idx()];
+        const Vector& vb = attributes_[b.idx()];
+        const Vector mid = 0.5 * (va + vb);
+        bool solved = false;
+        Eigen::LDLT<Matrix> ldlt(q.matrix());
+        if (ldlt.info() == Eigen::Success && ldlt.rcond() > kMinRcond) {
+            Vector rhs;
+            for (int k = 0; k < kDim; ++k) rhs[k] = -q.b[k];
+            out.target = ldlt.solve(rhs);
+            // 离边中点过远的解通常来自近奇异的二次误差，不采用
+            solved = (out.target.head<3>() - mid.head<3>()).squaredNorm() <= (vb.head<3>() - va.head<3>()).squaredNorm();
+        }
+        if (!solved) {
+            const Vector* options[3] = {&va, &vb, &mid};
+            double best = std::numeric_limits<double>::max();
+            for (const Vector* option : options) {
+                const double cost = q.evaluate(*option);
+                if (cost < best) {
+                    best = cost;
+                    out.target = *option;
+                }
+            }
+        }
+    } else if (da > 0 && db == 0) {
+        out.halfedge = mesh_.opposite_halfedge_handle(h0);
+        out.target = attributes_[a.idx()];
+    } else if (da == 0 && db > 0) {
+        out.halfedge = h0;
+        out.target = attributes_[b.idx()];
+    } else {
+        if (!seam_[e.idx()]) return false;
+        if (db == 2) {
+            out.halfedge = mesh_.opposite_halfedge_handle(h0);
+            out.target = attributes_[a.idx()];
+        } else if (da == 2) {
+            out.halfedge = h0;
+            out.target = attributes_[b.idx()];
+        } else {
+            return false;
+        }
+    }
+    out.cost = std::max(0.0, q.evaluate(out.target));
+    return true;
+}
+
+// 不含被折叠边的面在端点移到新位置后不得翻转或退化
+bool AttributeSimplifier::flips(Mesh::HalfedgeHandle h, const Eigen::Vector3d& target) const
+{
+    const Mesh::VertexHandle ends[2] = {mesh_.from_vertex_handle(h), mesh_.to_vertex_handle(h)};
+    const Mesh::FaceHandle skip0 = mesh_.face_handle(h);
+    const Mesh::FaceHandle skip1 = mesh_.face_handle(mesh_.opposite_halfedge_handle(h));
+    for (const Mesh::VertexHandle v : ends) {
+        for (auto fh : mesh_.vf_range(v)) {
+            if (fh == skip0 || fh == skip1) continue;
+            Eigen::Vector3d before[3], after[3];
+            int k = 0;
+            for (auto fv : mesh_.fv_range(fh)) {
+                before[k] = scaledPoint(fv);
+                after[k] = (fv == ends[0] || fv == ends[1]) ? target : before[k];
+                ++k;
+            }
+            double n0[3], n1[3];
+            qem::triangleNormal(before[0].data(), before[1].data(), before[2].data(), n0);
+            qem::triangleNormal(after[0].data(), after[1].data(), after[2].data(), n1);
+            if (qem::foldsOver(n0, n1)) return true;
+        }
+    }
+    return false;
+}
+
+void AttributeSimplifier::push(Mesh::EdgeHandle e)
+{
+    const unsigned int stamp = ++stamps_[e.idx()];
+    CollapsePlan p;
+    if (plan(e, p)) heap_.push({p.cost, static_cast<unsigned int>(e.idx()), stamp});
+}
+
+void AttributeSimplifier::collapse(const CollapsePlan& plan)
+{
+    const Mesh::HalfedgeHandle h = plan.halfedge;
+    const Mesh::VertexHandle removed = mesh_.from_vertex_handle(h), kept = mesh_.to_vertex_handle(h);
+
+    // 两个被删除的面各把两条边合为一条，合并后的边继承接缝标记
+    Mesh::VertexHandle apex[2];
+    bool apexSeam[2] = {false, false};
+    const Mesh::HalfedgeHandle sides[2] = {h, mesh_.opposite_halfedge_handle(h)};
+    for (int s = 0; s < 2; ++s) {
+        if (mesh_.is_boundary(sides[s])) continue;
+        apex[s] = mesh_.to_vertex_handle(mesh_.next_halfedge_handle(sides[s]));
+        for (const Mesh::VertexHandle end : {removed, kept}) {
+            const Mesh::HalfedgeHandle he = mesh_.find_halfedge(end, apex[s]);
+            if (he.is_valid()) apexSeam[s] = apexSeam[s] || seam_[mesh_.edge_handle(he).idx()];
+        }
+    }
+
+    mesh_.collapse(h);
+    for (int s = 0; s < 2; ++s) {
+        if (!apex[s].is_valid()) continue;
+        const Mesh::HalfedgeHandle he = mesh_.find_halfedge(kept, apex[s]);
+        if (he.is_valid()) seam_[mesh_.edge_handle(he).idx()] = apexSeam[s];
+    }
+
+    attributes_[kept.idx()] = plan.target;
+    quadrics_[kept.idx()] += quadrics_[removed.idx()];
+    const Eigen::Vector3d p = position(plan.target);
+    mesh_.set_point(kept, Mesh::Point(static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2])));
+    if (hasTexCoords_) {
+        mesh_.set_texcoord2D(kept, Mesh::TexCoord2D(static_cast<float>(plan.target[3] / kTexCoordWeight),
+                                                    static_cast<float>(plan.target[4] / kTexCoordWeight)));
+    }
+    for (auto eh : mesh_.ve_range(kept)) push(eh);
+}
+
+bool AttributeSimplifier::run(float ratio)
+{
+    if (mesh_.n_vertices() == 0 || mesh_.n_faces() == 0) return false;
+    mesh_.request_edge_status();
+    mesh_.update_normals();
+    hasTexCoords_ = mesh_.has_vertex_texcoords2D();
+    initializeAttributes();
+    initializeQuadrics();
+    initializeSeams();
+
+    // 初始代价并行计算，再串行入堆
+    const long long ne = static_cast<long long>(mesh_.n_edges());
+    std::vector<double> costs(ne);
+    std::vector<unsigned char> valid(ne);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long i = 0; i < ne; ++i) {
+        CollapsePlan p;
+        valid[i] = plan(Mesh::EdgeHandle(static_cast<int>(i)), p);
+        costs[i] = p.cost;
+    }
+    stamps_.assign(ne, 0);
+    for (long long i = 0; i < ne; ++i) {
+        if (valid[i]) heap_.push({costs[i], static_cast<unsigned int>(i), 0});
+    }
+
+    size_t alive = mesh_.n_vertices();
+    const size_t target = std::max(kMinVertices, static_cast<size_t>(alive * (1.0f - std::min(std::max(ratio, 0.0f), 1.0f))));
+    while (alive > target && !heap_.empty()) {
+        const Candidate top = heap_.top();
+        heap_.pop();
+        const Mesh::EdgeHandle eh(static_cast<int>(top.edge));
+        if (mesh_.status(eh).deleted() || top.stamp != stamps_[top.edge]) continue;
+
+        // 邻近折叠可能改变了端点的接缝度，重新规划；代价变高则按新代价放回
+        CollapsePlan p;
+        if (!plan(eh, p)) continue;
+        if (p.cost > top.cost) {
+            heap_.push({p.cost, top.edge, top.stamp});
+            continue;
+        }
+        const Eigen::Vector3d target3 = p.target.head<3>();
+        if (!mesh_.is_collapse_ok(p.halfedge) || flips(p.halfedge, target3)) {
+            if (!p.symmetric) continue;
+            p.halfedge = mesh_.opposite_halfedge_handle(p.halfedge);
+            if (!mesh_.is_collapse_ok(p.halfedge) || flips(p.halfedge, target3)) continue;
+        }
+        collapse(p);
+        --alive;
+    }
+
+    mesh_.garbage_collection();
+    mesh_.release_edge_status();
+    mesh_.update_normals();
+    markAllDirty(mesh_);
+    return true;
+}
+
+} // namespace
+
+bool simplifyMeshWithAttributes(Mesh& mesh, float ratio)
+{
+    AttributeSimplifier simplifier(mesh);
+    return simplifier.run(ratio);
+}
+
+} // namespace meshcore
@@ -0,0 +1,25 @@
+#ifndef MESHCORE_ATTRIBUTE_SIMPLIFICATION_H
+#define MESHCORE_ATTRIBUTE_SIMPLIFICATION_H
+
+#include "mesh_types.h"
+
+namespace meshcore {
+
+// QEM decimation over position, texcoord and normal (Garland-Heckbert 1998): each vertex is a
+// point in 8D and each face contributes the quadric of its plane in that space, so a collapse
+// pays for distorting the texture and the shading as well as the shape. The merged vertex
+// takes the optimal position and texcoord. Seams are locked: boundary edges (the chart
+// boundary of a parameterization) and creases sharper than the feature angle keep their
+// vertices in place; a seam vertex is only removed along the seam, onto its neighbour there.
+// Texcoords are read from and written back to the vertex texcoord property when it exists.
+// Removes `ratio` (0-1) of the vertices like simplifyMesh.
+// 位置、纹理坐标与法线上的QEM简化（Garland-Heckbert 1998）：每个顶点是8维空间中的点，
+// 每个面贡献它在该空间中所在平面的二次误差，因此折叠既为形状失真也为纹理与明暗失真付出代价。
+// 合并后的顶点取最优位置与纹理坐标。接缝锁定：边界边（参数化的图块边界）与比特征角更尖的折痕
+// 保持顶点不动；接缝顶点只能沿接缝并到相邻的接缝顶点上。
+// 存在顶点纹理坐标属性时从中读取并写回。与simplifyMesh一样删除ratio比例(0-1)的顶点
+bool simplifyMeshWithAttributes(Mesh& mesh, float ratio);
+
+} // namespace meshcore
+
+#endif // MESHCORE_ATTRIBUTE_SIMPLIFICATION_H
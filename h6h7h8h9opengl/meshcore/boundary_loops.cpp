@@ -0,0 +1,30 @@
+#include "boundary_loops.h"
+#include <algorithm>
+
+namespace meshcore {
+
+std::vector<BoundaryLoop> findBoundaryLoops(const Mesh& mesh)
+{
+    std::vector<BoundaryLoop> loops;
+    std::vector<unsigned char> visited(mesh.n_halfedges(), 0);
+    for (auto heh : mesh.halfedges()) {
+        if (visited[heh.idx()] || !mesh.is_boundary(heh)) continue;
+
+        // 边界半边的next仍是同一个洞上的边界半边，绕一圈回到起点
+        BoundaryLoop loop;
+        Mesh::HalfedgeHandle h = heh;
+        do {
+            visited[h.idx()] = 1;
+            loop.vertices.push_back(mesh.from_vertex_handle(h));
+            loop.length += (mesh.point(mesh.to_vertex_handle(h)) - mesh.point(mesh.from_vertex_handle(h))).norm();
+            h = mesh.next_halfedge_handle(h);
+        } while (h != heh && !visited[h.idx()]);
+        loops.push_back(std::move(loop));
+    }
+    std::stable_sort(loops.begin(), loops.end(), [](const BoundaryLoop& a, const BoundaryLoop& b) {
+        return a.length > b.length;
+    });
+    return loops;
+}
+
+} // namespace meshcore
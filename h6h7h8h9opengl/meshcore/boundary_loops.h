@@ -0,0 +1,24 @@
+#ifndef MESHCORE_BOUNDARY_LOOPS_H
+#define MESHCORE_BOUNDARY_LOOPS_H
+
+#include "mesh_types.h"
+#include <vector>
+
+namespace meshcore {
+
+// One closed boundary curve (一条闭合边界曲线)
+struct BoundaryLoop {
+    std::vector<Mesh::VertexHandle> vertices;   // In half-edge order; the last connects back to the first (按半边顺序，首尾相连)
+    float length = 0.0f;                         // Sum of its edge lengths (边长之和)
+};
+
+// All boundary loops, longest first. Each loop is traced by following next_halfedge_handle
+// along its boundary half-edges, so the cost is linear in the total boundary length, and a
+// vertex where several loops meet is visited once per loop rather than being ambiguous.
+// 全部边界环，按长度从长到短排列。沿边界半边的next_halfedge_handle追踪每个环，代价与边界总长
+// 成线性；多个环相交的顶点在每个环中各出现一次，不会产生歧义
+std::vector<BoundaryLoop> findBoundaryLoops(const Mesh& mesh);
+
+} // namespace meshcore
+
+#endif // MESHCORE_BOUNDARY_LOOPS_H
@@ -0,0 +1,306 @@
+#include "chart_atlas.h"
+#include "conformal_parameterization.h"
+#include "mesh_io.h"
+#include "meshcore_internal.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace meshcore {
+
+namespace {
+
+const unsigned int kNone = std::numeric_limits<unsigned int>::max();
+
+// 角c所在边(c, c+1)对面的三角形，边界边为kNone（要求三角形朝向一致）
+void buildFaceNeighbors(const FlatMesh& mesh, std::vector<unsigned int>& neighbors)
+{
+    VertexCorners adjacency;
+    adjacency.build(mesh);
+    const unsigned int* tri = mesh.triangles.data();
+    const long long corners = static_cast<long long>(mesh.triangles.size());
+    neighbors.assign(corners, kNone);
+
+    #pragma omp parallel for schedule(static)
+    for (long long h = 0; h < corners; ++h) {
+        const unsigned int a = tri[h], b = tri[nextCorner(static_cast<unsigned int>(h))];
+        for (unsigned int i = adjacency.begin(b); i < adjacency.end(b); ++i) {
+            const unsigned int c = adjacency.corners[i];
+            if (tri[nextCorner(c)] == a) {
+                neighbors[h] = c / 3;
+                break;
+            }
+        }
+    }
+}
+
+// 面法线（单位）与面积
+void computeFaceFrames(const FlatMesh& mesh, std::vector<float>& normals, std::vector<float>& areas)
+{
+    const long long nf = static_cast<long long>(mesh.triangleCount());
+    const float* p = mesh.positions.data();
+    const unsigned int* tri = mesh.triangles.data();
+    normals.resize(3 * nf);
+    areas.resize(nf);
+
+    #pragma omp parallel for schedule(static)
+    for (long long f = 0; f < nf; ++f) {
+        const float* a = p + 3 * tri[3 * f];
+        const float* b = p + 3 * tri[3 * f + 1];
+        const float* c = p + 3 * tri[3 * f + 2];
+        const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        areas[f] = 0.5f * length;
+        for (int k = 0; k < 3; ++k) normals[3 * f + k] = length > 0.0f ? n[k] / length : 0.0f;
+    }
+}
+
+// 沿平均法线所在平面的正交投影，LSCM失败时的退路
+void projectToPlane(const FlatMesh& chart, const float normal[3], std::vector<double>& uv)
+{
+    const double n[3] = {normal[0], normal[1], normal[2]};
+    const int axis = std::fabs(n[0]) < 0.6 ? 0 : (std::fabs(n[1]) < 0.6 ? 1 : 2);
+    double t[3] = {0.0, 0.0, 0.0};
+    t[axis] = 1.0;
+    const double d = t[0] * n[0] + t[1] * n[1] + t[2] * n[2];
+    for (int k = 0; k < 3; ++k) t[k] -= d * n[k];
+    const double length = std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+    for (int k = 0; k < 3; ++k) t[k] /= length;
+    const double s[3] = {n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2], n[0] * t[1] - n[1] * t[0]};
+
+    const size_t nv = chart.vertexCount();
+    uv.resize(2 * nv);
+    for (size_t v = 0; v < nv; ++v) {
+        const float* q = &chart.positions[3 * v];
+        uv[2 * v] = t[0] * q[0] + t[1] * q[1] + t[2] * q[2];
+        uv[2 * v + 1] = s[0] * q[0] + s[1] * q[1] + s[2] * q[2];
+    }
+}
+
+// 以LSCM展开一个图块：固定按三维距离相距最远的一对顶点（两次最远点搜索近似）
+void flattenChart(const FlatMesh& chart, const float normal[3], std::vector<double>& uv)
+{
+    const size_t nv = chart.vertexCount();
+    const float* p = chart.positions.data();
+    auto farthest = [&](unsigned int from) {
+        unsigned int best = from;
+        float bestDistance = -1.0f;
+        for (unsigned int v = 0; v < nv; ++v) {
+            const float dx = p[3 * v] - p[3 * from], dy = p[3 * v + 1] - p[3 * from + 1], dz = p[3 * v + 2] - p[3 * from + 2];
+            const float d = dx * dx + dy * dy + dz * dz;
+            if (d > bestDistance) {
+                bestDistance = d;
+                best = v;
+            }
+        }
+        return std::make_pair(best, bestDistance);
+    };
+    const unsigned int first = farthest(0).first;
+    const std::pair<unsigned int, float> second = farthest(first);
+    const unsigned int pins[2] = {first, second.first};
+    const double pinValues[2][2] = {{0.0, 0.0}, {std::sqrt(static_cast<double>(second.second)), 0.0}};
+
+    ConformalSolverCache solver;
+    if (pins[0] == pins[1] || !solver.solve(chart, pins, pinValues, uv)) {
+        projectToPlane(chart, normal, uv);
+    }
+
+    // 保证与三维面片同向：有向面积为负时镜像v
+    double area = 0.0;
+    const unsigned int* tri = chart.triangles.data();
+    for (size_t c = 0; c < chart.triangles.size(); c += 3) {
+        const double* a = &uv[2 * tri[c]];
+        const double* b = &uv[2 * tri[c + 1]];
+        const double* d = &uv[2 * tri[c + 2]];
+        area += (b[0] - a[0]) * (d[1] - a[1]) - (b[1] - a[1]) * (d[0] - a[0]);
+    }
+    if (area < 0.0) {
+        for (size_t v = 0; v < nv; ++v) uv[2 * v + 1] = -uv[2 * v + 1];
+    }
+}
+
+} // namespace
+
+size_t segmentCharts(const FlatMesh& mesh, const ChartAtlasOptions& options, std::vector<unsigned int>& faceChart)
+{
+    const size_t nf = mesh.triangleCount();
+    const unsigned int* tri = mesh.triangles.data();
+    faceChart.assign(nf, kNone);
+    if (nf == 0) return 0;
+
+    std::vector<unsigned int> neighbors;
+    buildFaceNeighbors(mesh, neighbors);
+    std::vector<float> normals, areas;
+    computeFaceFrames(mesh, normals, areas);
+
+    const float minCosine = std::cos(options.maxNormalAngle * 3.14159265358979f / 180.0f);
+    const size_t maxFaces = options.maxChartFaces > 0 ? options.maxChartFaces : nf;
+    std::vector<unsigned int> vertexChart(mesh.vertexCount(), kNone);   // 顶点当前所属的图块（只需区分是否属于正在生长的图块）
+    typedef std::pair<float, unsigned int> Candidate;                   // (1 - cos, 面)
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+
+    unsigned int chart = 0;
+    for (size_t seed = 0; seed < nf; ++seed) {
+        if (faceChart[seed] != kNone) continue;
+        float sum[3] = {0.0f, 0.0f, 0.0f};
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        size_t faces = 0;
+
+        auto add = [&](unsigned int f) {
+            faceChart[f] = chart;
+            ++faces;
+            for (int k = 0; k < 3; ++k) {
+                vertexChart[tri[3 * f + k]] = chart;
+                sum[k] += areas[f] * normals[3 * f + k];
+            }
+            const float length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+            for (int k = 0; k < 3; ++k) mean[k] = length > 0.0f ? sum[k] / length : normals[3 * f + k];
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int g = neighbors[3 * f + k];
+                if (g == kNone || faceChart[g] != kNone) continue;
+                const float* n = &normals[3 * g];
+                queue.emplace(1.0f - (n[0] * mean[0] + n[1] * mean[1] + n[2] * mean[2]), g);
+            }
+        };
+
+        add(static_cast<unsigned int>(seed));
+        while (!queue.empty() && faces < maxFaces) {
+            const unsigned int f = queue.top().second;
+            queue.pop();
+            if (faceChart[f] != kNone) continue;
+            // 队列中的代价以入队时的平均法线计算，出队时按当前平均法线重新判断
+            const float* n = &normals[3 * f];
+            if (n[0] * mean[0] + n[1] * mean[1] + n[2] * mean[2] < minCosine) continue;
+
+            // 保持圆盘：共享一条边时第三个顶点不能已在图块中（否则形成洞或夹点），共享三条边会闭合曲面
+            int shared = 0, opposite = 0;
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int g = neighbors[3 * f + k];
+                if (g != kNone && faceChart[g] == chart) {
+                    ++shared;
+                    opposite = (k + 2) % 3;
+                }
+            }
+            if (shared == 3) continue;
+            if (shared == 1 && vertexChart[tri[3 * f + opposite]] == chart) continue;
+            add(f);
+        }
+        while (!queue.empty()) queue.pop();
+        ++chart;
+    }
+    return chart;
+}
+
+size_t segmentCharts(const Mesh& mesh, const ChartAtlasOptions& options, std::vector<unsigned int>& faceChart)
+{
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    return segmentCharts(flat, options, faceChart);
+}
+
+bool buildChartAtlas(const FlatMesh& mesh, const ChartAtlasOptions& options, ChartAtlas& atlas)
+{
+    const size_t nf = mesh.triangleCount();
+    if (nf == 0) {
+        std::cerr << "Chart atlas requires a mesh with faces" << std::endl;
+        return false;
+    }
+    atlas.chartCount = segmentCharts(mesh, options, atlas.faceChart);
+    const size_t charts = atlas.chartCount;
+
+    // 按图块分组面片（CSR），图块内顶点连续编号，接缝顶点每个图块一份
+    std::vector<unsigned int> faceBegin(charts + 1, 0), chartFaces(nf);
+    for (size_t f = 0; f < nf; ++f) ++faceBegin[atlas.faceChart[f] + 1];
+    for (size_t c = 0; c < charts; ++c) faceBegin[c + 1] += faceBegin[c];
+    {
+        std::vector<unsigned int> cursor(faceBegin.begin(), faceBegin.end() - 1);
+        for (size_t f = 0; f < nf; ++f) chartFaces[cursor[atlas.faceChart[f]]++] = static_cast<unsigned int>(f);
+    }
+
+    std::vector<unsigned int> stamp(mesh.vertexCount(), kNone), local(mesh.vertexCount());
+    atlas.chartBegin.assign(charts + 1, 0);
+    atlas.sourceVertex.clear();
+    atlas.mesh.triangles.resize(3 * nf);
+    for (size_t c = 0; c < charts; ++c) {
+        atlas.chartBegin[c] = static_cast<unsigned int>(atlas.sourceVertex.size());
+        for (unsigned int i = faceBegin[c]; i < faceBegin[c + 1]; ++i) {
+            const unsigned int f = chartFaces[i];
+            for (int k = 0; k < 3; ++k) {
+                const unsigned int v = mesh.triangles[3 * f + k];
+                if (stamp[v] != c) {
+                    stamp[v] = static_cast<unsigned int>(c);
+                    local[v] = static_cast<unsigned int>(atlas.sourceVertex.size());
+                    atlas.sourceVertex.push_back(v);
+                }
+                atlas.mesh.triangles[3 * f + k] = local[v];
+            }
+        }
+    }
+    atlas.chartBegin[charts] = static_cast<unsigned int>(atlas.sourceVertex.size());
+    const size_t nv = atlas.sourceVertex.size();
+    atlas.mesh.positions.resize(3 * nv);
+    for (size_t v = 0; v < nv; ++v) {
+        for (int k = 0; k < 3; ++k) atlas.mesh.positions[3 * v + k] = mesh.positions[3 * atlas.sourceVertex[v] + k];
+    }
+
+    std::vector<float> normals, areas;
+    computeFaceFrames(mesh, normals, areas);
+
+    // 各图块相互独立，按图块并行展开；图块大小差异很大，采用动态调度
+    std::vector<double> uv(2 * nv);
+    const long long chartCount = static_cast<long long>(charts);
+    #pragma omp parallel for schedule(dynamic)
+    for (long long c = 0; c < chartCount; ++c) {
+        const unsigned int base = atlas.chartBegin[c];
+        FlatMesh chart;
+        chart.positions.assign(atlas.mesh.positions.begin() + 3 * base, atlas.mesh.positions.begin() + 3 * atlas.chartBegin[c + 1]);
+        chart.triangles.reserve(3 * (faceBegin[c + 1] - faceBegin[c]));
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        for (unsigned int i = faceBegin[c]; i < faceBegin[c + 1]; ++i) {
+            const unsigned int f = chartFaces[i];
+            for (int k = 0; k < 3; ++k) {
+                chart.triangles.push_back(atlas.mesh.triangles[3 * f + k] - base);
+                normal[k] += areas[f] * normals[3 * f + k];
+            }
+        }
+        const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int k = 0; k < 3; ++k) normal[k] = length > 0.0f ? normal[k] / length : (k == 2 ? 1.0f : 0.0f);
+
+        std::vector<double> chartUv;
+        flattenChart(chart, normal, chartUv);
+        std::copy(chartUv.begin(), chartUv.end(), uv.begin() + 2 * base);
+    }
+
+    return packAtlas(atlas.chartBegin, uv, options.packing, atlas.texCoords, &atlas.packing);
+}
+
+bool buildChartAtlas(const Mesh& mesh, const ChartAtlasOptions& options, ChartAtlas& atlas)
+{
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    return buildChartAtlas(flat, options, atlas);
+}
+
+bool buildAtlasMesh(const Mesh& source, const ChartAtlas& atlas, Mesh& mesh)
+{
+    if (!fromFlatMesh(atlas.mesh, mesh) || mesh.n_vertices() != atlas.sourceVertex.size() ||
+        mesh.n_faces() != atlas.faceChart.size()) {
+        std::cerr << "Chart atlas mesh could not be rebuilt" << std::endl;
+        return false;
+    }
+    mesh.request_vertex_texcoords2D();
+    const bool normals = source.has_vertex_normals() && source.n_vertices() > 0;
+    for (auto vh : mesh.vertices()) {
+        const int v = vh.idx();
+        mesh.set_texcoord2D(vh, Mesh::TexCoord2D(atlas.texCoords[2 * v], atlas.texCoords[2 * v + 1]));
+        if (normals) mesh.set_normal(vh, source.normal(Mesh::VertexHandle(static_cast<int>(atlas.sourceVertex[v]))));
+    }
+    return true;
+}
+
+} // namespace meshcore
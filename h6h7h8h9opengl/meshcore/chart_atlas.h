@@ -0,0 +1,54 @@
+#ifndef MESHCORE_CHART_ATLAS_H
+#define MESHCORE_CHART_ATLAS_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include "atlas_packer.h"
+#include <cstddef>
+#include <vector>
+
+namespace meshcore {
+
+// How the mesh is cut into charts and laid out (网格如何切分为图块并排布)
+struct ChartAtlasOptions {
+    float maxNormalAngle = 60.0f;   // Faces join a chart within this angle of its mean normal, degrees (面法线与图块平均法线的夹角不超过此值时加入，度)
+    size_t maxChartFaces = 0;       // Upper bound on faces per chart, 0 = none (每个图块的面数上限，0为不限)
+    AtlasPackOptions packing;       // Texel density, resolution, padding and rotation of the layout (排布的纹素密度、分辨率、间隔与旋转)
+};
+
+// Charts of a mesh and their packed UV layout. Vertices on chart boundaries are split, one copy
+// per chart, so every vertex has a single texcoord.
+// 网格的图块及其打包后的UV布局。图块边界上的顶点被拆分，每个图块一份，因此每个顶点只有一个纹理坐标
+struct ChartAtlas {
+    std::vector<unsigned int> faceChart;     // Chart of each face (每个面所属的图块)
+    size_t chartCount = 0;
+    FlatMesh mesh;                           // 3D mesh with seam vertices split, faces in source order (沿接缝拆分顶点的三维网格，面顺序不变)
+    std::vector<unsigned int> sourceVertex;  // Split vertex -> source vertex (拆分顶点对应的源顶点)
+    std::vector<unsigned int> chartBegin;    // Chart c owns split vertices [chartBegin[c], chartBegin[c+1]) (图块c拥有的拆分顶点区间)
+    std::vector<float> texCoords;            // 2 per split vertex, in [0,1] (每个拆分顶点2个值，位于[0,1])
+    AtlasPackResult packing;                 // Atlas size and density (图集尺寸与密度)
+};
+
+// Cut the mesh into disk-like charts by region growing on face normals. A face only joins a
+// chart across an edge if the chart stays a topological disk (it shares one edge and brings a
+// new vertex, or shares two edges), so closed and high-genus meshes end up as disks without a
+// separate cutting pass. Returns the number of charts.
+// 按面法线区域生长将网格切分为圆盘状图块。只有图块仍是拓扑圆盘时面才会加入（共享一条边且带来新顶点，
+// 或共享两条边），因此封闭与高亏格网格无需单独的切割步骤即可得到圆盘。返回图块数
+size_t segmentCharts(const FlatMesh& mesh, const ChartAtlasOptions& options, std::vector<unsigned int>& faceChart);
+size_t segmentCharts(const Mesh& mesh, const ChartAtlasOptions& options, std::vector<unsigned int>& faceChart);
+
+// Segment, parameterize every chart with LSCM in parallel at model scale, and pack the charts
+// into one atlas with packAtlas
+// 切分图块，按模型尺度并行地对每个图块做LSCM参数化，并用packAtlas将图块打包到一张图集中
+bool buildChartAtlas(const FlatMesh& mesh, const ChartAtlasOptions& options, ChartAtlas& atlas);
+bool buildChartAtlas(const Mesh& mesh, const ChartAtlasOptions& options, ChartAtlas& atlas);
+
+// Half-edge mesh of atlas.mesh with the texcoords attached and the source vertex normals kept,
+// so the seams do not show in the shading
+// 由atlas.mesh构建的半边网格，带纹理坐标并沿用源顶点法线，接缝处的着色不出现断裂
+bool buildAtlasMesh(const Mesh& source, const ChartAtlas& atlas, Mesh& mesh);
+
+} // namespace meshcore
+
+#endif // MESHCORE_CHART_ATLAS_H
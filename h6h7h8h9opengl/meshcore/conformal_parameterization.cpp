@@ -0,0 +1,189 @@
+#include "conformal_parameterization.h"
+#include "boundary_loops.h"
+#include "dirty_region.h"
+#include "laplacian.h"
+#include "mesh_io.h"
+#include "meshcore_internal.h"
+#include <iostream>
+#include <utility>
+
+namespace meshcore {
+
+namespace {
+
+// 按面朝向的边界边a->b：没有三角形含有反向的b->a。洞的边界同样计入，面积项对所有边界环求和
+void findBoundaryEdges(const FlatMesh& mesh, const VertexCorners& adjacency, std::vector<unsigned int>& edges)
+{
+    const unsigned int* tri = mesh.triangles.data();
+    edges.clear();
+    for (unsigned int h = 0; h < mesh.triangles.size(); ++h) {
+        const unsigned int a = tri[h], b = tri[nextCorner(h)];
+        bool twin = false;
+        for (unsigned int i = adjacency.begin(b); i < adjacency.end(b) && !twin; ++i) {
+            twin = tri[nextCorner(adjacency.corners[i])] == a;
+        }
+        if (!twin) {
+            edges.push_back(a);
+            edges.push_back(b);
+        }
+    }
+}
+
+} // namespace
+
+void ConformalSolverCache::clear()
+{
+    patternKey_ = valuesKey_ = 0;
+    analyzed_ = factorized_ = false;
+    unknown_.clear();
+    system_.resize(0, 0);
+    coupling_.resize(0, 0);
+}
+
+bool ConformalSolverCache::solve(const FlatMesh& mesh, const unsigned int pins[2], const double pinValues[2][2],
+                                 std::vector<double>& uv)
+{
+    const size_t n = mesh.vertexCount();
+    if (n == 0 || pins[0] >= n || pins[1] >= n || pins[0] == pins[1]) return false;
+
+    VertexCorners adjacency;
+    adjacency.build(mesh);
+    LaplacianOperator op;
+    buildLaplacian(mesh, adjacency, LaplacianWeights::Cotangent, op);
+    std::vector<unsigned int> boundary;
+    findBoundaryEdges(mesh, adjacency, boundary);
+
+    std::vector<unsigned int> fixed(pins, pins + 2);
+    for (size_t v = 0; v < n; ++v) {
+        if (adjacency.begin(v) == adjacency.end(v)) fixed.push_back(static_cast<unsigned int>(v));
+    }
+    uint64_t pattern = hashArray(op.offsets, kFnvOffset);
+    pattern = hashArray(op.columns, pattern);
+    pattern = hashArray(boundary, pattern);
+    pattern = hashArray(fixed, pattern);
+    const uint64_t values = hashArray(op.values, pattern);
+
+    if (!factorized_ || values != valuesKey_) {
+        const bool samePattern = analyzed_ && pattern == patternKey_;
+        if (!samePattern) {
+            // 标量u_i为i，v_i为n+i；固定顶点的两个标量不是未知量
+            unknown_.assign(2 * n, 0);
+            for (unsigned int v : fixed) unknown_[v] = unknown_[n + v] = -1;
+            int count = 0;
+            for (int& u : unknown_) {
+                if (u >= 0) u = count++;
+            }
+        }
+        int freeCount = 0;
+        for (int u : unknown_) freeCount += u >= 0;
+
+        // [L -S; S L]：u、v各一份余切拉普拉斯，边界边a->b贡献 -S_ab = -1 与 -S_ba = +1
+        typedef Eigen::Triplet<double> Entry;
+        std::vector<Entry> system, coupling;
+        system.reserve(2 * (op.nonZeros() + n) + 2 * boundary.size());
+        auto add = [&](size_t row, size_t column, double value) {
+            if (unknown_[row] < 0) return;
+            if (unknown_[column] >= 0) system.emplace_back(unknown_[row], unknown_[column], value);
+            else coupling.emplace_back(unknown_[row], column, -value);
+        };
+        for (size_t v = 0; v < n; ++v) {
+            for (size_t offset = 0; offset <= n; offset += n) {
+                add(offset + v, offset + v, op.diagonal[v]);
+                for (unsigned int k = op.begin(v); k < op.end(v); ++k) {
+                    add(offset + v, offset + op.columns[k], -op.values[k]);
+                }
+            }
+        }
+        for (size_t e = 0; e < boundary.size(); e += 2) {
+            const size_t a = boundary[e], b = boundary[e + 1];
+            add(a, n + b, -1.0);
+            add(n + b, a, -1.0);
+            add(b, n + a, 1.0);
+            add(n + a, b, 1.0);
+        }
+        system_.resize(freeCount, freeCount);
+        system_.setFromTriplets(system.begin(), system.end());
+        coupling_.resize(freeCount, 2 * n);
+        coupling_.setFromTriplets(coupling.begin(), coupling.end());
+
+        // 结构改变时重新做符号分析，否则只做数值分解
+        if (!samePattern) {
+            direct_.analyzePattern(system_);
+            patternKey_ = pattern;
+            analyzed_ = true;
+            ++symbolicCount_;
+        }
+        direct_.factorize(system_);
+        ++numericCount_;
+        factorized_ = direct_.info() == Eigen::Success;
+        if (!factorized_) {
+            std::cerr << "Conformal system factorization failed (is the mesh connected?)" << std::endl;
+            return false;
+        }
+        valuesKey_ = values;
+    }
+
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(2 * n);
+    for (int k = 0; k < 2; ++k) {
+        x[pins[k]] = pinValues[k][0];
+        x[n + pins[k]] = pinValues[k][1];
+    }
+    const Eigen::VectorXd rhs = coupling_ * x;
+    const Eigen::VectorXd free = direct_.solve(rhs);
+    if (direct_.info() != Eigen::Success) return false;
+
+    uv.resize(2 * n);
+    for (size_t v = 0; v < n; ++v) {
+        for (int k = 0; k < 2; ++k) {
+            const int u = unknown_[k * n + v];
+            uv[2 * v + k] = u >= 0 ? free[u] : x[k * n + v];
+        }
+    }
+    return true;
+}
+
+bool conformalParameterize(Mesh& mesh, ConformalSolverCache* cache)
+{
+    const std::vector<BoundaryLoop> loops = findBoundaryLoops(mesh);
+    if (loops.empty()) {
+        std::cerr << "Conformal parameterization requires a mesh with a boundary" << std::endl;
+        return false;
+    }
+
+    // 固定点：最长边界环上离起点最远的顶点，以及离它最远的顶点，按三维距离摆放
+    const std::vector<Mesh::VertexHandle>& outer = loops.front().vertices;
+    auto farthest = [&](Mesh::VertexHandle from) {
+        Mesh::VertexHandle best = from;
+        float bestDistance = -1.0f;
+        for (auto vh : outer) {
+            const float d = (mesh.point(vh) - mesh.point(from)).sqrnorm();
+            if (d > bestDistance) {
+                bestDistance = d;
+                best = vh;
+            }
+        }
+        return best;
+    };
+    const Mesh::VertexHandle first = farthest(outer.front());
+    const Mesh::VertexHandle second = farthest(first);
+    const double distance = (mesh.point(second) - mesh.point(first)).norm();
+    const unsigned int pins[2] = {static_cast<unsigned int>(first.idx()), static_cast<unsigned int>(second.idx())};
+    const double pinValues[2][2] = {{0.0, 0.0}, {distance, 0.0}};
+
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    ConformalSolverCache localCache;
+    ConformalSolverCache& solver = cache ? *cache : localCache;
+    std::vector<double> uv;
+    if (!solver.solve(flat, pins, pinValues, uv)) {
+        std::cerr << "Conformal parameterization solve failed!" << std::endl;
+        return false;
+    }
+    for (auto vh : mesh.vertices()) {
+        mesh.set_point(vh, Mesh::Point(uv[2 * vh.idx()], uv[2 * vh.idx() + 1], 0.0f));
+    }
+    markAllDirty(mesh);
+    return true;
+}
+
+} // namespace meshcore
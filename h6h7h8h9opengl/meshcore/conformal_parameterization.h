@@ -0,0 +1,60 @@
+#ifndef MESHCORE_CONFORMAL_PARAMETERIZATION_H
+#define MESHCORE_CONFORMAL_PARAMETERIZATION_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include <cstdint>
+#include <vector>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace meshcore {
+
+// Reusable factorization of the least-squares conformal map (LSCM, Lévy et al. 2002) with
+// two pinned vertices. The conformal energy is the Dirichlet energy of u and v minus the
+// signed area of the image, 4E = u'Lu + v'Lv - 2u'Sv with the cotangent Laplacian L and
+// the antisymmetric boundary-edge matrix S, so the system over the free (u, v) is symmetric
+// positive definite and is factored by SimplicialLDLT. As in DirichletSolverCache, the
+// symbolic analysis is kept while the connectivity and pins stay the same, and the numeric
+// factorization while the cotangent weights stay the same as well.
+// 两个顶点固定的最小二乘保角映射（LSCM，Lévy等 2002）的可复用分解。保角能量为u、v的Dirichlet
+// 能量减去像的有向面积，4E = u'Lu + v'Lv - 2u'Sv，L为余切拉普拉斯，S为边界边构成的反对称矩阵，
+// 因此自由(u, v)上的系统对称正定，用SimplicialLDLT分解。与DirichletSolverCache相同，连接关系与
+// 固定点不变时复用符号分析，余切权重也不变时复用数值分解
+class ConformalSolverCache {
+public:
+    // Minimize the conformal energy of mesh; uv receives 2 values per vertex, the pins are
+    // placed at pinValues and isolated vertices at the origin
+    // 最小化mesh的保角能量；uv每个顶点2个值，固定点取pinValues，孤立顶点取原点
+    bool solve(const FlatMesh& mesh, const unsigned int pins[2], const double pinValues[2][2],
+               std::vector<double>& uv);
+
+    void clear();
+    int symbolicCount() const { return symbolicCount_; }   // Pattern analyses so far (已进行的符号分析次数)
+    int numericCount() const { return numericCount_; }     // Numeric factorizations so far (已进行的数值分解次数)
+
+private:
+    uint64_t patternKey_ = 0;
+    uint64_t valuesKey_ = 0;
+    bool analyzed_ = false;
+    bool factorized_ = false;
+    int symbolicCount_ = 0;
+    int numericCount_ = 0;
+
+    std::vector<int> unknown_;                  // Scalar (u_i = i, v_i = n+i) -> free unknown, -1 if pinned (标量到自由未知量，固定为-1)
+    Eigen::SparseMatrix<double> system_;        // Free block of [L -S; S L] (自由块)
+    Eigen::SparseMatrix<double> coupling_;      // Free rows, pinned columns (自由行与固定列的耦合块)
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct_;
+};
+
+// Free-boundary conformal parameterization, vertex positions become (u, v, 0). Two far-apart
+// vertices of the longest boundary loop are pinned at their 3D distance, every other boundary
+// vertex (holes included) is free, so the map has no boundary distortion to absorb.
+// An optional cache keeps the factorization between calls
+// 自由边界保角参数化，顶点坐标被替换为(u, v, 0)。最长边界环上相距较远的两个顶点按其三维距离固定，
+// 其余边界顶点（包括洞）都是自由的，映射无需吸收边界带来的扭曲。可选的cache在多次调用间保留分解
+bool conformalParameterize(Mesh& mesh, ConformalSolverCache* cache = nullptr);
+
+} // namespace meshcore
+
+#endif // MESHCORE_CONFORMAL_PARAMETERIZATION_H
@@ -0,0 +1,348 @@
+#include "curvature.h"
+#include "mesh_io.h"
+#include "dirty_region.h"
+#include "laplacian.h"
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace meshcore {
+
+static const char* const kCurvaturePropertyNames[CurvatureFields::FieldCount] = {
+    "curvature:gaussian",
+    "curvature:mean",
+    "curvature:max",
+};
+
+static const char* const kDirectionPropertyNames[2] = {
+    "curvature:dir1",
+    "curvature:dir2",
+};
+
+// 主方向按顶点索引连续写入属性
+static void storePrincipalDirections(Mesh& openMesh, const PrincipalCurvatures& principal)
+{
+    const std::vector<float>* dirs[2] = {&principal.dir1, &principal.dir2};
+    for (int d = 0; d < 2; ++d) {
+        OpenMesh::VPropHandleT<Mesh::Normal> handle;
+        if (!openMesh.get_property_handle(handle, kDirectionPropertyNames[d])) {
+            openMesh.add_property(handle, kDirectionPropertyNames[d]);
+        }
+        std::vector<Mesh::Normal>& out = openMesh.property(handle).data_vector();
+        const float* in = dirs[d]->data();
+        for (size_t v = 0; v < out.size(); ++v) {
+            out[v] = Mesh::Normal(in[3 * v], in[3 * v + 1], in[3 * v + 2]);
+        }
+    }
+}
+
+int curvatureField(CurvatureType type)
+{
+    switch (type) {
+    case CurvatureType::Gaussian: return CurvatureFields::Gaussian;
+    case CurvatureType::Mean:     return CurvatureFields::Mean;
+    case CurvatureType::Max:      return CurvatureFields::Max;
+    default:                      return -1;
+    }
+}
+
+void computeCurvatureFields(const Mesh& openMesh, CurvatureFields& fields)
+{
+    FlatMesh flat;
+    toFlatMesh(openMesh, flat);
+    VertexCorners adjacency;
+    adjacency.build(flat);
+    std::vector<unsigned char> isBoundary;
+    markBoundaryVertices(flat, adjacency, isBoundary);
+    computeCurvatureFields(flat, adjacency, isBoundary, fields);
+}
+
+void updateCurvatureProperties(Mesh& openMesh, CurvatureFields* result)
+{
+    CurvatureFields local;
+    CurvatureFields& fields = result ? *result : local;
+    PrincipalCurvatures principal;
+    FlatMesh flat;
+    toFlatMesh(openMesh, flat);
+    VertexCorners adjacency;
+    adjacency.build(flat);
+    std::vector<unsigned char> isBoundary;
+    markBoundaryVertices(flat, adjacency, isBoundary);
+    computeCurvatureFields(flat, adjacency, isBoundary, fields, &principal);
+
+    for (int f = 0; f < CurvatureFields::FieldCount; ++f) {
+        OpenMesh::VPropHandleT<float> handle;
+        curvatureProperty(openMesh, f, handle);
+        // 属性按顶点索引连续存储，可整体拷贝
+        std::copy(fields.values[f].begin(), fields.values[f].end(), openMesh.property(handle).data_vector().begin());
+    }
+    storePrincipalDirections(openMesh, principal);
+    clearDirty(openMesh);
+}
+
+bool updateDirtyCurvature(Mesh& openMesh, std::vector<unsigned int>& updated)
+{
+    updated.clear();
+    std::vector<unsigned int> dirty;
+    collectDirtyVertices(openMesh, dirty);
+    if (dirty.empty()) return true;
+
+    OpenMesh::VPropHandleT<float> handles[CurvatureFields::FieldCount];
+    bool hasFields = true;
+    for (int f = 0; f < CurvatureFields::FieldCount; ++f) {
+        hasFields = hasFields && getCurvatureProperty(openMesh, f, handles[f]);
+    }
+
+    // 受影响区域：脏顶点的2环闭包
+    std::vector<unsigned int> region = dirty;
+    expandOneRing(openMesh, region);
+    expandOneRing(openMesh, region);
+    if (!hasFields || region.size() > kFullUpdateFraction * openMesh.n_vertices()) {
+        updateCurvatureProperties(openMesh);
+        return false;
+    }
+
+    // 局部子网格：region的1环闭包上的全部面，保证region内顶点的邻面与邻点法线完整
+    std::vector<unsigned int> support = region;
+    expandOneRing(openMesh, support);
+    std::vector<unsigned int> subFaces;
+    for (unsigned int v : support) {
+        for (auto fh : openMesh.vf_range(Mesh::VertexHandle(v))) {
+            subFaces.push_back(fh.idx());
+        }
+    }
+    std::sort(subFaces.begin(), subFaces.end());
+    subFaces.erase(std::unique(subFaces.begin(), subFaces.end()), subFaces.end());
+
+    std::vector<unsigned int> subVertices;
+    for (unsigned int f : subFaces) {
+        for (auto vh : openMesh.fv_range(Mesh::FaceHandle(f))) {
+            subVertices.push_back(vh.idx());
+        }
+    }
+    std::sort(subVertices.begin(), subVertices.end());
+    subVertices.erase(std::unique(subVertices.begin(), subVertices.end()), subVertices.end());
+    auto localIndex = [&subVertices](unsigned int v) {
+        return static_cast<unsigned int>(std::lower_bound(subVertices.begin(), subVertices.end(), v) - subVertices.begin());
+    };
+
+    FlatMesh flat;
+    flat.positions.resize(subVertices.size() * 3);
+    for (size_t i = 0; i < subVertices.size(); ++i) {
+        const Mesh::Point& p = openMesh.point(Mesh::VertexHandle(subVertices[i]));
+        flat.positions[3 * i] = p[0];
+        flat.positions[3 * i + 1] = p[1];
+        flat.positions[3 * i + 2] = p[2];
+    }
+    flat.triangles.reserve(subFaces.size() * 3);
+    for (unsigned int f : subFaces) {
+        for (auto vh : openMesh.fv_range(Mesh::FaceHandle(f))) {
+            flat.triangles.push_back(localIndex(vh.idx()));
+        }
+    }
+
+    VertexCorners adjacency;
+    adjacency.build(flat);
+    std::vector<unsigned char> isBoundary;
+    markBoundaryVertices(flat, adjacency, isBoundary);
+    CurvatureFields fields;
+    PrincipalCurvatures principal;
+    computeCurvatureFields(flat, adjacency, isBoundary, fields, &principal);
+
+    // 写回region内的顶点；边界顶点保留整体计算时的最小值占位
+    OpenMesh::VPropHandleT<Mesh::Normal> dir1, dir2;
+    const bool hasDirections = getPrincipalDirectionProperties(openMesh, dir1, dir2);
+    for (unsigned int v : region) {
+        const unsigned int l = localIndex(v);
+        if (l == subVertices.size() || subVertices[l] != v) continue;    // 孤立顶点
+        Mesh::VertexHandle vh(v);
+        if (!isBoundary[l]) {
+            for (int f = 0; f < CurvatureFields::FieldCount; ++f) {
+                openMesh.property(handles[f], vh) = fields.values[f][l];
+            }
+        }
+        if (hasDirections) {
+            openMesh.property(dir1, vh) = Mesh::Normal(principal.dir1[3 * l], principal.dir1[3 * l + 1], principal.dir1[3 * l + 2]);
+            openMesh.property(dir2, vh) = Mesh::Normal(principal.dir2[3 * l], principal.dir2[3 * l + 1], principal.dir2[3 * l + 2]);
+        }
+    }
+    for (unsigned int v : dirty) {
+        openMesh.data(Mesh::VertexHandle(v)).dirty = false;
+    }
+    updated.swap(region);
+    return true;
+}
+
+void computePrincipalCurvatures(const Mesh& openMesh, PrincipalCurvatures& result)
+{
+    FlatMesh flat;
+    toFlatMesh(openMesh, flat);
+    VertexCorners adjacency;
+    adjacency.build(flat);
+    computePrincipalCurvatures(flat, adjacency, result);
+}
+
+void updatePrincipalDirections(Mesh& openMesh)
+{
+    PrincipalCurvatures principal;
+    computePrincipalCurvatures(openMesh, principal);
+    storePrincipalDirections(openMesh, principal);
+}
+
+bool getPrincipalDirectionProperties(const Mesh& openMesh, OpenMesh::VPropHandleT<Mesh::Normal>& dir1,
+                                     OpenMesh::VPropHandleT<Mesh::Normal>& dir2)
+{
+    return openMesh.get_property_handle(dir1, kDirectionPropertyNames[0]) &&
+           openMesh.get_property_handle(dir2, kDirectionPropertyNames[1]);
+}
+
+bool getCurvatureProperty(const Mesh& openMesh, int field, OpenMesh::VPropHandleT<float>& handle)
+{
+    return field >= 0 && field < CurvatureFields::FieldCount &&
+           openMesh.get_property_handle(handle, kCurvaturePropertyNames[field]);
+}
+
+void curvatureProperty(Mesh& openMesh, int field, OpenMesh::VPropHandleT<float>& handle)
+{
+    if (!openMesh.get_property_handle(handle, kCurvaturePropertyNames[field])) {
+        openMesh.add_property(handle, kCurvaturePropertyNames[field]);
+    }
+}
+
+void calculateCurvatures(Mesh& openMesh, CurvatureType type)
+{
+    if (openMesh.n_vertices() == 0) return;
+
+    const int f = curvatureField(type);
+    if (f < 0) {
+        for (auto vh : openMesh.vertices()) {
+            openMesh.data(vh).curvature = 0.0f;
+        }
+        return;
+    }
+
+    CurvatureFields fields;
+    computeCurvatureFields(openMesh, fields);
+
+    // 归一化到[0,1]；边界顶点存的是最小值，因此为0
+    const float minVal = fields.minValue[f];
+    const float range = fields.maxValue[f] - minVal;
+    const std::vector<float>& values = fields.values[f];
+    for (auto vh : openMesh.vertices()) {
+        float c = values[vh.idx()] - minVal;
+        openMesh.data(vh).curvature = range > 0.0f ? c / range : c;
+    }
+}
+
+void computeMeanCurvatureVectors(const Mesh& openMesh, std::vector<Mesh::Point>& vectors) {
+    LaplacianOperator op;
+    buildLaplacian(openMesh, LaplacianWeights::Cotangent, op);
+    
+    std::vector<float> positions(openMesh.n_vertices() * 3), H;
+    for (auto vh : openMesh.vertices()) {
+        const Mesh::Point& p = openMesh.point(vh);
+        std::copy(p.data(), p.data() + 3, &positions[3 * vh.idx()]);
+    }
+    meanCurvatureVectors(op, positions.data(), H);
+    
+    vectors.resize(openMesh.n_vertices());
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        vectors[i] = Mesh::Point(H[3 * i], H[3 * i + 1], H[3 * i + 2]);
+    }
+}
+
+float triangleArea(const Mesh::Point& p0, const Mesh::Point& p1, const Mesh::Point& p2) {
+    auto e1 = p1 - p0;
+    auto e2 = p2 - p0;
+    auto cross = e1 % e2;
+    return cross.length() / 2.0f;
+}
+
+// 计算混合面积（参考GetAmixed函数）
+float calculateMixedArea(const Mesh& openMesh, const Mesh::VertexHandle& vh) {
+    float A_mixed = 0.f;
+
+    // 遍历邻接顶点（参考GetAmixed中的adjV）
+    for (auto vv_it = openMesh.vv_begin(vh); vv_it != openMesh.vv_end(vh); ++vv_it) {
+        auto adjV = *vv_it;
+        
+        // 找到共享边的下一个顶点np（参考GetAmixed中的np）
+        Mesh::VertexHandle np;
+        auto heh = openMesh.find_halfedge(vh, adjV);
+        if (!heh.is_valid()) continue;
+        
+        if (!openMesh.is_boundary(heh)) {
+            // 获取同一面上的下一个顶点
+            auto next_heh = openMesh.next_halfedge_handle(heh);
+            np = openMesh.to_vertex_handle(next_heh);
+        } else {
+            // 边界边处理：获取对边上的顶点
+            auto opp_heh = openMesh.opposite_halfedge_handle(heh);
+            if (!openMesh.is_boundary(opp_heh)) {
+                auto next_opp_heh = openMesh.next_halfedge_handle(opp_heh);
+                np = openMesh.to_vertex_handle(next_opp_heh);
+            } else {
+                continue; // 无效边界
+            }
+        }
+
+        auto p_v = openMesh.point(vh);
+        auto p_adjV = openMesh.point(adjV);
+        auto p_np = openMesh.point(np);
+        
+        // 计算向量
+        auto vec_adjV = p_adjV - p_v;
+        auto vec_np = p_np - p_v;
+        
+        // 检查是否非钝角三角形（点积>=0）
+        bool nonObtuse = 
+            (vec_adjV | vec_np) >= 0.0f &&
+            (p_v - p_adjV | p_np - p_adjV) >= 0.0f &&
+            (p_v - p_np | p_adjV - p_np) >= 0.0f;
+        
+        if (nonObtuse) {
+            // 锐角三角形处理
+            float area = triangleArea(p_v, p_adjV, p_np);
+            if (area > EPSILON) {
+                // 对边的余切：|v-adjV|²对应np处的角，|v-np|²对应adjV处的角
+                float cotAdjV = cotangent(p_adjV, p_v, p_np);
+                float cotNp = cotangent(p_np, p_v, p_adjV);
+                
+                // 计算距离平方
+                float dist2_adjV = vec_adjV.sqrnorm();
+                float dist2_np = vec_np.sqrnorm();
+                
+                A_mixed += (dist2_adjV * cotNp + dist2_np * cotAdjV) / 8.0f;
+            }
+        } else {
+            // 钝角三角形处理
+            float area = triangleArea(p_v, p_adjV, p_np);
+            if (area > EPSILON) {
+                // 检查顶点vh处的角是否钝角
+                if ((vec_adjV | vec_np) < 0.0f) {
+                    A_mixed += area / 2.0f;
+                } else {
+                    A_mixed += area / 4.0f;
+                }
+            }
+        }
+    }
+    return A_mixed;
+}
+
+// 辅助函数：计算三角形中某个角的余切值
+float cotangent(const Mesh::Point& a, const Mesh::Point& b, const Mesh::Point& c) {
+    Mesh::Point vec1 = b - a;
+    Mesh::Point vec2 = c - a;
+    float dotProduct = vec1 | vec2;
+    float crossNorm = (vec1 % vec2).norm();
+    
+    // 避免除以零
+    if (fabs(crossNorm) < EPSILON) {
+        return 0.0f;
+    }
+    
+    return dotProduct / crossNorm;
+}
+
+} // namespace meshcore
@@ -0,0 +1,57 @@
+#ifndef MESHCORE_CURVATURE_H
+#define MESHCORE_CURVATURE_H
+
+#include "mesh_types.h"
+#include "curvature_fields.h"
+#include <vector>
+
+namespace meshcore {
+
+// Curvature quantity written into the per-vertex curvature trait
+// 写入顶点曲率属性的曲率类型
+enum class CurvatureType {
+    None,                // Clear curvature to 0 (曲率清零)
+    Gaussian,            // Gaussian curvature (高斯曲率)
+    Mean,                // Mean curvature (平均曲率)
+    Max                  // Maximum principal curvature k1 (最大主曲率k1)
+};
+
+// Compute per-vertex curvature, normalized to [0,1] over interior vertices, into the curvature trait
+// 计算顶点曲率写入curvature属性，内部顶点归一化到[0,1]，边界顶点为0
+void calculateCurvatures(Mesh& mesh, CurvatureType type);
+
+// All curvature fields in one parallel pass (一次并行计算全部曲率场)
+void computeCurvatureFields(const Mesh& mesh, CurvatureFields& fields);
+
+// Store the raw fields as vertex properties "curvature:gaussian|mean|max", and the
+// principal directions as "curvature:dir1|dir2"
+// 将原始曲率场保存为顶点属性"curvature:gaussian|mean|max"，主方向保存为"curvature:dir1|dir2"
+void updateCurvatureProperties(Mesh& mesh, CurvatureFields* fields = nullptr);
+
+// Recompute the stored fields and directions only around dirty vertices (their 2-ring,
+// since the principal fit also uses neighbouring normals) and clear the dirty flags.
+// Returns false when the region is too large and a full update was done instead;
+// otherwise updated holds the sorted vertices whose values changed.
+// 只在脏顶点附近（2环，主曲率拟合还用到邻点法线）重新计算曲率属性与主方向并清除脏标记。
+// 区域过大时改为整体更新并返回false；否则updated为值发生变化的有序顶点
+bool updateDirtyCurvature(Mesh& mesh, std::vector<unsigned int>& updated);
+
+// Principal curvatures and directions only (仅计算主曲率与主方向)
+void computePrincipalCurvatures(const Mesh& mesh, PrincipalCurvatures& result);
+void updatePrincipalDirections(Mesh& mesh);      // Only the "curvature:dir1|dir2" properties (仅更新主方向属性)
+// Existing direction properties for k1 and k2 (k1与k2方向的已有属性)
+bool getPrincipalDirectionProperties(const Mesh& mesh, OpenMesh::VPropHandleT<Mesh::Normal>& dir1,
+                                     OpenMesh::VPropHandleT<Mesh::Normal>& dir2);
+
+int curvatureField(CurvatureType type);      // CurvatureFields::Field, -1 for None (对应的曲率场序号，None为-1)
+bool getCurvatureProperty(const Mesh& mesh, int field, OpenMesh::VPropHandleT<float>& handle);  // Existing property (已有属性)
+void curvatureProperty(Mesh& mesh, int field, OpenMesh::VPropHandleT<float>& handle);           // Get or add (获取或添加属性)
+
+void computeMeanCurvatureVectors(const Mesh& mesh, std::vector<Mesh::Point>& vectors); // Mean curvature vectors via the Laplacian operator (由拉普拉斯算子计算平均曲率向量)
+float calculateMixedArea(const Mesh& mesh, const Mesh::VertexHandle& vh);             // Mixed Voronoi area (混合面积)
+float triangleArea(const Mesh::Point& p0, const Mesh::Point& p1, const Mesh::Point& p2); // Triangle area (三角形面积)
+float cotangent(const Mesh::Point& a, const Mesh::Point& b, const Mesh::Point& c);      // Cotangent of the angle at a (a处角的余切值)
+
+} // namespace meshcore
+
+#endif // MESHCORE_CURVATURE_H
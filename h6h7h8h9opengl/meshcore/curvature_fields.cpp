@@ -0,0 +1,109 @@
+#include "curvature_fields.h"
+#include "laplacian.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace meshcore {
+
+namespace {
+
+const float kMinArea = 1e-12f;      // 小于该面积的三角形视为退化
+
+// 每个角缓存的数据
+struct CornerData {
+    float angle;        // 内角
+    float area;         // 该角顶点分得的混合面积
+    float h[3];         // sum(cot) * (p_v - p_other)，平均曲率向量的贡献
+};
+
+} // namespace
+
+void computeCurvatureFields(const FlatMesh& mesh, const VertexCorners& adjacency,
+                            const std::vector<unsigned char>& isBoundary,
+                            CurvatureFields& fields,
+                            PrincipalCurvatures* principal)
+{
+    const long long nv = static_cast<long long>(mesh.vertexCount());
+    const long long nt = static_cast<long long>(mesh.triangleCount());
+    const float* pos = mesh.positions.data();
+    const unsigned int* tri = mesh.triangles.data();
+
+    std::vector<CornerData> corners(nt * 3);
+
+    // 第一遍：逐三角形计算三个角的角度，余切与Meyer混合面积取自triangleCorners
+    #pragma omp parallel for schedule(static)
+    for (long long t = 0; t < nt; ++t) {
+        TriangleCorners tc;
+        triangleCorners(pos + 3 * tri[3 * t], pos + 3 * tri[3 * t + 1], pos + 3 * tri[3 * t + 2], tc);
+        CornerData* out = &corners[3 * t];
+        for (int k = 0; k < 3; ++k) {
+            const int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+            out[k].angle = std::atan2(tc.doubleArea, tc.edgeDot[k]);
+            out[k].area = tc.area[k];
+            // cot[k2]*(p_k - p_k1) + cot[k1]*(p_k - p_k2)，其中p_k - p_k1 = -e[k2]，p_k - p_k2 = e[k1]；退化时余切为0
+            for (int a = 0; a < 3; ++a) {
+                out[k].h[a] = tc.cot[k1] * tc.edge[k1][a] - tc.cot[k2] * tc.edge[k2][a];
+            }
+        }
+    }
+
+    for (auto& values : fields.values) {
+        values.assign(nv, 0.0f);
+    }
+    fields.mixedArea.assign(nv, 0.0f);
+    float* gaussian = fields.values[CurvatureFields::Gaussian].data();
+    float* mean = fields.values[CurvatureFields::Mean].data();
+
+    // 最大曲率取形状算子拟合的主曲率k1
+    PrincipalCurvatures local;
+    PrincipalCurvatures& pc = principal ? *principal : local;
+    computePrincipalCurvatures(mesh, adjacency, pc);
+    std::copy(pc.k1.begin(), pc.k1.end(), fields.values[CurvatureFields::Max].begin());
+
+    // 第二遍：逐顶点汇总相邻角的缓存
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        float angleSum = 0.0f, area = 0.0f, h[3] = {0.0f, 0.0f, 0.0f};
+        for (unsigned int i = adjacency.begin(v); i < adjacency.end(v); ++i) {
+            const CornerData& c = corners[adjacency.corners[i]];
+            angleSum += c.angle;
+            area += c.area;
+            h[0] += c.h[0];
+            h[1] += c.h[1];
+            h[2] += c.h[2];
+        }
+        fields.mixedArea[v] = area;
+        if (isBoundary[v] || area <= kMinArea) continue;
+
+        const float k = (2.0f * static_cast<float>(M_PI) - angleSum) / area;
+        const float hMean = std::sqrt(h[0] * h[0] + h[1] * h[1] + h[2] * h[2]) / (4.0f * area);
+        gaussian[v] = k;
+        mean[v] = hMean;
+    }
+
+    // 内部顶点的取值范围
+    for (int f = 0; f < CurvatureFields::FieldCount; ++f) {
+        const float* values = fields.values[f].data();
+        float lo = std::numeric_limits<float>::max();
+        float hi = std::numeric_limits<float>::lowest();
+        #pragma omp parallel for reduction(min : lo) reduction(max : hi)
+        for (long long v = 0; v < nv; ++v) {
+            if (isBoundary[v]) continue;
+            lo = std::min(lo, values[v]);
+            hi = std::max(hi, values[v]);
+        }
+        if (lo > hi) lo = hi = 0.0f;
+        fields.minValue[f] = lo;
+        fields.maxValue[f] = hi;
+
+        // 边界顶点取最小值，归一化后为0（与原先的显示一致）
+        float* out = fields.values[f].data();
+        #pragma omp parallel for schedule(static)
+        for (long long v = 0; v < nv; ++v) {
+            if (isBoundary[v]) out[v] = lo;
+        }
+    }
+}
+
+} // namespace meshcore
@@ -0,0 +1,38 @@
+#ifndef MESHCORE_CURVATURE_FIELDS_H
+#define MESHCORE_CURVATURE_FIELDS_H
+
+#include "flat_mesh.h"
+#include "principal_curvature.h"
+#include <vector>
+
+namespace meshcore {
+
+// All per-vertex curvature fields, computed together and left unnormalized.
+// Boundary vertices hold the interior minimum, so they map to 0 after normalization.
+// 一次计算得到的全部顶点曲率场（未归一化）。
+// 边界顶点取内部最小值，归一化后为0。
+struct CurvatureFields {
+    enum Field { Gaussian, Mean, Max, FieldCount };
+
+    std::vector<float> values[FieldCount];   // Per-vertex values per field (每个场的顶点值)
+    std::vector<float> mixedArea;            // Voronoi/mixed area per vertex (顶点混合面积)
+    float minValue[FieldCount] = {0.0f, 0.0f, 0.0f};  // Range over interior vertices (内部顶点范围)
+    float maxValue[FieldCount] = {0.0f, 0.0f, 0.0f};
+};
+
+// One parallel pass over triangles caches per-corner angle, mixed area and
+// cotangent-weighted edge vectors; a parallel gather over vertices then forms
+// Gaussian (angle defect) and mean (|Laplace-Beltrami|/2) curvature. Max is the
+// larger principal curvature k1 from the shape-operator fit, whose full result
+// (k1, k2 and directions) is returned through principal when given.
+// 对三角形并行一次遍历，缓存每个角的角度、混合面积与余切加权边向量；
+// 再对顶点并行汇总，得到高斯曲率（角亏）与平均曲率。最大曲率为形状算子拟合得到的
+// 主曲率k1，principal非空时同时返回完整结果（k1、k2与主方向）
+void computeCurvatureFields(const FlatMesh& mesh, const VertexCorners& adjacency,
+                            const std::vector<unsigned char>& isBoundary,
+                            CurvatureFields& fields,
+                            PrincipalCurvatures* principal = nullptr);
+
+} // namespace meshcore
+
+#endif // MESHCORE_CURVATURE_FIELDS_H
@@ -0,0 +1,66 @@
+#include "dirty_region.h"
+#include <algorithm>
+
+namespace meshcore {
+
+void markAllDirty(Mesh& mesh)
+{
+    for (auto vh : mesh.vertices()) {
+        mesh.data(vh).dirty = true;
+    }
+}
+
+void clearDirty(Mesh& mesh)
+{
+    for (auto vh : mesh.vertices()) {
+        mesh.data(vh).dirty = false;
+    }
+}
+
+void collectDirtyVertices(const Mesh& mesh, std::vector<unsigned int>& vertices)
+{
+    vertices.clear();
+    for (auto vh : mesh.vertices()) {
+        if (mesh.data(vh).dirty) {
+            vertices.push_back(vh.idx());
+        }
+    }
+}
+
+void expandOneRing(const Mesh& mesh, std::vector<unsigned int>& vertices)
+{
+    const size_t count = vertices.size();
+    for (size_t i = 0; i < count; ++i) {
+        for (auto vv : mesh.vv_range(Mesh::VertexHandle(vertices[i]))) {
+            vertices.push_back(vv.idx());
+        }
+    }
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+}
+
+void updateDirtyNormals(Mesh& mesh)
+{
+    std::vector<unsigned int> dirty;
+    collectDirtyVertices(mesh, dirty);
+    if (dirty.empty()) return;
+    if (dirty.size() > kFullUpdateFraction * mesh.n_vertices()) {
+        mesh.update_normals();
+        return;
+    }
+
+    // 脏顶点周围的面法线
+    for (unsigned int v : dirty) {
+        for (auto fh : mesh.vf_range(Mesh::VertexHandle(v))) {
+            mesh.set_normal(fh, mesh.calc_face_normal(fh));
+        }
+    }
+    // 这些面的顶点即脏顶点的1环闭包
+    expandOneRing(mesh, dirty);
+    for (unsigned int v : dirty) {
+        Mesh::VertexHandle vh(v);
+        mesh.set_normal(vh, mesh.calc_vertex_normal(vh));
+    }
+}
+
+} // namespace meshcore
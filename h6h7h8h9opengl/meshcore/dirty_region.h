@@ -0,0 +1,32 @@
+#ifndef MESHCORE_DIRTY_REGION_H
+#define MESHCORE_DIRTY_REGION_H
+
+#include "mesh_types.h"
+#include <vector>
+
+namespace meshcore {
+
+// Operations that move a subset of vertices mark them through the per-vertex
+// dirty trait; normal and curvature updates then only touch the affected rings.
+// 只移动部分顶点的操作通过顶点的dirty标记记录它们；法线与曲率更新只处理受影响的邻域
+//
+// Above this fraction of dirty vertices a full update is cheaper than a local one
+// 脏区域超过该比例时整体更新更快
+const float kFullUpdateFraction = 0.25f;
+
+inline void markDirty(Mesh& mesh, Mesh::VertexHandle vh) { mesh.data(vh).dirty = true; }
+void markAllDirty(Mesh& mesh);          // Topology or all positions changed (拓扑或全部位置改变)
+void clearDirty(Mesh& mesh);
+void collectDirtyVertices(const Mesh& mesh, std::vector<unsigned int>& vertices); // Sorted indices (有序索引)
+
+// Replace the sorted set by its 1-ring closure (将有序顶点集扩展为其1环闭包)
+void expandOneRing(const Mesh& mesh, std::vector<unsigned int>& vertices);
+
+// Recompute face normals around dirty vertices and vertex normals on their 1-ring
+// closure; falls back to update_normals() for large regions. Dirty flags are kept.
+// 重新计算脏顶点周围的面法线及其1环闭包上的顶点法线；区域较大时整体更新。保留脏标记
+void updateDirtyNormals(Mesh& mesh);
+
+} // namespace meshcore
+
+#endif // MESHCORE_DIRTY_REGION_H
@@ -0,0 +1,68 @@
+#include "flat_mesh.h"
+
+namespace meshcore {
+
+void VertexCorners::build(const FlatMesh& mesh)
+{
+    const size_t nv = mesh.vertexCount();
+    const size_t nc = mesh.triangles.size();
+
+    // 计数排序：先统计每个顶点的角数，再按前缀和填充
+    offsets.assign(nv + 1, 0);
+    for (size_t c = 0; c < nc; ++c) {
+        ++offsets[mesh.triangles[c] + 1];
+    }
+    for (size_t v = 0; v < nv; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    corners.resize(nc);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t c = 0; c < nc; ++c) {
+        corners[fill[mesh.triangles[c]]++] = static_cast<unsigned int>(c);
+    }
+}
+
+void removeUnreferencedVertices(FlatMesh& mesh)
+{
+    const size_t nv = mesh.vertexCount();
+    std::vector<unsigned int> remap(nv, 0);
+    for (unsigned int v : mesh.triangles) remap[v] = 1;
+    unsigned int next = 0;
+    for (size_t v = 0; v < nv; ++v) {
+        if (!remap[v]) continue;
+        for (int k = 0; k < 3; ++k) mesh.positions[3 * next + k] = mesh.positions[3 * v + k];
+        remap[v] = next++;
+    }
+    mesh.positions.resize(3 * static_cast<size_t>(next));
+    for (unsigned int& v : mesh.triangles) v = remap[v];
+}
+
+void markBoundaryVertices(const FlatMesh& mesh, const VertexCorners& adjacency,
+                          std::vector<unsigned char>& isBoundary)
+{
+    const long long nv = static_cast<long long>(mesh.vertexCount());
+    const unsigned int* tri = mesh.triangles.data();
+    isBoundary.assign(nv, 0);
+
+    // 有向边v->a没有对应的a->v即为边界边（要求三角形朝向一致）
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        for (unsigned int i = adjacency.begin(v); i < adjacency.end(v) && !isBoundary[v]; ++i) {
+            const unsigned int c = adjacency.corners[i];
+            const unsigned int next = tri[c - c % 3 + (c + 1) % 3];
+            bool paired = false;
+            for (unsigned int j = adjacency.begin(v); j < adjacency.end(v); ++j) {
+                const unsigned int d = adjacency.corners[j];
+                if (tri[d - d % 3 + (d + 2) % 3] == next) {
+                    paired = true;
+                    break;
+                }
+            }
+            if (!paired) isBoundary[v] = 1;
+        }
+        // 孤立顶点不参与曲率计算，按边界处理
+        if (adjacency.begin(v) == adjacency.end(v)) isBoundary[v] = 1;
+    }
+}
+
+} // namespace meshcore
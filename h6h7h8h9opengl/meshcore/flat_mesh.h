@@ -0,0 +1,41 @@
+#ifndef MESHCORE_FLAT_MESH_H
+#define MESHCORE_FLAT_MESH_H
+
+#include <cstddef>
+#include <vector>
+
+namespace meshcore {
+
+// OpenMesh-free indexed triangle mesh used by the parallel kernels
+// 并行内核使用的扁平索引三角网格（不依赖OpenMesh）
+struct FlatMesh {
+    std::vector<float> positions;          // x,y,z per vertex (每个顶点的xyz)
+    std::vector<unsigned int> triangles;   // 3 vertex indices per triangle (每个三角形3个顶点索引)
+
+    size_t vertexCount() const { return positions.size() / 3; }
+    size_t triangleCount() const { return triangles.size() / 3; }
+};
+
+// Drop vertices no triangle refers to, keeping the order of the others
+// 删除未被任何三角形引用的顶点，其余顶点保持原有顺序
+void removeUnreferencedVertices(FlatMesh& mesh);
+
+// Vertex -> incident corners in CSR form; corner c is vertex c%3 of triangle c/3
+// 顶点到相邻角的CSR索引；角c为三角形c/3的第c%3个顶点
+struct VertexCorners {
+    std::vector<unsigned int> offsets;     // vertexCount+1 entries (顶点数+1项)
+    std::vector<unsigned int> corners;
+
+    void build(const FlatMesh& mesh);
+    unsigned int begin(size_t v) const { return offsets[v]; }
+    unsigned int end(size_t v) const { return offsets[v + 1]; }
+};
+
+// A vertex is on the boundary if one of its edges has a single incident triangle
+// 若顶点的某条边只属于一个三角形，则为边界顶点
+void markBoundaryVertices(const FlatMesh& mesh, const VertexCorners& adjacency,
+                          std::vector<unsigned char>& isBoundary);
+
+} // namespace meshcore
+
+#endif // MESHCORE_FLAT_MESH_H
@@ -0,0 +1,144 @@
+#include "jacobi_smoother.h"
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MESHCORE_HAS_AVX2_PATH 1
+#endif
+
+namespace meshcore {
+
+namespace {
+
+// 一次迭代所需的只读数据
+struct JacobiPass {
+    const unsigned int* offsets;
+    const unsigned int* columns;
+    const float* weights;
+    const float* scale;
+    const unsigned int* rows;       // 需要更新的内部顶点
+    long long rowCount;
+    float lambda;
+};
+
+void jacobiPassScalar(const JacobiPass& pass, const PositionArrays& in, PositionArrays& out)
+{
+    const float* x = in.x.data();
+    const float* y = in.y.data();
+    const float* z = in.z.data();
+    #pragma omp parallel for schedule(static)
+    for (long long r = 0; r < pass.rowCount; ++r) {
+        const unsigned int i = pass.rows[r];
+        float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+        for (unsigned int k = pass.offsets[i]; k < pass.offsets[i + 1]; ++k) {
+            const unsigned int j = pass.columns[k];
+            const float w = pass.weights[k];
+            sx += w * x[j];
+            sy += w * y[j];
+            sz += w * z[j];
+        }
+        const float s = pass.lambda * pass.scale[i];
+        out.x[i] = x[i] + s * (sx - x[i]);
+        out.y[i] = y[i] + s * (sy - y[i]);
+        out.z[i] = z[i] + s * (sz - z[i]);
+    }
+}
+
+#ifdef MESHCORE_HAS_AVX2_PATH
+
+__attribute__((target("avx2,fma")))
+inline float horizontalSum(__m256 v)
+{
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_movehdup_ps(lo));
+    return _mm_cvtss_f32(lo);
+}
+
+// 每行的邻点按8个一组用gather读取，尾部用掩码
+__attribute__((target("avx2,fma")))
+void jacobiPassAvx2(const JacobiPass& pass, const PositionArrays& in, PositionArrays& out)
+{
+    const float* x = in.x.data();
+    const float* y = in.y.data();
+    const float* z = in.z.data();
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    #pragma omp parallel for schedule(static)
+    for (long long r = 0; r < pass.rowCount; ++r) {
+        const unsigned int i = pass.rows[r];
+        unsigned int k = pass.offsets[i];
+        const unsigned int end = pass.offsets[i + 1];
+        __m256 sx = _mm256_setzero_ps(), sy = _mm256_setzero_ps(), sz = _mm256_setzero_ps();
+        for (; k + 8 <= end; k += 8) {
+            const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pass.columns + k));
+            const __m256 w = _mm256_loadu_ps(pass.weights + k);
+            sx = _mm256_fmadd_ps(w, _mm256_i32gather_ps(x, idx, 4), sx);
+            sy = _mm256_fmadd_ps(w, _mm256_i32gather_ps(y, idx, 4), sy);
+            sz = _mm256_fmadd_ps(w, _mm256_i32gather_ps(z, idx, 4), sz);
+        }
+        if (k < end) {
+            const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(end - k)), lane);
+            const __m256 maskPs = _mm256_castsi256_ps(mask);
+            const __m256i idx = _mm256_maskload_epi32(reinterpret_cast<const int*>(pass.columns + k), mask);
+            const __m256 w = _mm256_maskload_ps(pass.weights + k, mask);
+            const __m256 zero = _mm256_setzero_ps();
+            sx = _mm256_fmadd_ps(w, _mm256_mask_i32gather_ps(zero, x, idx, maskPs, 4), sx);
+            sy = _mm256_fmadd_ps(w, _mm256_mask_i32gather_ps(zero, y, idx, maskPs, 4), sy);
+            sz = _mm256_fmadd_ps(w, _mm256_mask_i32gather_ps(zero, z, idx, maskPs, 4), sz);
+        }
+        const float s = pass.lambda * pass.scale[i];
+        out.x[i] = x[i] + s * (horizontalSum(sx) - x[i]);
+        out.y[i] = y[i] + s * (horizontalSum(sy) - y[i]);
+        out.z[i] = z[i] + s * (horizontalSum(sz) - z[i]);
+    }
+}
+
+#endif // MESHCORE_HAS_AVX2_PATH
+
+} // namespace
+
+bool jacobiSmootherUsesAvx2()
+{
+#ifdef MESHCORE_HAS_AVX2_PATH
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void jacobiSmooth(const LaplacianOperator& op, const SmoothingStep& step,
+                  PositionArrays& positions, int iterations, float lambda)
+{
+    const size_t n = op.vertexCount();
+    if (n == 0 || iterations <= 0) return;
+
+    // 只更新有邻点的内部顶点；边界与孤立顶点在两个缓冲中保持相同
+    std::vector<unsigned int> rows;
+    rows.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!op.isBoundary[i] && op.begin(i) < op.end(i)) {
+            rows.push_back(static_cast<unsigned int>(i));
+        }
+    }
+
+    const JacobiPass pass = {op.offsets.data(), op.columns.data(), step.weights.data(), step.scale.data(),
+                             rows.data(), static_cast<long long>(rows.size()), lambda};
+    const bool avx2 = jacobiSmootherUsesAvx2();
+    PositionArrays back = positions;
+    for (int iter = 0; iter < iterations; ++iter) {
+#ifdef MESHCORE_HAS_AVX2_PATH
+        if (avx2) {
+            jacobiPassAvx2(pass, positions, back);
+        } else {
+            jacobiPassScalar(pass, positions, back);
+        }
+#else
+        (void)avx2;
+        jacobiPassScalar(pass, positions, back);
+#endif
+        std::swap(positions, back);
+    }
+}
+
+} // namespace meshcore
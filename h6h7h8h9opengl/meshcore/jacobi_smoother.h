@@ -0,0 +1,35 @@
+#ifndef MESHCORE_JACOBI_SMOOTHER_H
+#define MESHCORE_JACOBI_SMOOTHER_H
+
+#include "laplacian.h"
+#include <vector>
+
+namespace meshcore {
+
+// Vertex positions split per coordinate (按坐标分量拆分的顶点位置)
+struct PositionArrays {
+    std::vector<float> x, y, z;
+
+    void resize(size_t n) { x.resize(n); y.resize(n); z.resize(n); }
+    size_t size() const { return x.size(); }
+};
+
+// Row-normalized explicit step derived from a LaplacianOperator:
+// p_i' = p_i + lambda * scale_i * (sum_j weights_ij p_j - p_i); boundary rows stay fixed
+// 由拉普拉斯算子导出的逐行归一化显式步：p_i' = p_i + lambda * scale_i * (sum_j weights_ij p_j - p_i)，边界行不动
+struct SmoothingStep {
+    std::vector<float> weights;     // One per operator entry (与算子的每一项对应)
+    std::vector<float> scale;       // Step scale per row (每行步长缩放)
+};
+
+// Jacobi iterations over SoA positions with double buffering; rows run in parallel
+// and the neighbour gather uses AVX2/FMA when the CPU supports it
+// 在SoA位置数组上双缓冲执行Jacobi迭代；各行并行，CPU支持时邻点收集使用AVX2/FMA
+void jacobiSmooth(const LaplacianOperator& op, const SmoothingStep& step,
+                  PositionArrays& positions, int iterations, float lambda);
+
+bool jacobiSmootherUsesAvx2();      // Whether the AVX2 path is taken on this CPU (当前CPU是否使用AVX2路径)
+
+} // namespace meshcore
+
+#endif // MESHCORE_JACOBI_SMOOTHER_H
@@ -0,0 +1,212 @@
+#include "laplacian.h"
+#include "mesh_io.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace meshcore {
+
+namespace {
+
+inline float dot3(const float* a, const float* b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+} // namespace
+
+void triangleCorners(const float* p0, const float* p1, const float* p2, TriangleCorners& out)
+{
+    const float* p[3] = {p0, p1, p2};
+    for (int k = 0; k < 3; ++k) {
+        for (int a = 0; a < 3; ++a) {
+            out.edge[k][a] = p[(k + 2) % 3][a] - p[(k + 1) % 3][a];
+        }
+    }
+    const float (&e)[3][3] = out.edge;
+    const float cx = e[0][1] * e[1][2] - e[0][2] * e[1][1];
+    const float cy = e[0][2] * e[1][0] - e[0][0] * e[1][2];
+    const float cz = e[0][0] * e[1][1] - e[0][1] * e[1][0];
+    out.doubleArea = std::sqrt(cx * cx + cy * cy + cz * cz);
+    // 角k处两条边：p[k+1]-p[k] = e[k+2]，p[k+2]-p[k] = -e[k+1]
+    for (int k = 0; k < 3; ++k) {
+        out.edgeDot[k] = -dot3(e[(k + 2) % 3], e[(k + 1) % 3]);
+    }
+    if (out.degenerate()) {
+        std::fill(out.cot, out.cot + 3, 0.0f);
+        std::fill(out.area, out.area + 3, 0.0f);
+        return;
+    }
+    for (int k = 0; k < 3; ++k) {
+        out.cot[k] = out.edgeDot[k] / out.doubleArea;
+    }
+    const float* cot = out.cot;
+    const int obtuse = cot[0] < 0.0f ? 0 : (cot[1] < 0.0f ? 1 : (cot[2] < 0.0f ? 2 : -1));
+    for (int k = 0; k < 3; ++k) {
+        const int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+        if (obtuse < 0) {
+            // 非钝角三角形：Voronoi面积
+            out.area[k] = (dot3(e[k2], e[k2]) * cot[k2] + dot3(e[k1], e[k1]) * cot[k1]) / 8.0f;
+        } else {
+            out.area[k] = obtuse == k ? out.doubleArea / 4.0f : out.doubleArea / 8.0f;
+        }
+    }
+}
+
+void buildLaplacian(const FlatMesh& mesh, const VertexCorners& adjacency,
+                    LaplacianWeights weights, LaplacianOperator& op)
+{
+    const long long nv = static_cast<long long>(mesh.vertexCount());
+    const long long nt = static_cast<long long>(mesh.triangleCount());
+    const float* pos = mesh.positions.data();
+    const unsigned int* tri = mesh.triangles.data();
+    const bool cotangent = weights == LaplacianWeights::Cotangent;
+
+    op.weights = weights;
+    markBoundaryVertices(mesh, adjacency, op.isBoundary);
+
+    // 1. 三角形：每个角的余切与Meyer混合面积
+    std::vector<float> cornerCot, cornerArea;
+    if (cotangent) {
+        cornerCot.resize(nt * 3);
+        cornerArea.resize(nt * 3);
+        #pragma omp parallel for schedule(static)
+        for (long long t = 0; t < nt; ++t) {
+            TriangleCorners corners;
+            triangleCorners(pos + 3 * tri[3 * t], pos + 3 * tri[3 * t + 1], pos + 3 * tri[3 * t + 2], corners);
+            std::copy(corners.cot, corners.cot + 3, &cornerCot[3 * t]);
+            std::copy(corners.area, corners.area + 3, &cornerArea[3 * t]);
+        }
+    }
+
+    // 2. 顶点：每个角贡献两条边，按邻点排序后合并；暂存在与角一一对应的区段中
+    std::vector<std::pair<unsigned int, float>> scratch(adjacency.corners.size() * 2);
+    std::vector<unsigned int> rowLength(nv + 1, 0);
+    op.mixedArea.assign(nv, 0.0f);
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        auto* row = scratch.data() + 2 * adjacency.begin(v);
+        unsigned int count = 0;
+        float area = 0.0f;
+        for (unsigned int i = adjacency.begin(v); i < adjacency.end(v); ++i) {
+            const unsigned int c = adjacency.corners[i];
+            const unsigned int base = c - c % 3, k = c % 3;
+            const unsigned int c1 = base + (k + 1) % 3, c2 = base + (k + 2) % 3;
+            // 边(v, tri[c1])的对角为c2，边(v, tri[c2])的对角为c1
+            row[count++] = {tri[c1], cotangent ? cornerCot[c2] : 1.0f};
+            row[count++] = {tri[c2], cotangent ? cornerCot[c1] : 1.0f};
+            if (cotangent) area += cornerArea[c];
+        }
+        std::sort(row, row + count, [](const std::pair<unsigned int, float>& a, const std::pair<unsigned int, float>& b) {
+            return a.first < b.first;
+        });
+        unsigned int unique = 0;
+        for (unsigned int i = 0; i < count; ++i) {
+            if (unique > 0 && row[unique - 1].first == row[i].first) {
+                // 内部边出现两次：余切相加，均匀权重保持为1
+                if (cotangent) row[unique - 1].second += row[i].second;
+            } else {
+                row[unique++] = row[i];
+            }
+        }
+        rowLength[v + 1] = unique;
+        op.mixedArea[v] = area;
+    }
+
+    // 3. 前缀和后压缩为CSR
+    op.offsets.assign(nv + 1, 0);
+    for (long long v = 0; v < nv; ++v) {
+        op.offsets[v + 1] = op.offsets[v] + rowLength[v + 1];
+    }
+    op.columns.resize(op.offsets[nv]);
+    op.values.resize(op.offsets[nv]);
+    op.diagonal.assign(nv, 0.0f);
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        const auto* row = scratch.data() + 2 * adjacency.begin(v);
+        float sum = 0.0f;
+        for (unsigned int i = op.offsets[v], k = 0; i < op.offsets[v + 1]; ++i, ++k) {
+            op.columns[i] = row[k].first;
+            op.values[i] = row[k].second;
+            sum += row[k].second;
+        }
+        op.diagonal[v] = sum;
+    }
+}
+
+void buildLaplacian(const Mesh& openMesh, LaplacianWeights weights, LaplacianOperator& op)
+{
+    FlatMesh flat;
+    toFlatMesh(openMesh, flat);
+    VertexCorners adjacency;
+    adjacency.build(flat);
+    buildLaplacian(flat, adjacency, weights, op);
+}
+
+void LaplacianOperator::apply(const float* xyz, float* out) const
+{
+    const long long nv = static_cast<long long>(vertexCount());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < nv; ++i) {
+        float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+        for (unsigned int k = offsets[i]; k < offsets[i + 1]; ++k) {
+            const float* p = xyz + 3 * columns[k];
+            sx += values[k] * p[0];
+            sy += values[k] * p[1];
+            sz += values[k] * p[2];
+        }
+        out[3 * i] = sx - diagonal[i] * xyz[3 * i];
+        out[3 * i + 1] = sy - diagonal[i] * xyz[3 * i + 1];
+        out[3 * i + 2] = sz - diagonal[i] * xyz[3 * i + 2];
+    }
+}
+
+void assembleDirichletSystem(const LaplacianOperator& op, Eigen::SparseMatrix<float>& A)
+{
+    const int n = static_cast<int>(op.vertexCount());
+    A.resize(n, n);
+    // 每行的非零数：内部行为邻点项加对角项
+    Eigen::VectorXi rowSizes(n);
+    for (int i = 0; i < n; ++i) {
+        rowSizes[i] = op.isBoundary[i] ? 1 : static_cast<int>(op.end(i) - op.begin(i)) + 1;
+    }
+    // 先按行主序逐行插入（每行列号有序），再转换为列主序
+    Eigen::SparseMatrix<float, Eigen::RowMajor> rows(n, n);
+    rows.reserve(rowSizes);
+    for (int i = 0; i < n; ++i) {
+        if (op.isBoundary[i]) {
+            rows.insert(i, i) = 1.0f;
+            continue;
+        }
+        bool diagonalDone = false;
+        for (unsigned int k = op.begin(i); k < op.end(i); ++k) {
+            const int j = static_cast<int>(op.columns[k]);
+            if (!diagonalDone && j > i) {
+                rows.insert(i, i) = -op.diagonal[i];
+                diagonalDone = true;
+            }
+            rows.insert(i, j) = op.values[k];
+        }
+        if (!diagonalDone) rows.insert(i, i) = -op.diagonal[i];
+    }
+    rows.makeCompressed();
+    A = rows;
+    A.makeCompressed();
+}
+
+void meanCurvatureVectors(const LaplacianOperator& op, const float* xyz, std::vector<float>& out)
+{
+    const long long nv = static_cast<long long>(op.vertexCount());
+    out.resize(nv * 3);
+    op.apply(xyz, out.data());
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < nv; ++i) {
+        const float area = op.mixedArea[i];
+        const float scale = (op.isBoundary[i] || area < EPSILON) ? 0.0f : -0.5f / area;
+        out[3 * i] *= scale;
+        out[3 * i + 1] *= scale;
+        out[3 * i + 2] *= scale;
+    }
+}
+
+} // namespace meshcore
@@ -0,0 +1,74 @@
+#ifndef MESHCORE_LAPLACIAN_H
+#define MESHCORE_LAPLACIAN_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include <vector>
+#include <Eigen/Sparse>
+
+namespace meshcore {
+
+// Edge weights carried by the operator (算子使用的边权重)
+enum class LaplacianWeights {
+    Uniform,             // w_ij = 1 (均匀权重)
+    Cotangent            // w_ij = cot(alpha_ij) + cot(beta_ij) (余切权重)
+};
+
+// Mesh Laplacian assembled once into CSR: row i lists the 1-ring of vertex i with
+// raw (unclamped) weights, so (Lx)_i = sum_j w_ij (x_j - x_i). Shared by the smoothers
+// and the sparse solves; rebuild it when positions (cotangent) or topology change.
+// 一次组装为CSR的网格拉普拉斯算子：第i行为顶点i的1环邻点及原始（未截断）权重，
+// (Lx)_i = sum_j w_ij (x_j - x_i)。平滑与稀疏求解共用；位置（余切）或拓扑改变后需重建
+struct LaplacianOperator {
+    LaplacianWeights weights = LaplacianWeights::Uniform;
+    std::vector<unsigned int> offsets;     // vertexCount+1 row starts (行起始位置)
+    std::vector<unsigned int> columns;     // Neighbour indices, sorted per row (每行有序的邻点索引)
+    std::vector<float> values;             // w_ij per entry (每项的权重)
+    std::vector<float> diagonal;           // sum_j w_ij per row (每行权重和)
+    std::vector<float> mixedArea;          // Mixed Voronoi area per vertex (顶点混合面积)
+    std::vector<unsigned char> isBoundary; // Boundary or isolated vertex (边界或孤立顶点)
+
+    size_t vertexCount() const { return isBoundary.size(); }
+    size_t nonZeros() const { return columns.size(); }
+    unsigned int begin(size_t v) const { return offsets[v]; }
+    unsigned int end(size_t v) const { return offsets[v + 1]; }
+
+    // out = L x for interleaved xyz arrays (对交错存储的xyz数组计算 out = L x)
+    void apply(const float* xyz, float* out) const;
+};
+
+// Corner geometry of one triangle p0 p1 p2, shared by the cotangent operator and the
+// curvature estimators. Corner k sits at p[k] and faces edge[k] = p[k+2] - p[k+1].
+// Triangles with doubleArea at or below kMinDoubleArea are degenerate: cot and area are 0.
+// 三角形p0 p1 p2的角几何量，余切算子与曲率估计共用。角k位于p[k]，其对边edge[k] = p[k+2] - p[k+1]。
+// doubleArea不超过kMinDoubleArea的三角形视为退化，cot与area取0
+struct TriangleCorners {
+    static constexpr float kMinDoubleArea = 1e-12f;
+
+    float edge[3][3];      // Opposite edge of each corner (每个角的对边)
+    float edgeDot[3];      // Dot product of the two edges leaving the corner (从该角出发的两条边的点积)
+    float doubleArea;      // Twice the triangle area (三角形面积的两倍)
+    float cot[3];          // Cotangent of the interior angle (内角余切)
+    float area[3];         // Meyer mixed Voronoi area, obtuse triangles split 1/2 : 1/4 : 1/4 (Meyer混合面积，钝角三角形按1/2:1/4:1/4分配)
+
+    bool degenerate() const { return doubleArea <= kMinDoubleArea; }
+};
+
+void triangleCorners(const float* p0, const float* p1, const float* p2, TriangleCorners& out);
+
+void buildLaplacian(const FlatMesh& mesh, const VertexCorners& adjacency,
+                    LaplacianWeights weights, LaplacianOperator& op);
+void buildLaplacian(const Mesh& mesh, LaplacianWeights weights, LaplacianOperator& op);
+
+// Dirichlet system: boundary rows are identity, interior rows hold w_ij off the
+// diagonal and -sum_j w_ij on it (the form used by the minimal-surface and harmonic solves)
+// Dirichlet系统：边界行为单位行，内部行非对角为w_ij、对角为-sum_j w_ij（极小曲面与调和求解使用的形式）
+void assembleDirichletSystem(const LaplacianOperator& op, Eigen::SparseMatrix<float>& A);
+
+// Mean curvature normal H_i = -(Lp)_i / (2 A_i) of a cotangent operator, zero on the boundary
+// 余切算子给出的平均曲率法向 H_i = -(Lp)_i / (2 A_i)，边界为0
+void meanCurvatureVectors(const LaplacianOperator& op, const float* xyz, std::vector<float>& out);
+
+} // namespace meshcore
+
+#endif // MESHCORE_LAPLACIAN_H
@@ -0,0 +1,64 @@
+#include "lod_chain.h"
+#include <algorithm>
+#include <cmath>
+
+namespace meshcore {
+
+bool LodChain::build(const ProgressiveMesh& mesh, int levelCount, float keep)
+{
+    faces_.clear();
+    edges_.clear();
+    levels_.clear();
+    const size_t nv = mesh.vertexCount();
+    if (nv == 0 || levelCount < 1) return false;
+
+    // 包围球：包围盒中心到最远顶点
+    const std::vector<float>& p = mesh.positions();
+    float lo[3] = {p[0], p[1], p[2]}, hi[3] = {p[0], p[1], p[2]};
+    for (size_t i = 0; i < p.size(); ++i) {
+        lo[i % 3] = std::min(lo[i % 3], p[i]);
+        hi[i % 3] = std::max(hi[i % 3], p[i]);
+    }
+    for (int k = 0; k < 3; ++k) center_[k] = 0.5f * (lo[k] + hi[k]);
+    float r2 = 0.0f;
+    for (size_t v = 0; v < nv; ++v) {
+        const float dx = p[3 * v] - center_[0], dy = p[3 * v + 1] - center_[1], dz = p[3 * v + 2] - center_[2];
+        r2 = std::max(r2, dx * dx + dy * dy + dz * dz);
+    }
+    radius_ = std::sqrt(r2);
+
+    // 层级按折叠数递增，seek只向前应用其间的折叠
+    ProgressiveMesh::Level level;
+    mesh.reset(level);
+    float kept = 1.0f;
+    for (int k = 0; k < levelCount; ++k, kept *= keep) {
+        const size_t collapses = mesh.collapsesForRatio(1.0f - kept);
+        if (k > 0 && collapses == level.collapses) break;
+        mesh.seek(level, collapses);
+
+        Level range;
+        range.faceOffset = faces_.size();
+        range.faceCount = mesh.faceIndexCount(collapses);
+        range.edgeOffset = edges_.size();
+        range.edgeCount = mesh.edgeIndexCount(collapses);
+        faces_.insert(faces_.end(), level.faces.begin(), level.faces.begin() + range.faceCount);
+        edges_.insert(edges_.end(), level.edges.begin(), level.edges.begin() + range.edgeCount);
+        levels_.push_back(range);
+    }
+    return true;
+}
+
+int LodChain::select(float projectedRadius, float pixelsPerTriangle) const
+{
+    if (levels_.empty()) return 0;
+    const double area = 3.14159265358979 * double(projectedRadius) * projectedRadius;
+    const double wanted = 2.0 * area / std::max(pixelsPerTriangle, 1e-3f);
+    int chosen = 0;
+    for (size_t k = 1; k < levels_.size(); ++k) {
+        if (levels_[k].faceCount / 3 < wanted) break;
+        chosen = static_cast<int>(k);
+    }
+    return chosen;
+}
+
+} // namespace meshcore
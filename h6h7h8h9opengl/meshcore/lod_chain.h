@@ -0,0 +1,55 @@
+#ifndef MESHCORE_LOD_CHAIN_H
+#define MESHCORE_LOD_CHAIN_H
+
+#include "progressive_mesh.h"
+#include <cstddef>
+#include <vector>
+
+namespace meshcore {
+
+// Discrete levels of detail cut from one progressive mesh. All levels index the original
+// vertex buffer; their face and edge indices are concatenated into one buffer each, so a
+// renderer uploads everything once and picks a level by drawing another range.
+// 从一个渐进网格截取的离散细节层级。所有层级都索引原始顶点缓冲；各层级的面与边索引分别
+// 首尾相接存放在同一缓冲中，渲染时一次上传，切换层级只改变绘制的区间
+class LodChain {
+public:
+    struct Level {
+        size_t faceOffset = 0;          // First face index of the level (层级的第一个面索引)
+        size_t faceCount = 0;           // Face indices, 3 per triangle (面索引个数，每个三角形3个)
+        size_t edgeOffset = 0;
+        size_t edgeCount = 0;           // Edge indices, 2 per edge (边索引个数，每条边2个)
+    };
+
+    // Level k keeps about keep^k of the vertices; levels stop early when the sequence
+    // runs out. One forward pass over the collapse sequence.
+    // 第k层约保留keep^k的顶点；折叠序列用尽时提前结束。沿折叠序列单向扫描一遍
+    bool build(const ProgressiveMesh& mesh, int levelCount = kDefaultLevels, float keep = kDefaultKeep);
+
+    // Coarsest level that still spends `pixelsPerTriangle` of screen area per triangle on a
+    // bounding sphere projected to `projectedRadius` pixels (about half the triangles face away)
+    // 包围球投影半径为projectedRadius像素时，每个三角形仍分到不超过pixelsPerTriangle像素面积的最粗层级
+    //（约一半三角形背向视点）
+    int select(float projectedRadius, float pixelsPerTriangle = kDefaultPixelsPerTriangle) const;
+
+    const std::vector<unsigned int>& faces() const { return faces_; }
+    const std::vector<unsigned int>& edges() const { return edges_; }
+    const std::vector<Level>& levels() const { return levels_; }
+    const float* center() const { return center_; }     // Bounding sphere of the original (原始网格的包围球)
+    float radius() const { return radius_; }
+
+    static constexpr int kDefaultLevels = 6;
+    static constexpr float kDefaultKeep = 0.5f;
+    static constexpr float kDefaultPixelsPerTriangle = 4.0f;
+
+private:
+    std::vector<unsigned int> faces_;
+    std::vector<unsigned int> edges_;
+    std::vector<Level> levels_;         // Level 0 is the full mesh (第0层为完整网格)
+    float center_[3] = {0.0f, 0.0f, 0.0f};
+    float radius_ = 0.0f;
+};
+
+} // namespace meshcore
+
+#endif // MESHCORE_LOD_CHAIN_H
@@ -0,0 +1,268 @@
+#include "loop_subdivision.h"
+#include "mesh_io.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace meshcore {
+
+namespace {
+
+const unsigned int kNone = ~0u;
+
+// 半边h = 3t+k 属于三角形t，从角k指向角(k+1)%3
+inline unsigned int nextHalfedge(unsigned int h) { return h % 3 == 2 ? h - 2 : h + 1; }
+inline unsigned int prevHalfedge(unsigned int h) { return h % 3 == 0 ? h + 2 : h - 1; }
+
+// 一层网格的半边连接：逐层由索引运算推导，不再查找
+struct LoopTopology {
+    std::vector<unsigned int> twin;       // 反向半边，边界为kNone
+    std::vector<unsigned int> edge;       // 半边所属的无向边
+    std::vector<unsigned int> outgoing;   // 每个顶点的一条出半边，孤立顶点为kNone
+    size_t edgeCount = 0;
+};
+
+// 较小的半边代表其无向边；边界半边总是代表
+inline bool isPrimary(const LoopTopology& topo, unsigned int h)
+{
+    return topo.twin[h] == kNone || h < topo.twin[h];
+}
+
+// 控制网格的连接只查找一次：沿顶点的相邻角寻找反向半边，双方互认才配对（排除非流形边）
+void buildTopology(const FlatMesh& mesh, LoopTopology& topo)
+{
+    const unsigned int* tri = mesh.triangles.data();
+    const long long nh = static_cast<long long>(mesh.triangles.size());
+    VertexCorners adjacency;
+    adjacency.build(mesh);
+
+    std::vector<unsigned int> candidate(nh, kNone);
+    #pragma omp parallel for schedule(static)
+    for (long long h = 0; h < nh; ++h) {
+        const unsigned int a = tri[h];
+        const unsigned int b = tri[nextHalfedge(static_cast<unsigned int>(h))];
+        for (unsigned int i = adjacency.begin(b); i < adjacency.end(b); ++i) {
+            const unsigned int c = adjacency.corners[i];
+            if (tri[nextHalfedge(c)] == a) {
+                candidate[h] = c;
+                break;
+            }
+        }
+    }
+    topo.twin.resize(nh);
+    #pragma omp parallel for schedule(static)
+    for (long long h = 0; h < nh; ++h) {
+        const unsigned int c = candidate[h];
+        topo.twin[h] = (c != kNone && candidate[c] == static_cast<unsigned int>(h)) ? c : kNone;
+    }
+
+    topo.edge.resize(nh);
+    unsigned int edges = 0;
+    for (long long h = 0; h < nh; ++h) {
+        if (isPrimary(topo, static_cast<unsigned int>(h))) topo.edge[h] = edges++;
+    }
+    #pragma omp parallel for schedule(static)
+    for (long long h = 0; h < nh; ++h) {
+        if (!isPrimary(topo, static_cast<unsigned int>(h))) topo.edge[h] = topo.edge[topo.twin[h]];
+    }
+    topo.edgeCount = edges;
+
+    topo.outgoing.assign(mesh.vertexCount(), kNone);
+    for (long long h = 0; h < nh; ++h) topo.outgoing[tri[h]] = static_cast<unsigned int>(h);
+}
+
+// 细分一层。新顶点编号：旧顶点不变，边e的中点为V+e；三角形t的四个子三角形为4t..4t+3，
+// 子三角形c<3保留角c，子三角形3连接三个中点。旧半边h=(t,k)的前半段是子三角形k的半边0，
+// 后半段是子三角形(k+1)%3的半边2，因此新一层的反向半边、边编号和出半边都由索引直接写出。
+// last为true时不保存下一层的连接，只按需写出边索引
+void subdivideLevel(FlatMesh& mesh, LoopTopology& topo, bool last, std::vector<unsigned int>* edgesOut)
+{
+    const size_t nv = mesh.vertexCount();
+    const size_t nf = mesh.triangleCount();
+    const size_t ne = topo.edgeCount;
+    const unsigned int* tri = mesh.triangles.data();
+    const float* p = mesh.positions.data();
+
+    std::vector<float> positions(3 * (nv + ne));
+    std::vector<unsigned int> outgoing;
+    if (!last) outgoing.resize(nv + ne);
+
+    // 偶顶点：绕出半边旋转一圈收集1环；遇到边界则改用边界规则
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < static_cast<long long>(nv); ++v) {
+        float* out = &positions[3 * v];
+        const unsigned int h0 = topo.outgoing[v];
+        if (!last) outgoing[v] = h0 == kNone ? kNone : 12 * (h0 / 3) + 3 * (h0 % 3);
+        if (h0 == kNone) {
+            for (int k = 0; k < 3; ++k) out[k] = p[3 * v + k];
+            continue;
+        }
+        float sum[3] = {0.0f, 0.0f, 0.0f};
+        unsigned int valence = 0;
+        unsigned int boundaryA = kNone, boundaryB = kNone;
+        unsigned int h = h0;
+        do {
+            const float* q = p + 3 * tri[nextHalfedge(h)];
+            for (int k = 0; k < 3; ++k) sum[k] += q[k];
+            ++valence;
+            const unsigned int back = prevHalfedge(h);
+            if (topo.twin[back] == kNone) {
+                boundaryA = tri[back];
+                break;
+            }
+            h = topo.twin[back];
+        } while (h != h0);
+
+        if (boundaryA != kNone) {
+            h = h0;
+            while (topo.twin[h] != kNone) h = nextHalfedge(topo.twin[h]);
+            boundaryB = tri[nextHalfedge(h)];
+            const float* a = p + 3 * boundaryA;
+            const float* b = p + 3 * boundaryB;
+            for (int k = 0; k < 3; ++k) out[k] = 0.75f * p[3 * v + k] + 0.125f * (a[k] + b[k]);
+        } else {
+            const float beta = loopBeta(valence);
+            const float self = 1.0f - valence * beta;
+            for (int k = 0; k < 3; ++k) out[k] = self * p[3 * v + k] + beta * sum[k];
+        }
+    }
+
+    // 奇顶点：每条边由其代表半边计算一次
+    const long long nh = static_cast<long long>(mesh.triangles.size());
+    #pragma omp parallel for schedule(static)
+    for (long long hh = 0; hh < nh; ++hh) {
+        const unsigned int h = static_cast<unsigned int>(hh);
+        if (!isPrimary(topo, h)) continue;
+        const size_t m = nv + topo.edge[h];
+        if (!last) outgoing[m] = 12 * (h / 3) + 3 * ((h + 1) % 3) + 2;
+        const float* a = p + 3 * tri[h];
+        const float* b = p + 3 * tri[nextHalfedge(h)];
+        float* out = &positions[3 * m];
+        const unsigned int t = topo.twin[h];
+        if (t == kNone) {
+            for (int k = 0; k < 3; ++k) out[k] = 0.5f * (a[k] + b[k]);
+        } else {
+            const float* c = p + 3 * tri[prevHalfedge(h)];
+            const float* d = p + 3 * tri[prevHalfedge(t)];
+            for (int k = 0; k < 3; ++k) out[k] = 0.375f * (a[k] + b[k]) + 0.125f * (c[k] + d[k]);
+        }
+    }
+
+    // 拓扑：每个三角形独立写出四个子三角形及其12条半边的连接，同时写出边索引
+    std::vector<unsigned int> triangles(12 * nf);
+    std::vector<unsigned int> twin, edge;
+    if (!last) {
+        twin.resize(12 * nf);
+        edge.resize(12 * nf);
+    }
+    if (edgesOut) edgesOut->resize(2 * (2 * ne + 3 * nf));
+    unsigned int* edgeIndices = edgesOut ? edgesOut->data() : nullptr;
+
+    #pragma omp parallel for schedule(static)
+    for (long long tt = 0; tt < static_cast<long long>(nf); ++tt) {
+        const unsigned int t = static_cast<unsigned int>(tt);
+        const unsigned int base = 12 * t;
+        unsigned int v[3], m[3];
+        for (int k = 0; k < 3; ++k) {
+            v[k] = tri[3 * t + k];
+            m[k] = static_cast<unsigned int>(nv) + topo.edge[3 * t + k];
+        }
+        unsigned int* out = &triangles[base];
+        for (int c = 0; c < 3; ++c) {
+            out[3 * c] = v[c];
+            out[3 * c + 1] = m[c];
+            out[3 * c + 2] = m[(c + 2) % 3];
+        }
+        out[9] = m[0];
+        out[10] = m[1];
+        out[11] = m[2];
+
+        unsigned int childTwin[12], childEdge[12];
+        for (int c = 0; c < 3; ++c) {
+            // 半边0：旧半边c的前半段；半边2：旧半边(c+2)%3的后半段；半边1：与中心三角形共享
+            const unsigned int first = 3 * t + c;
+            const unsigned int second = 3 * t + (c + 2) % 3;
+            const unsigned int e0 = topo.edge[first], e2 = topo.edge[second];
+            const unsigned int ft = topo.twin[first], st = topo.twin[second];
+            childTwin[3 * c] = ft == kNone ? kNone : 12 * (ft / 3) + 3 * ((ft + 1) % 3) + 2;
+            childTwin[3 * c + 2] = st == kNone ? kNone : 12 * (st / 3) + 3 * (st % 3);
+            childTwin[3 * c + 1] = base + 9 + (c + 2) % 3;
+            childEdge[3 * c] = isPrimary(topo, first) ? 2 * e0 : 2 * e0 + 1;
+            childEdge[3 * c + 2] = isPrimary(topo, second) ? 2 * e2 + 1 : 2 * e2;
+            childEdge[3 * c + 1] = static_cast<unsigned int>(2 * ne) + 3 * t + (c + 2) % 3;
+        }
+        for (int j = 0; j < 3; ++j) {
+            childTwin[9 + j] = base + 3 * ((j + 1) % 3) + 1;
+            childEdge[9 + j] = static_cast<unsigned int>(2 * ne) + 3 * t + j;
+        }
+
+        for (unsigned int i = 0; i < 12; ++i) {
+            const unsigned int h = base + i;
+            if (!last) {
+                twin[h] = childTwin[i];
+                edge[h] = childEdge[i];
+            }
+            if (edgeIndices && (childTwin[i] == kNone || h < childTwin[i])) {
+                edgeIndices[2 * childEdge[i]] = out[i];
+                edgeIndices[2 * childEdge[i] + 1] = out[i % 3 == 2 ? i - 2 : i + 1];
+            }
+        }
+    }
+
+    mesh.positions.swap(positions);
+    mesh.triangles.swap(triangles);
+    topo.twin.swap(twin);
+    topo.edge.swap(edge);
+    topo.outgoing.swap(outgoing);
+    topo.edgeCount = 2 * ne + 3 * nf;
+}
+
+} // namespace
+
+float loopBeta(unsigned int valence)
+{
+    const double c = 0.375 + 0.25 * std::cos(2.0 * 3.14159265358979 / valence);
+    return static_cast<float>((0.625 - c * c) / valence);
+}
+
+bool loopSubdivide(FlatMesh& mesh, int levels, std::vector<unsigned int>* edges)
+{
+    if (mesh.vertexCount() == 0 || mesh.triangleCount() == 0 || levels <= 0) return false;
+
+    // 索引为unsigned int：最后一层的半边数不能溢出
+    const double finalHalfedges = static_cast<double>(mesh.triangles.size()) * std::pow(4.0, levels);
+    if (finalHalfedges >= static_cast<double>(std::numeric_limits<unsigned int>::max())) {
+        std::cerr << "Loop subdivision: " << levels << " levels exceed the 32-bit index range" << std::endl;
+        return false;
+    }
+
+    LoopTopology topo;
+    buildTopology(mesh, topo);
+    for (int level = 0; level < levels; ++level) {
+        const bool last = level + 1 == levels;
+        subdivideLevel(mesh, topo, last, last ? edges : nullptr);
+    }
+    return true;
+}
+
+bool loopSubdivide(Mesh& mesh, int levels)
+{
+    if (mesh.n_vertices() == 0 || levels <= 0) return false;
+
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    if (!loopSubdivide(flat, levels)) {
+        std::cerr << "Loop subdivision failed" << std::endl;
+        return false;
+    }
+    // fromFlatMesh更新法线并将全部顶点标记为脏（拓扑已改变）
+    Mesh result;
+    if (!fromFlatMesh(flat, result)) {
+        std::cerr << "Loop subdivision failed: could not rebuild the mesh" << std::endl;
+        return false;
+    }
+    mesh = std::move(result);
+    return true;
+}
+
+} // namespace meshcore
@@ -0,0 +1,32 @@
+#ifndef MESHCORE_LOOP_SUBDIVISION_H
+#define MESHCORE_LOOP_SUBDIVISION_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include <vector>
+
+namespace meshcore {
+
+// Uniform Loop subdivision on a flat triangle mesh. Half-edge twins are looked up once on the
+// control mesh; every level then derives the next level's twins, edge numbering and edge
+// midpoint indices by index arithmetic, one parallel pass per vertex, edge and triangle.
+// Old vertices keep their indices and the midpoint of edge e becomes vertex V+e. Boundary
+// edges and vertices use the boundary rules. `edges`, if given, receives the unique edges of
+// the final level (2 indices per edge), written in the same pass as the triangles.
+// 扁平三角网格上的均匀Loop细分。反向半边只在控制网格上查找一次；之后每层由索引运算推导下一层的
+// 反向半边、边编号与边中点编号，按顶点、边、三角形各并行扫描一遍。旧顶点保持编号，边e的中点成为
+// 顶点V+e。边界边与边界顶点使用边界规则。edges非空时写入最后一层的唯一边（每条边2个索引），
+// 与三角形在同一遍中写出
+bool loopSubdivide(FlatMesh& mesh, int levels, std::vector<unsigned int>* edges = nullptr);
+
+// Weight β(n) of each neighbour of an interior vertex of valence n (Loop 1987)
+// 价为n的内部顶点每个邻点的权重β(n)（Loop 1987）
+float loopBeta(unsigned int valence);
+
+// Apply uniform Loop subdivision through the flat kernel and refresh normals
+// 经由扁平内核执行均匀Loop细分并更新法线
+bool loopSubdivide(Mesh& mesh, int levels = 1);
+
+} // namespace meshcore
+
+#endif // MESHCORE_LOOP_SUBDIVISION_H
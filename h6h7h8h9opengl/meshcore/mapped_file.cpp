@@ -0,0 +1,74 @@
+#include "mapped_file.h"
+#include <fstream>
+#include <iterator>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace meshcore {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    opened_ = true;
+    if (size_ == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p != MAP_FAILED) {
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(p);
+        mapped_ = true;
+        return true;
+    }
+#endif
+    // 无法映射（或Windows）：整个读入内存
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        close();
+        return false;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.empty() ? nullptr : buffer_.data();
+    size_ = buffer_.size();
+    opened_ = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+#if !defined(_WIN32)
+    if (mapped_ && data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    opened_ = false;
+    std::vector<char>().swap(buffer_);
+}
+
+} // namespace meshcore
@@ -0,0 +1,36 @@
+#ifndef MESHCORE_MAPPED_FILE_H
+#define MESHCORE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace meshcore {
+
+// Read-only memory mapping of a whole file; falls back to reading into memory
+// 只读映射整个文件；无法映射时退化为读入内存
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);   // Map file, false if missing (映射文件，不存在时返回false)
+    void close();                         // Unmap (解除映射)
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isOpen() const { return data_ != nullptr || opened_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;                 // true: mmap, false: fallback buffer (是否为mmap)
+    bool opened_ = false;                 // Empty files are open but have no data (空文件也视为已打开)
+    std::vector<char> buffer_;
+};
+
+} // namespace meshcore
+
+#endif // MESHCORE_MAPPED_FILE_H
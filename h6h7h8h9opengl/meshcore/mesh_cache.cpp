@@ -0,0 +1,373 @@
+#include "mesh_cache.h"
+#include "meshcore_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace meshcore {
+
+namespace {
+
+// 各数据段，顺序即文件中的顺序
+enum Section {
+    VertexBlock,        // float[V*9]：位置|法线|高斯|平均|最大曲率
+    FaceIndices,        // uint32[faceIndexCount]：三角化后的面索引
+    EdgeIndices,        // uint32[edgeIndexCount]：边索引
+    HalfedgeTo,         // uint32[H]：半边指向的顶点
+    HalfedgeNext,       // uint32[H]：下一条半边
+    HalfedgeFace,       // int32[H]：所属面，边界为-1
+    VertexHalfedge,     // int32[V]：顶点的出半边，孤立点为-1
+    FaceHalfedge,       // uint32[F]：面的一条半边
+    EdgeCrease,         // uint8[H/2]：边是否为折痕（平滑组）
+    SectionCount
+};
+
+const char kMagic[8] = {'M', 'C', 'A', 'C', 'H', 'E', '\0', '\0'};
+const size_t kAlignment = 64;       // 段按缓存行对齐
+const size_t kHashWindow = 64 * 1024;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    float curvatureMin[CurvatureFields::FieldCount];
+    float curvatureMax[CurvatureFields::FieldCount];
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+    uint64_t vertexCount;
+    uint64_t faceCount;
+    uint64_t halfedgeCount;
+    uint64_t faceIndexCount;
+    uint64_t edgeIndexCount;
+    uint64_t offsets[SectionCount];
+};
+
+size_t alignUp(size_t value)
+{
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+size_t sectionBytes(int id, uint64_t v, uint64_t f, uint64_t h, uint64_t faceIdx, uint64_t edgeIdx)
+{
+    switch (id) {
+    case VertexBlock:    return v * kVertexBlockFloats * sizeof(float);
+    case FaceIndices:    return faceIdx * sizeof(uint32_t);
+    case EdgeIndices:    return edgeIdx * sizeof(uint32_t);
+    case HalfedgeTo:
+    case HalfedgeNext:
+    case HalfedgeFace:   return h * sizeof(uint32_t);
+    case VertexHalfedge: return v * sizeof(int32_t);
+    case FaceHalfedge:   return f * sizeof(uint32_t);
+    case EdgeCrease:     return h / 2;
+    default:             return 0;
+    }
+}
+
+} // namespace
+
+bool describeSource(const std::string& path, MeshCacheSource& source)
+{
+    std::error_code ec;
+    source.size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    source.mtime = static_cast<int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+    if (ec) return false;
+
+    // 只哈希首尾各64KB，避免为校验读取整个大文件
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::vector<char> window(kHashWindow);
+    uint64_t hash = kFnvOffset;
+    file.read(window.data(), window.size());
+    hash = fnv1a(window.data(), static_cast<size_t>(file.gcount()), hash);
+    if (source.size > kHashWindow) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(std::max<uint64_t>(kHashWindow, source.size - kHashWindow)));
+        file.read(window.data(), window.size());
+        hash = fnv1a(window.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    source.hash = hash;
+    return true;
+}
+
+std::string meshCachePath(const std::string& sourcePath)
+{
+    return sourcePath + ".mcache";
+}
+
+bool writeMeshCache(const std::string& cachePath, const std::string& sourcePath,
+                    const Mesh& mesh,
+                    const std::vector<unsigned int>& faceIndices,
+                    const std::vector<unsigned int>& edgeIndices)
+{
+    MeshCacheSource source;
+    if (!describeSource(sourcePath, source)) return false;
+
+    const size_t nv = mesh.n_vertices();
+    const size_t nf = mesh.n_faces();
+    const size_t nh = mesh.n_halfedges();
+
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kMeshCacheVersion;
+    header.sourceSize = source.size;
+    header.sourceMtime = source.mtime;
+    header.sourceHash = source.hash;
+    header.vertexCount = nv;
+    header.faceCount = nf;
+    header.halfedgeCount = nh;
+    header.faceIndexCount = faceIndices.size();
+    header.edgeIndexCount = edgeIndices.size();
+
+    size_t offset = alignUp(sizeof(CacheHeader));
+    for (int id = 0; id < SectionCount; ++id) {
+        header.offsets[id] = offset;
+        offset = alignUp(offset + sectionBytes(id, nv, nf, nh, faceIndices.size(), edgeIndices.size()));
+    }
+
+    // 按段准备数据
+    std::vector<float> vertexBlock(nv * kVertexBlockFloats, 0.0f);
+    for (auto vh : mesh.vertices()) {
+        const size_t i = vh.idx();
+        const auto& p = mesh.point(vh);
+        const auto& n = mesh.normal(vh);
+        for (int k = 0; k < 3; ++k) {
+            vertexBlock[i * 3 + k] = p[k];
+            vertexBlock[nv * 3 + i * 3 + k] = n[k];
+        }
+    }
+    // 曲率场来自顶点属性；范围即全体顶点的最值（边界顶点存的是内部最小值）
+    for (int f = 0; f < CurvatureFields::FieldCount; ++f) {
+        OpenMesh::VPropHandleT<float> handle;
+        if (nv == 0 || !getCurvatureProperty(mesh, f, handle)) continue;
+        const std::vector<float>& values = mesh.property(handle).data_vector();
+        std::copy(values.begin(), values.begin() + nv, vertexBlock.begin() + nv * (6 + f));
+        auto range = std::minmax_element(values.begin(), values.begin() + nv);
+        header.curvatureMin[f] = *range.first;
+        header.curvatureMax[f] = *range.second;
+    }
+
+    std::vector<uint32_t> heTo(nh), heNext(nh);
+    std::vector<int32_t> heFace(nh), vertexHe(nv);
+    std::vector<uint32_t> faceHe(nf);
+    for (size_t h = 0; h < nh; ++h) {
+        Mesh::HalfedgeHandle heh(static_cast<int>(h));
+        heTo[h] = mesh.to_vertex_handle(heh).idx();
+        heNext[h] = mesh.next_halfedge_handle(heh).idx();
+        heFace[h] = mesh.face_handle(heh).idx();
+    }
+    for (auto vh : mesh.vertices()) {
+        vertexHe[vh.idx()] = mesh.halfedge_handle(vh).idx();
+    }
+    for (auto fh : mesh.faces()) {
+        faceHe[fh.idx()] = mesh.halfedge_handle(fh).idx();
+    }
+    std::vector<uint8_t> creases(nh / 2, 0);
+    if (mesh.has_edge_status()) {
+        for (auto eh : mesh.edges()) {
+            creases[eh.idx()] = mesh.status(eh).feature() ? 1 : 0;
+        }
+    }
+
+    const void* sections[SectionCount] = {
+        vertexBlock.data(), faceIndices.data(), edgeIndices.data(),
+        heTo.data(), heNext.data(), heFace.data(), vertexHe.data(), faceHe.data(), creases.data()
+    };
+
+    const std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        const char zeros[kAlignment] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        size_t written = sizeof(header);
+        for (int id = 0; id < SectionCount; ++id) {
+            out.write(zeros, header.offsets[id] - written);
+            const size_t bytes = sectionBytes(id, nv, nf, nh, faceIndices.size(), edgeIndices.size());
+            out.write(static_cast<const char*>(sections[id]), bytes);
+            written = header.offsets[id] + bytes;
+        }
+        out.write(zeros, offset - written);
+        if (!out) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MappedMeshCache::open(const std::string& cachePath, const std::string& sourcePath)
+{
+    close();
+    MeshCacheSource source;
+    if (!describeSource(sourcePath, source)) return false;
+    if (!file_.open(cachePath)) return false;
+
+    if (file_.size() < sizeof(CacheHeader)) {
+        close();
+        return false;
+    }
+    CacheHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kMeshCacheVersion ||
+        header.sourceSize != source.size ||
+        header.sourceMtime != source.mtime ||
+        header.sourceHash != source.hash) {
+        close();
+        return false;
+    }
+    for (int id = 0; id < SectionCount; ++id) {
+        const uint64_t bytes = sectionBytes(id, header.vertexCount, header.faceCount, header.halfedgeCount,
+                                            header.faceIndexCount, header.edgeIndexCount);
+        if (header.offsets[id] % kAlignment != 0 || header.offsets[id] + bytes > file_.size()) {
+            close();
+            return false;
+        }
+    }
+
+    // 面、边索引会直接上传GPU，越界或不成组的索引都说明缓存已损坏，交由调用方重新解析OBJ
+    if (header.faceIndexCount % 3 != 0 || header.edgeIndexCount % 2 != 0 || header.halfedgeCount % 2 != 0) {
+        std::cerr << "Corrupt mesh cache " << cachePath << ": index counts are not whole triangles and edges" << std::endl;
+        close();
+        return false;
+    }
+    const uint64_t nv = header.vertexCount;
+    const uint32_t* faceIdx = reinterpret_cast<const uint32_t*>(file_.data() + header.offsets[FaceIndices]);
+    const uint32_t* edgeIdx = reinterpret_cast<const uint32_t*>(file_.data() + header.offsets[EdgeIndices]);
+    const auto outOfRange = [nv](uint32_t v) { return v >= nv; };
+    if (std::any_of(faceIdx, faceIdx + header.faceIndexCount, outOfRange) ||
+        std::any_of(edgeIdx, edgeIdx + header.edgeIndexCount, outOfRange)) {
+        std::cerr << "Corrupt mesh cache " << cachePath << ": vertex index out of range" << std::endl;
+        close();
+        return false;
+    }
+
+    vertexCount_ = header.vertexCount;
+    faceCount_ = header.faceCount;
+    halfedgeCount_ = header.halfedgeCount;
+    faceIndexCount_ = header.faceIndexCount;
+    edgeIndexCount_ = header.edgeIndexCount;
+    std::copy(header.curvatureMin, header.curvatureMin + CurvatureFields::FieldCount, curvatureMin_);
+    std::copy(header.curvatureMax, header.curvatureMax + CurvatureFields::FieldCount, curvatureMax_);
+    offsets_.assign(header.offsets, header.offsets + SectionCount);
+    return true;
+}
+
+void MappedMeshCache::close()
+{
+    file_.close();
+    vertexCount_ = faceCount_ = halfedgeCount_ = 0;
+    faceIndexCount_ = edgeIndexCount_ = 0;
+    std::fill(curvatureMin_, curvatureMin_ + CurvatureFields::FieldCount, 0.0f);
+    std::fill(curvatureMax_, curvatureMax_ + CurvatureFields::FieldCount, 0.0f);
+    offsets_.clear();
+}
+
+const char* MappedMeshCache::section(int id) const
+{
+    return file_.data() + offsets_[id];
+}
+
+const float* MappedMeshCache::positions() const
+{
+    return reinterpret_cast<const float*>(section(VertexBlock));
+}
+
+const unsigned int* MappedMeshCache::faceIndices() const
+{
+    return reinterpret_cast<const unsigned int*>(section(FaceIndices));
+}
+
+const unsigned int* MappedMeshCache::edgeIndices() const
+{
+    return reinterpret_cast<const unsigned int*>(section(EdgeIndices));
+}
+
+bool MappedMeshCache::restoreMesh(Mesh& mesh) const
+{
+    const size_t nv = vertexCount_, nf = faceCount_, nh = halfedgeCount_;
+    if (nv == 0) return false;
+
+    const uint32_t* heTo = reinterpret_cast<const uint32_t*>(section(HalfedgeTo));
+    const uint32_t* heNext = reinterpret_cast<const uint32_t*>(section(HalfedgeNext));
+    const int32_t* heFace = reinterpret_cast<const int32_t*>(section(HalfedgeFace));
+    const int32_t* vertexHe = reinterpret_cast<const int32_t*>(section(VertexHalfedge));
+    const uint32_t* faceHe = reinterpret_cast<const uint32_t*>(section(FaceHalfedge));
+
+    // 先检查索引范围，损坏的缓存不能进入网格
+    for (size_t h = 0; h < nh; ++h) {
+        if (heTo[h] >= nv || heNext[h] >= nh || heFace[h] < -1 || heFace[h] >= static_cast<int64_t>(nf)) {
+            std::cerr << "Corrupt mesh cache: halfedge " << h << " out of range" << std::endl;
+            return false;
+        }
+    }
+    for (size_t v = 0; v < nv; ++v) {
+        if (vertexHe[v] < -1 || vertexHe[v] >= static_cast<int64_t>(nh)) return false;
+    }
+    for (size_t f = 0; f < nf; ++f) {
+        if (faceHe[f] >= nh) return false;
+    }
+
+    mesh.clear();
+    mesh.reserve(nv, nh / 2, nf);
+
+    const float* p = positions();
+    const float* n = normals();
+    for (size_t v = 0; v < nv; ++v) {
+        auto vh = mesh.new_vertex(Mesh::Point(p[v * 3], p[v * 3 + 1], p[v * 3 + 2]));
+        mesh.set_normal(vh, Mesh::Normal(n[v * 3], n[v * 3 + 1], n[v * 3 + 2]));
+    }
+    // 边e的两条半边为2e（指向to）与2e+1（指向from）
+    for (size_t e = 0; e < nh / 2; ++e) {
+        mesh.new_edge(Mesh::VertexHandle(heTo[2 * e + 1]), Mesh::VertexHandle(heTo[2 * e]));
+    }
+    for (size_t f = 0; f < nf; ++f) {
+        mesh.set_halfedge_handle(mesh.new_face(), Mesh::HalfedgeHandle(faceHe[f]));
+    }
+    for (size_t h = 0; h < nh; ++h) {
+        Mesh::HalfedgeHandle heh(static_cast<int>(h));
+        mesh.set_next_halfedge_handle(heh, Mesh::HalfedgeHandle(heNext[h]));
+        if (heFace[h] >= 0) {
+            mesh.set_face_handle(heh, Mesh::FaceHandle(heFace[h]));
+        }
+    }
+    for (size_t v = 0; v < nv; ++v) {
+        if (vertexHe[v] >= 0) {
+            mesh.set_halfedge_handle(Mesh::VertexHandle(static_cast<int>(v)), Mesh::HalfedgeHandle(vertexHe[v]));
+        }
+    }
+    mesh.update_face_normals();
+
+    const uint8_t* creases = reinterpret_cast<const uint8_t*>(section(EdgeCrease));
+    if (std::any_of(creases, creases + nh / 2, [](uint8_t c) { return c != 0; })) {
+        mesh.request_edge_status();
+        for (size_t e = 0; e < nh / 2; ++e) {
+            mesh.status(Mesh::EdgeHandle(static_cast<int>(e))).set_feature(creases[e] != 0);
+        }
+    }
+
+    // 曲率场直接拷入顶点属性，无需重新计算
+    for (int f = 0; f < CurvatureFields::FieldCount; ++f) {
+        OpenMesh::VPropHandleT<float> handle;
+        curvatureProperty(mesh, f, handle);
+        const float* c = curvature(f);
+        std::copy(c, c + nv, mesh.property(handle).data_vector().begin());
+    }
+    return true;
+}
+
+} // namespace meshcore
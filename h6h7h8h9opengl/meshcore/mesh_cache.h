@@ -0,0 +1,86 @@
+#ifndef MESHCORE_MESH_CACHE_H
+#define MESHCORE_MESH_CACHE_H
+
+#include "mesh_types.h"
+#include "mapped_file.h"
+#include "curvature.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace meshcore {
+
+// Binary mesh cache (.mcache): render-ready arrays plus half-edge connectivity.
+// The vertex block is laid out exactly like the viewer's VBO:
+// [positions xyz | normals xyz | gaussian | mean | max], so it can be uploaded straight from the mapping.
+// 二进制网格缓存(.mcache)：可直接渲染的数组与半边连接关系。
+// 顶点块与查看器VBO布局一致：[位置 | 法线 | 高斯 | 平均 | 最大曲率]，可直接从映射内存上传GPU。
+const uint32_t kMeshCacheVersion = 4;
+
+// Floats per vertex in the vertex block (顶点块中每个顶点的浮点数)
+const size_t kVertexBlockFloats = 3 + 3 + CurvatureFields::FieldCount;
+
+// Identity of the source file used for invalidation (用于失效判断的源文件标识)
+struct MeshCacheSource {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;      // FNV-1a of the first and last 64KB (首尾64KB的FNV-1a哈希)
+};
+
+bool describeSource(const std::string& path, MeshCacheSource& source);
+
+// Cache file next to the source: "<source>.mcache" (源文件旁的缓存路径)
+std::string meshCachePath(const std::string& sourcePath);
+
+// Write the cache atomically (temp file + rename) (原子写入缓存：临时文件+重命名)
+bool writeMeshCache(const std::string& cachePath, const std::string& sourcePath,
+                    const Mesh& mesh,
+                    const std::vector<unsigned int>& faceIndices,
+                    const std::vector<unsigned int>& edgeIndices);
+
+// Memory-mapped view of a valid cache (有效缓存的内存映射视图)
+class MappedMeshCache {
+public:
+    // Map and validate against the source; false if missing, stale or corrupt. Face and
+    // edge indices must form whole triangles and edges and stay below vertexCount()
+    // 映射并校验源文件；缺失、过期或损坏时返回false。面与边索引须成组（三角形、边）且小于vertexCount()
+    bool open(const std::string& cachePath, const std::string& sourcePath);
+    void close();
+
+    size_t vertexCount() const { return vertexCount_; }
+    size_t faceCount() const { return faceCount_; }
+    size_t faceIndexCount() const { return faceIndexCount_; }
+    size_t edgeIndexCount() const { return edgeIndexCount_; }
+    float curvatureMin(int field) const { return curvatureMin_[field]; }   // Interior range per field (各曲率场的内部范围)
+    float curvatureMax(int field) const { return curvatureMax_[field]; }
+
+    const float* vertexBlock() const { return positions(); }          // positions|normals|curvatures (顶点块)
+    size_t vertexBlockBytes() const { return vertexCount_ * kVertexBlockFloats * sizeof(float); }
+    const float* positions() const;
+    const float* normals() const { return positions() + vertexCount_ * 3; }
+    const float* curvature(int field) const { return positions() + vertexCount_ * (6 + field); }
+    const unsigned int* faceIndices() const;
+    const unsigned int* edgeIndices() const;
+
+    // Rebuild the half-edge mesh directly from the stored connectivity; curvature fields
+    // go into the "curvature:*" vertex properties and crease tags into the edge status
+    // 由存储的连接关系直接重建半边网格；曲率场写入"curvature:*"顶点属性，折痕标记写入边状态
+    bool restoreMesh(Mesh& mesh) const;
+
+private:
+    const char* section(int id) const;
+
+    MappedFile file_;
+    size_t vertexCount_ = 0;
+    size_t faceCount_ = 0;
+    size_t halfedgeCount_ = 0;
+    size_t faceIndexCount_ = 0;
+    size_t edgeIndexCount_ = 0;
+    float curvatureMin_[CurvatureFields::FieldCount] = {};
+    float curvatureMax_[CurvatureFields::FieldCount] = {};
+    std::vector<uint64_t> offsets_;     // Section offsets within the file (各段在文件中的偏移)
+};
+
+} // namespace meshcore
+
+#endif // MESHCORE_MESH_CACHE_H
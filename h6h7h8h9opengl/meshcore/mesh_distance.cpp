@@ -0,0 +1,216 @@
+#include "mesh_distance.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace meshcore {
+
+namespace {
+
+struct Vec3 {
+    double x, y, z;
+};
+
+inline Vec3 sub(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline double dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 at(const float* p, unsigned int v) { return {p[3 * v], p[3 * v + 1], p[3 * v + 2]}; }
+
+// 点到三角形的最近距离平方（Ericson《Real-Time Collision Detection》5.1.5，按Voronoi区域分类）
+double pointTriangleDistance2(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c)
+{
+    const Vec3 ab = sub(b, a), ac = sub(c, a), ap = sub(p, a);
+    const double d1 = dot(ab, ap), d2 = dot(ac, ap);
+    auto dist2 = [&](const Vec3& q) { const Vec3 d = sub(p, q); return dot(d, d); };
+    if (d1 <= 0.0 && d2 <= 0.0) return dist2(a);
+
+    const Vec3 bp = sub(p, b);
+    const double d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3) return dist2(b);
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        const double v = d1 / (d1 - d3);
+        return dist2({a.x + v * ab.x, a.y + v * ab.y, a.z + v * ab.z});
+    }
+
+    const Vec3 cp = sub(p, c);
+    const double d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6) return dist2(c);
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        const double w = d2 / (d2 - d6);
+        return dist2({a.x + w * ac.x, a.y + w * ac.y, a.z + w * ac.z});
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+        const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return dist2({b.x + w * (c.x - b.x), b.y + w * (c.y - b.y), b.z + w * (c.z - b.z)});
+    }
+
+    const double denom = 1.0 / (va + vb + vc);
+    const double v = vb * denom, w = vc * denom;
+    return dist2({a.x + ab.x * v + ac.x * w, a.y + ab.y * v + ac.y * w, a.z + ab.z * v + ac.z * w});
+}
+
+// 三角形按包围盒登记到均匀网格（CSR），单元数约等于三角形数
+class TriangleGrid {
+public:
+    explicit TriangleGrid(const FlatMesh& mesh) : mesh_(mesh)
+    {
+        const float* p = mesh.positions.data();
+        const size_t nt = mesh.triangleCount();
+        lo_ = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        Vec3 hi = {-lo_.x, -lo_.y, -lo_.z};
+        for (unsigned int v : mesh.triangles) {
+            const Vec3 q = at(p, v);
+            lo_ = {std::min(lo_.x, q.x), std::min(lo_.y, q.y), std::min(lo_.z, q.z)};
+            hi = {std::max(hi.x, q.x), std::max(hi.y, q.y), std::max(hi.z, q.z)};
+        }
+        const Vec3 extent = sub(hi, lo_);
+        const double volume = std::max(extent.x, 1e-12) * std::max(extent.y, 1e-12) * std::max(extent.z, 1e-12);
+        cell_ = std::cbrt(volume / std::max<size_t>(nt, 1));
+        cell_ = std::max(cell_, 1e-6 * std::max({extent.x, extent.y, extent.z, 1e-12}));
+        dims_[0] = std::max(1, static_cast<int>(std::ceil(extent.x / cell_)));
+        dims_[1] = std::max(1, static_cast<int>(std::ceil(extent.y / cell_)));
+        dims_[2] = std::max(1, static_cast<int>(std::ceil(extent.z / cell_)));
+        hi_ = {lo_.x + dims_[0] * cell_, lo_.y + dims_[1] * cell_, lo_.z + dims_[2] * cell_};
+
+        // 两遍：计数、填充
+        offsets_.assign(static_cast<size_t>(dims_[0]) * dims_[1] * dims_[2] + 1, 0);
+        for (int pass = 0; pass < 2; ++pass) {
+            std::vector<unsigned int> fill;
+            if (pass == 1) {
+                for (size_t i = 1; i < offsets_.size(); ++i) offsets_[i] += offsets_[i - 1];
+                triangles_.resize(offsets_.back());
+                fill.assign(offsets_.begin(), offsets_.end() - 1);
+            }
+            for (size_t t = 0; t < nt; ++t) {
+                int lo[3], hi[3];
+                triangleCells(t, lo, hi);
+                for (int z = lo[2]; z <= hi[2]; ++z)
+                    for (int y = lo[1]; y <= hi[1]; ++y)
+                        for (int x = lo[0]; x <= hi[0]; ++x) {
+                            const size_t c = index(x, y, z);
+                            if (pass == 0) ++offsets_[c + 1];
+                            else triangles_[fill[c]++] = static_cast<unsigned int>(t);
+                        }
+            }
+        }
+    }
+
+    // 由近到远逐层扫描单元；第r层之外的单元距离至少为r个单元减去点到网格外的距离
+    double distance2(const Vec3& q) const
+    {
+        const float* p = mesh_.positions.data();
+        const unsigned int* tri = mesh_.triangles.data();
+        int center[3];
+        cellOf(q, center);
+        const double dx = std::max({lo_.x - q.x, 0.0, q.x - hi_.x});
+        const double dy = std::max({lo_.y - q.y, 0.0, q.y - hi_.y});
+        const double dz = std::max({lo_.z - q.z, 0.0, q.z - hi_.z});
+        const double outside = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const int maxRing = std::max({dims_[0], dims_[1], dims_[2]});
+
+        double best = std::numeric_limits<double>::max();
+        for (int r = 0; r <= maxRing; ++r) {
+            for (int z = center[2] - r; z <= center[2] + r; ++z) {
+                if (z < 0 || z >= dims_[2]) continue;
+                for (int y = center[1] - r; y <= center[1] + r; ++y) {
+                    if (y < 0 || y >= dims_[1]) continue;
+                    const bool shellYZ = std::abs(z - center[2]) == r || std::abs(y - center[1]) == r;
+                    for (int x = center[0] - r; x <= center[0] + r; x += (shellYZ || r == 0) ? 1 : 2 * r) {
+                        if (x < 0 || x >= dims_[0]) continue;
+                        const size_t c = index(x, y, z);
+                        for (unsigned int i = offsets_[c]; i < offsets_[c + 1]; ++i) {
+                            const unsigned int* t = tri + 3 * triangles_[i];
+                            best = std::min(best, pointTriangleDistance2(q, at(p, t[0]), at(p, t[1]), at(p, t[2])));
+                        }
+                    }
+                }
+            }
+            const double reach = r * cell_ - outside;
+            if (reach > 0.0 && best <= reach * reach) break;
+        }
+        return best;
+    }
+
+private:
+    size_t index(int x, int y, int z) const
+    {
+        return (static_cast<size_t>(z) * dims_[1] + y) * dims_[0] + x;
+    }
+    void cellOf(const Vec3& q, int cell[3]) const
+    {
+        const double c[3] = {(q.x - lo_.x) / cell_, (q.y - lo_.y) / cell_, (q.z - lo_.z) / cell_};
+        for (int k = 0; k < 3; ++k) {
+            cell[k] = std::min(std::max(static_cast<int>(std::floor(c[k])), 0), dims_[k] - 1);
+        }
+    }
+    void triangleCells(size_t t, int lo[3], int hi[3]) const
+    {
+        const float* p = mesh_.positions.data();
+        for (int k = 0; k < 3; ++k) {
+            int cell[3];
+            cellOf(at(p, mesh_.triangles[3 * t + k]), cell);
+            for (int d = 0; d < 3; ++d) {
+                lo[d] = k == 0 ? cell[d] : std::min(lo[d], cell[d]);
+                hi[d] = k == 0 ? cell[d] : std::max(hi[d], cell[d]);
+            }
+        }
+    }
+
+    const FlatMesh& mesh_;
+    Vec3 lo_, hi_;
+    double cell_;
+    int dims_[3];
+    std::vector<unsigned int> offsets_;
+    std::vector<unsigned int> triangles_;
+};
+
+} // namespace
+
+SurfaceDistance surfaceDistance(const FlatMesh& from, const FlatMesh& to)
+{
+    SurfaceDistance result;
+    if (from.vertexCount() == 0 || to.triangleCount() == 0) return result;
+    const TriangleGrid grid(to);
+    const float* p = from.positions.data();
+    const long long nv = static_cast<long long>(from.vertexCount());
+    const long long nt = static_cast<long long>(from.triangleCount());
+
+    double maximum = 0.0, sum = 0.0;
+    #pragma omp parallel for schedule(dynamic, 256) reduction(max : maximum) reduction(+ : sum)
+    for (long long s = 0; s < nv + nt; ++s) {
+        Vec3 q;
+        if (s < nv) {
+            q = at(p, static_cast<unsigned int>(s));
+        } else {
+            const unsigned int* t = from.triangles.data() + 3 * (s - nv);
+            const Vec3 a = at(p, t[0]), b = at(p, t[1]), c = at(p, t[2]);
+            q = {(a.x + b.x + c.x) / 3.0, (a.y + b.y + c.y) / 3.0, (a.z + b.z + c.z) / 3.0};
+        }
+        const double d = std::sqrt(grid.distance2(q));
+        maximum = std::max(maximum, d);
+        sum += d;
+    }
+    result.maximum = maximum;
+    result.mean = sum / static_cast<double>(nv + nt);
+    return result;
+}
+
+SurfaceDistance hausdorffDistance(const FlatMesh& a, const FlatMesh& b)
+{
+    const SurfaceDistance ab = surfaceDistance(a, b);
+    const SurfaceDistance ba = surfaceDistance(b, a);
+    const double na = static_cast<double>(a.vertexCount() + a.triangleCount());
+    const double nb = static_cast<double>(b.vertexCount() + b.triangleCount());
+    SurfaceDistance result;
+    result.maximum = std::max(ab.maximum, ba.maximum);
+    result.mean = na + nb > 0.0 ? (ab.mean * na + ba.mean * nb) / (na + nb) : 0.0;
+    return result;
+}
+
+} // namespace meshcore
@@ -0,0 +1,26 @@
+#ifndef MESHCORE_MESH_DISTANCE_H
+#define MESHCORE_MESH_DISTANCE_H
+
+#include "flat_mesh.h"
+
+namespace meshcore {
+
+// Distances from sample points of one surface to the closest point of another
+// 一个曲面的采样点到另一曲面最近点的距离
+struct SurfaceDistance {
+    double maximum = 0.0;           // Hausdorff distance (Hausdorff距离)
+    double mean = 0.0;              // Mean over all samples (全部采样点的平均)
+};
+
+// One-sided: vertices and triangle centroids of `from`, measured against the triangles of
+// `to` through a uniform grid; samples run in parallel
+// 单向：from的顶点与三角形重心到to的三角形的距离，用均匀网格加速，采样点并行
+SurfaceDistance surfaceDistance(const FlatMesh& from, const FlatMesh& to);
+
+// Symmetric: the larger maximum and the sample-weighted mean of both directions
+// 双向：取两个方向中较大的最大值，平均值按采样数加权
+SurfaceDistance hausdorffDistance(const FlatMesh& a, const FlatMesh& b);
+
+} // namespace meshcore
+
+#endif // MESHCORE_MESH_DISTANCE_H
@@ -0,0 +1,231 @@
+#include "mesh_io.h"
+#include "dirty_region.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <OpenMesh/Core/IO/MeshIO.hh>
+
+namespace meshcore {
+
+static bool hasObjExtension(const std::string& path)
+{
+    if (path.size() < 4) return false;
+    std::string ext = path.substr(path.size() - 4);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".obj";
+}
+
+bool loadMesh(Mesh& mesh, const std::string& path)
+{
+    if (hasObjExtension(path)) {
+        ObjData data;
+        if (!readObj(path, data) || !buildMesh(data, mesh)) {
+            return false;
+        }
+        mesh.update_normals();
+        return true;
+    }
+
+    OpenMesh::IO::Options opt = OpenMesh::IO::Options::Default;
+    if (!OpenMesh::IO::read_mesh(mesh, path, opt)) {
+        return false;
+    }
+    mesh.update_normals();
+    return true;
+}
+
+// 平滑组不同的两个面之间、或两个不平滑的OBJ面之间的边为折痕；同一多边形三角化出的内部边除外
+static void tagSmoothingGroupCreases(Mesh& mesh, const std::vector<unsigned int>& groups,
+                                     const std::vector<unsigned int>& sourceFace)
+{
+    mesh.request_edge_status();
+    size_t creases = 0;
+    for (auto eh : mesh.edges()) {
+        if (mesh.is_boundary(eh)) continue;
+        const unsigned int fa = sourceFace[mesh.face_handle(mesh.halfedge_handle(eh, 0)).idx()];
+        const unsigned int fb = sourceFace[mesh.face_handle(mesh.halfedge_handle(eh, 1)).idx()];
+        const bool sharp = groups[fa] != groups[fb] || (groups[fa] == 0 && fa != fb);
+        mesh.status(eh).set_feature(sharp);
+        if (sharp) ++creases;
+    }
+    if (creases == 0) mesh.release_edge_status();
+}
+
+bool buildMesh(const ObjData& data, Mesh& mesh)
+{
+    mesh.clear();
+    const size_t vertexCount = data.vertexCount();
+    const size_t faceCount = data.faceCount();
+    if (vertexCount == 0) return false;
+
+    // 闭合流形网格中 E ≈ V + F
+    mesh.reserve(vertexCount, vertexCount + faceCount, faceCount);
+    const float* p = data.positions.data();
+    for (size_t i = 0; i < vertexCount; ++i, p += 3) {
+        mesh.add_vertex(Mesh::Point(p[0], p[1], p[2]));
+    }
+
+    std::vector<Mesh::VertexHandle> handles;
+    std::vector<unsigned int> sourceFace;       // 半边网格的面 -> OBJ面（多边形会被扇形三角化）
+    if (!data.faceGroups.empty()) sourceFace.reserve(faceCount);
+    size_t skipped = 0, duplicated = 0;
+    for (size_t f = 0; f < faceCount; ++f) {
+        handles.clear();
+        for (unsigned int c = data.faceOffsets[f]; c < data.faceOffsets[f + 1]; ++c) {
+            handles.push_back(Mesh::VertexHandle(static_cast<int>(data.faceVertices[c])));
+        }
+
+        // 跳过含重复顶点的退化面
+        bool degenerate = false;
+        for (size_t i = 0; i < handles.size() && !degenerate; ++i) {
+            for (size_t j = i + 1; j < handles.size(); ++j) {
+                if (handles[i] == handles[j]) { degenerate = true; break; }
+            }
+        }
+        if (degenerate) {
+            ++skipped;
+            continue;
+        }
+
+        if (!mesh.add_face(handles).is_valid()) {
+            // 非流形面：与OpenMesh导入器一致，复制顶点后单独加入
+            for (auto& vh : handles) {
+                vh = mesh.add_vertex(mesh.point(vh));
+            }
+            mesh.add_face(handles);
+            ++duplicated;
+        }
+        if (!data.faceGroups.empty()) sourceFace.resize(mesh.n_faces(), static_cast<unsigned int>(f));
+    }
+    if (!data.faceGroups.empty()) tagSmoothingGroupCreases(mesh, data.faceGroups, sourceFace);
+
+    if (skipped > 0 || duplicated > 0) {
+        std::cerr << "OBJ import: skipped " << skipped << " degenerate faces, "
+                  << duplicated << " non-manifold faces got duplicated vertices" << std::endl;
+    }
+    return mesh.n_faces() > 0;
+}
+
+bool saveMesh(const Mesh& mesh, const std::string& path)
+{
+    OpenMesh::IO::Options opt = OpenMesh::IO::Options::Default;
+    if (mesh.has_vertex_texcoords2D()) {
+        opt += OpenMesh::IO::Options::VertexTexCoord;
+    }
+    return OpenMesh::IO::write_mesh(mesh, path, opt);
+}
+
+// 计算网格的边界框
+void computeBoundingBox(const Mesh& mesh, Mesh::Point& min, Mesh::Point& max)
+{
+    if (mesh.n_vertices() > 0) {
+        min = max = mesh.point(*mesh.vertices_begin());
+        for (auto vh : mesh.vertices()) {
+            min.minimize(mesh.point(vh));
+            max.maximize(mesh.point(vh));
+        }
+    }
+}
+
+// 中心化并缩放网格
+void centerAndScaleMesh(Mesh& mesh, const Mesh::Point& center, float maxSize)
+{
+    float scaleFactor = 2.0f / maxSize;
+    for (auto vh : mesh.vertices()) {
+        Mesh::Point p = mesh.point(vh);
+        p = (p - center) * scaleFactor;
+        mesh.set_point(vh, p);
+    }
+}
+
+float normalizeMesh(Mesh& mesh)
+{
+    if (mesh.n_vertices() == 0) return 0.0f;
+
+    Mesh::Point min, max;
+    computeBoundingBox(mesh, min, max);
+    
+    Mesh::Point center = (min + max) * 0.5f;
+    Mesh::Point size = max - min;
+    float maxSize = std::max({size[0], size[1], size[2]});
+    if (maxSize > 0.0f) {
+        centerAndScaleMesh(mesh, center, maxSize);
+    }
+    return maxSize;
+}
+
+// 准备面索引数据（包括三角剖分）
+void buildFaceIndices(const Mesh& mesh, std::vector<unsigned int>& faces)
+{
+    faces.clear();
+    faces.reserve(mesh.n_faces() * 3);
+    for (auto fh : mesh.faces()) {
+        auto fv_it = mesh.fv_ccwbegin(fh);
+        int vertexCount = mesh.valence(fh);
+        
+        if (vertexCount < 3) {
+            std::cerr << "Face with less than 3 vertices, skipping" << std::endl;
+            continue;
+        }
+        
+        if (vertexCount == 3) {
+            faces.push_back((*fv_it).idx()); ++fv_it;
+            faces.push_back((*fv_it).idx()); ++fv_it;
+            faces.push_back((*fv_it).idx());
+        }
+        else {
+            unsigned int centerIdx = (*fv_it).idx();
+            ++fv_it;
+            unsigned int prevIdx = (*fv_it).idx();
+            ++fv_it;
+            
+            for (int i = 2; i < vertexCount; i++) {
+                unsigned int currentIdx = (*fv_it).idx();
+                faces.push_back(centerIdx);
+                faces.push_back(prevIdx);
+                faces.push_back(currentIdx);
+                prevIdx = currentIdx;
+                ++fv_it;
+            }
+        }
+    }
+}
+
+// 准备边索引数据：每条边只输出一次
+void buildEdgeIndices(const Mesh& mesh, std::vector<unsigned int>& edges)
+{
+    edges.clear();
+    edges.reserve(mesh.n_edges() * 2);
+    for (auto eh : mesh.edges()) {
+        auto heh = mesh.halfedge_handle(eh, 0);
+        edges.push_back(mesh.from_vertex_handle(heh).idx());
+        edges.push_back(mesh.to_vertex_handle(heh).idx());
+    }
+}
+
+void toFlatMesh(const Mesh& mesh, FlatMesh& flat)
+{
+    const size_t nv = mesh.n_vertices();
+    const float* points = reinterpret_cast<const float*>(mesh.points());
+    flat.positions.assign(points, points + nv * 3);
+    buildFaceIndices(mesh, flat.triangles);
+}
+
+bool fromFlatMesh(const FlatMesh& flat, Mesh& mesh)
+{
+    ObjData data;
+    data.positions = flat.positions;
+    data.faceVertices = flat.triangles;
+    data.faceOffsets.resize(flat.triangleCount() + 1);
+    for (size_t f = 0; f < data.faceOffsets.size(); ++f) {
+        data.faceOffsets[f] = static_cast<unsigned int>(3 * f);
+    }
+    if (!buildMesh(data, mesh)) return false;
+    mesh.request_vertex_normals();
+    mesh.request_face_normals();
+    mesh.update_normals();
+    markAllDirty(mesh);
+    return true;
+}
+
+} // namespace meshcore
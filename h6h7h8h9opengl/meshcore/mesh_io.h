@@ -0,0 +1,41 @@
+#ifndef MESHCORE_MESH_IO_H
+#define MESHCORE_MESH_IO_H
+
+#include "mesh_types.h"
+#include "obj_reader.h"
+#include "flat_mesh.h"
+#include <string>
+#include <vector>
+
+namespace meshcore {
+
+// Load mesh file; .obj goes through the parallel reader, others through OpenMesh
+// 加载网格文件；.obj走并行解析器，其他格式走OpenMesh
+bool loadMesh(Mesh& mesh, const std::string& path);
+bool saveMesh(const Mesh& mesh, const std::string& path);      // Save mesh file (保存网格文件)
+
+// Build the half-edge mesh from parsed OBJ data in one pass. With smoothing groups, edges
+// between faces of different groups, or between two faces with smoothing off, are tagged as
+// creases through the edge status feature flag
+// 由OBJ数据一次性构建半边网格。有平滑组时，不同组的面之间、或两个不平滑的面之间的边
+// 通过边状态的feature标记为折痕
+bool buildMesh(const ObjData& data, Mesh& mesh);
+
+void computeBoundingBox(const Mesh& mesh, Mesh::Point& min, Mesh::Point& max);     // Bounding box (计算包围盒)
+void centerAndScaleMesh(Mesh& mesh, const Mesh::Point& center, float maxSize);     // Center and scale (中心化并缩放)
+float normalizeMesh(Mesh& mesh);             // Center into [-1,1]^3, returns original size (归一化到[-1,1]，返回原始尺寸)
+
+// Index buffers for rendering: triangulated faces and unique edges
+// 渲染用索引：三角化后的面索引与唯一边索引
+void buildFaceIndices(const Mesh& mesh, std::vector<unsigned int>& faces);
+void buildEdgeIndices(const Mesh& mesh, std::vector<unsigned int>& edges);
+
+// Positions plus fan-triangulated faces for the flat kernels (供扁平内核使用的位置与三角化面)
+void toFlatMesh(const Mesh& mesh, FlatMesh& flat);
+// Half-edge mesh with normals from a flat triangle mesh, all vertices marked dirty
+// 由扁平三角网格构建带法线的半边网格，全部顶点标记为脏
+bool fromFlatMesh(const FlatMesh& flat, Mesh& mesh);
+
+} // namespace meshcore
+
+#endif // MESHCORE_MESH_IO_H
@@ -0,0 +1,58 @@
+#include "mesh_simplification.h"
+#include "dirty_region.h"
+#include <iostream>
+#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+
+namespace meshcore {
+
+bool simplifyMesh(Mesh& mesh, float ratio)
+{
+    if (mesh.n_vertices() == 0) return false;
+    
+    // 备份原始网格（用于可能的撤销操作）
+    Mesh backup = mesh;
+    
+    try {
+        // 创建简化器实例
+        OpenMesh::Decimater::DecimaterT<Mesh> decimater(mesh);
+        
+        // 添加QEM模块
+        OpenMesh::Decimater::ModQuadricT<Mesh>::Handle quadricModule;
+        if (!decimater.add(quadricModule)) {
+            std::cerr << "Failed to add Quadric module to decimater" << std::endl;
+            return false;
+        }
+        
+        // 初始化简化器
+        if (!decimater.initialize()) {
+            std::cerr << "Failed to initialize decimater" << std::endl;
+            return false;
+        }
+        
+        // 计算目标顶点数
+        size_t originalVertices = mesh.n_vertices();
+        size_t targetVertices = static_cast<size_t>(originalVertices * (1.0f - ratio));
+        if (targetVertices < 4) {
+            std::cerr << "Target vertices too low: " << targetVertices << std::endl;
+            targetVertices = 4; // 保持最小网格
+        }
+        
+        // 执行简化
+        decimater.decimate_to(targetVertices);
+        
+        // 垃圾收集
+        mesh.garbage_collection();
+        
+        // 更新法线；拓扑已改变，全部顶点标记为脏
+        mesh.update_normals();
+        markAllDirty(mesh);
+    } catch (const std::exception& e) {
+        std::cerr << "Mesh simplification failed: " << e.what() << std::endl;
+        mesh = backup; // 恢复原始网格
+        return false;
+    }
+    return true;
+}
+
+} // namespace meshcore
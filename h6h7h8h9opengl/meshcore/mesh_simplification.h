@@ -0,0 +1,14 @@
+#ifndef MESHCORE_MESH_SIMPLIFICATION_H
+#define MESHCORE_MESH_SIMPLIFICATION_H
+
+#include "mesh_types.h"
+
+namespace meshcore {
+
+// QEM decimation removing `ratio` (0-1) of the vertices; mesh is restored on failure
+// QEM网格简化，删除ratio比例(0-1)的顶点；失败时恢复原网格
+bool simplifyMesh(Mesh& mesh, float ratio);
+
+} // namespace meshcore
+
+#endif // MESHCORE_MESH_SIMPLIFICATION_H
@@ -0,0 +1,24 @@
+#ifndef MESHCORE_MESH_TYPES_H
+#define MESHCORE_MESH_TYPES_H
+
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+
+#define EPSILON 1E-4F 
+
+// Define OpenMesh mesh type with custom traits
+// 定义带有自定义特性的OpenMesh网格类型
+struct MyTraits : public OpenMesh::DefaultTraits {
+    VertexAttributes(OpenMesh::Attributes::Normal | 
+                     OpenMesh::Attributes::Status);
+    FaceAttributes(OpenMesh::Attributes::Normal | 
+                   OpenMesh::Attributes::Status);
+    // Add curvature attribute and dirty flag to vertices
+    // 为顶点添加曲率属性与脏标记
+    VertexTraits {
+        float curvature;      // Stores curvature value per vertex (每个顶点的曲率值)
+        bool dirty = false;   // Position changed since the last normal/curvature update (上次更新法线/曲率后位置已改变)
+    };
+};
+typedef OpenMesh::TriMesh_ArrayKernelT<MyTraits> Mesh;
+
+#endif // MESHCORE_MESH_TYPES_H
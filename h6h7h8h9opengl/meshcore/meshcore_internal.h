@@ -0,0 +1,38 @@
+#ifndef MESHCORE_INTERNAL_H
+#define MESHCORE_INTERNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Small helpers shared by several meshcore translation units. Internal to meshcore.
+// 多个meshcore源文件共用的小工具，仅供meshcore内部使用
+
+namespace meshcore {
+
+const uint64_t kFnvOffset = 14695981039346656037ULL;   // 64-bit FNV-1a offset basis (64位FNV-1a初值)
+
+// 64-bit FNV-1a over raw bytes, continuing from hash (从hash继续对原始字节做64位FNV-1a)
+inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// FNV-1a over the bytes of a vector, used to key the solver caches (对向量的字节做FNV-1a，作为求解器缓存的键)
+template <typename T>
+inline uint64_t hashArray(const std::vector<T>& data, uint64_t hash)
+{
+    return fnv1a(data.data(), data.size() * sizeof(T), hash);
+}
+
+// Corner after c in its triangle of a flat index list: 3t+2 wraps to 3t (扁平索引中角c在所属三角形内的下一个角，3t+2回到3t)
+inline unsigned int nextCorner(unsigned int c) { return c % 3 == 2 ? c - 2 : c + 1; }
+
+} // namespace meshcore
+
+#endif // MESHCORE_INTERNAL_H
@@ -0,0 +1,246 @@
+// meshtool: headless front end for meshcore
+// meshtool：meshcore的无界面命令行工具
+//
+//   meshtool curvature in.obj out.obj [--type gaussian|mean|max]
+//   meshtool smooth    in.obj out.obj [--method uniform|cotangent|area|implicit|solver] [--iterations N] [--lambda L]
+//                                      [--solver auto|ldlt|cg|amg]
+//   meshtool simplify  in.obj out.obj [--ratio R] [--method decimater|parallel|attribute]
+//   meshtool subdivide in.obj out.obj [--levels N] [--adaptive TOL] [--crease-angle DEG]
+//   meshtool param     in.obj out.obj [--boundary rect|circle|free|arap|atlas] [--iterations N] [--chart-angle DEG]
+//                      [--texel-density D] [--atlas-size N] [--padding N] [--solver auto|ldlt|cg|amg]
+#include "mesh_io.h"
+#include "curvature.h"
+#include "minimal_surface.h"
+#include "loop_subdivision.h"
+#include "adaptive_subdivision.h"
+#include "mesh_simplification.h"
+#include "parallel_simplification.h"
+#include "attribute_simplification.h"
+#include "parameterization.h"
+#include "conformal_parameterization.h"
+#include "arap_parameterization.h"
+#include "chart_atlas.h"
+#include "solver_cache.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int usage()
+{
+    std::cerr << "usage: meshtool <curvature|smooth|simplify|subdivide|param> in.obj out.obj [options]\n"
+              << "  curvature  --type gaussian|mean|max        (default mean)\n"
+              << "  smooth     --method uniform|cotangent|area|implicit|solver --iterations N --lambda L\n"
+              << "             --solver auto|ldlt|cg|amg       (sparse solve only, default auto)\n"
+              << "  simplify   --ratio R                        (0-1, default 0.5)\n"
+              << "             --method decimater|parallel|attribute (default decimater)\n"
+              << "  subdivide  --levels N                       (default 1)\n"
+              << "             --adaptive TOL --crease-angle DEG (refine where curvature * edge > TOL)\n"
+              << "  param      --boundary rect|circle|free|arap|atlas --solver auto|ldlt|cg|amg\n"
+              << "             (free: least-squares conformal map, --solver ignored)\n"
+              << "             --iterations N                   (arap: local/global iterations from free, default 10)\n"
+              << "             --chart-angle DEG                (atlas: max normal deviation within a chart, default 60)\n"
+              << "             --texel-density D --atlas-size N (atlas: texels per unit, or 0 to fit N x N, default 1024)\n"
+              << "             --padding N                      (atlas: texels between charts, default 2)\n";
+    return 1;
+}
+
+// 解析 "--key value" 形式的选项
+bool parseOptions(int argc, char** argv, int first, std::map<std::string, std::string>& options)
+{
+    for (int i = first; i < argc; i += 2) {
+        std::string key = argv[i];
+        if (key.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+            std::cerr << "invalid option: " << key << std::endl;
+            return false;
+        }
+        options[key.substr(2)] = argv[i + 1];
+    }
+    return true;
+}
+
+std::string option(const std::map<std::string, std::string>& options, const std::string& key, const std::string& fallback)
+{
+    auto it = options.find(key);
+    return it != options.end() ? it->second : fallback;
+}
+
+bool parseSolver(const std::string& name, meshcore::DirichletMethod& method)
+{
+    if (name == "auto") method = meshcore::DirichletMethod::Auto;
+    else if (name == "ldlt") method = meshcore::DirichletMethod::Cholesky;
+    else if (name == "cg") method = meshcore::DirichletMethod::ConjugateGradient;
+    else if (name == "amg") method = meshcore::DirichletMethod::Multigrid;
+    else return false;
+    return true;
+}
+
+void printSolveStats(const meshcore::SolveStats& stats)
+{
+    std::cerr << "solve: " << stats.unknowns << " unknowns, " << stats.boundary << " boundary, "
+              << meshcore::dirichletMethodName(stats.method) << ", " << stats.iterations << " iterations, "
+              << stats.levels << " levels, residual " << stats.residual << std::endl;
+}
+
+// 曲率以每行一个值写入 <out>.curv
+bool writeCurvature(const Mesh& mesh, const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out) return false;
+    for (auto vh : mesh.vertices()) {
+        out << mesh.data(vh).curvature << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 4) return usage();
+
+    const std::string op = argv[1];
+    const std::string inPath = argv[2];
+    const std::string outPath = argv[3];
+    std::map<std::string, std::string> options;
+    if (!parseOptions(argc, argv, 4, options)) return usage();
+
+    Mesh mesh;
+    auto start = Clock::now();
+    if (!meshcore::loadMesh(mesh, inPath)) {
+        std::cerr << "Failed to load mesh: " << inPath << std::endl;
+        return 1;
+    }
+    std::cerr << "load: " << elapsedMs(start) << " ms, "
+              << mesh.n_vertices() << " vertices, " << mesh.n_faces() << " faces" << std::endl;
+
+    meshcore::DirichletSolverCache solver;
+    meshcore::DirichletMethod solverMethod = meshcore::DirichletMethod::Auto;
+    if (!parseSolver(option(options, "solver", "auto"), solverMethod)) return usage();
+    solver.setMethod(solverMethod);
+
+    start = Clock::now();
+    bool ok = true;
+    if (op == "curvature") {
+        const std::string type = option(options, "type", "mean");
+        meshcore::CurvatureType curvatureType = meshcore::CurvatureType::Mean;
+        if (type == "gaussian") curvatureType = meshcore::CurvatureType::Gaussian;
+        else if (type == "max") curvatureType = meshcore::CurvatureType::Max;
+        else if (type != "mean") return usage();
+        meshcore::calculateCurvatures(mesh, curvatureType);
+    } else if (op == "smooth") {
+        const std::string method = option(options, "method", "uniform");
+        int iterations = std::atoi(option(options, "iterations", "10").c_str());
+        float lambda = static_cast<float>(std::atof(option(options, "lambda", "0.1").c_str()));
+        if (method == "uniform") meshcore::uniformLaplacianIteration(mesh, iterations, lambda);
+        else if (method == "cotangent") meshcore::cotangentWeightsIteration(mesh, iterations, lambda);
+        else if (method == "area") meshcore::cotangentWithAreaIteration(mesh, iterations, lambda);
+        else if (method == "implicit") {
+            ok = meshcore::implicitFairingIteration(mesh, iterations, lambda, &solver);
+            if (ok) printSolveStats(solver.lastStats());
+        }
+        else if (method == "solver") {
+            ok = meshcore::solveMinimalSurface(mesh, &solver);
+            if (ok) printSolveStats(solver.lastStats());
+        }
+        else return usage();
+    } else if (op == "simplify") {
+        float ratio = static_cast<float>(std::atof(option(options, "ratio", "0.5").c_str()));
+        const std::string method = option(options, "method", "decimater");
+        if (method == "decimater") ok = meshcore::simplifyMesh(mesh, ratio);
+        else if (method == "parallel") ok = meshcore::simplifyMeshParallel(mesh, ratio);
+        else if (method == "attribute") ok = meshcore::simplifyMeshWithAttributes(mesh, ratio);
+        else return usage();
+    } else if (op == "subdivide") {
+        int levels = std::atoi(option(options, "levels", "1").c_str());
+        if (options.count("adaptive")) {
+            meshcore::AdaptiveSubdivisionOptions adaptive;
+            adaptive.curvatureTolerance = static_cast<float>(std::atof(option(options, "adaptive", "0.05").c_str()));
+            adaptive.creaseAngle = static_cast<float>(std::atof(option(options, "crease-angle", "0").c_str()));
+            // 没有面超过阈值时提前结束，网格保持上一步的结果
+            for (int level = 0; level < levels; ++level) {
+                size_t refined = 0;
+                if (!meshcore::adaptiveSubdivide(mesh, adaptive, &refined)) break;
+                std::cerr << "adaptive step " << level + 1 << ": " << refined << " faces refined" << std::endl;
+            }
+        } else {
+            ok = meshcore::loopSubdivide(mesh, levels);
+        }
+    } else if (op == "param") {
+        const std::string boundary = option(options, "boundary", "rect");
+        if (boundary != "rect" && boundary != "circle" && boundary != "free" && boundary != "arap" &&
+            boundary != "atlas") return usage();
+        if (boundary == "atlas") {
+            // 输出三维接缝网格（顶点沿图块边界拆分）及其纹理坐标，而不是平面展开
+            meshcore::ChartAtlasOptions atlasOptions;
+            atlasOptions.maxNormalAngle = static_cast<float>(std::atof(option(options, "chart-angle", "60").c_str()));
+            atlasOptions.packing.texelsPerUnit = static_cast<float>(std::atof(option(options, "texel-density", "0").c_str()));
+            atlasOptions.packing.resolution = std::atoi(option(options, "atlas-size", "1024").c_str());
+            atlasOptions.packing.padding = std::atoi(option(options, "padding", "2").c_str());
+            meshcore::ChartAtlas atlas;
+            Mesh seamMesh;
+            ok = meshcore::buildChartAtlas(mesh, atlasOptions, atlas) && meshcore::buildAtlasMesh(mesh, atlas, seamMesh);
+            if (ok) {
+                std::cerr << "atlas: " << atlas.chartCount << " charts, " << seamMesh.n_vertices() - mesh.n_vertices()
+                          << " seam vertices added, " << atlas.packing.width << "x" << atlas.packing.height
+                          << " texels at " << atlas.packing.texelsPerUnit << " texels/unit, fill "
+                          << atlas.packing.fill << ", " << atlas.packing.rotated << " rotated" << std::endl;
+                mesh = seamMesh;
+            }
+        } else if (boundary == "arap") {
+            int iterations = std::atoi(option(options, "iterations", "10").c_str());
+            std::vector<meshcore::ArapIteration> log;
+            ok = meshcore::arapParameterize(mesh, iterations, meshcore::ArapInit::Conformal, &log);
+            for (size_t k = 0; k < log.size(); ++k) {
+                std::cerr << "arap iteration " << k + 1 << ": energy " << log[k].energy
+                          << ", " << log[k].milliseconds << " ms" << std::endl;
+            }
+        } else if (boundary == "free") {
+            ok = meshcore::conformalParameterize(mesh);
+        } else {
+            ok = meshcore::parameterize(mesh, boundary == "circle" ? meshcore::ParamBoundary::Circle
+                                                                    : meshcore::ParamBoundary::Rectangle,
+                                       &solver);
+            if (ok) printSolveStats(solver.lastStats());
+        }
+        if (ok && boundary != "atlas") {
+            std::vector<float> texCoords;
+            meshcore::computeParamTexCoords(mesh, texCoords);
+            mesh.request_vertex_texcoords2D();
+            for (auto vh : mesh.vertices()) {
+                mesh.set_texcoord2D(vh, Mesh::TexCoord2D(texCoords[2 * vh.idx()], texCoords[2 * vh.idx() + 1]));
+            }
+        }
+    } else {
+        return usage();
+    }
+    if (!ok) {
+        std::cerr << op << " failed" << std::endl;
+        return 1;
+    }
+    std::cerr << op << ": " << elapsedMs(start) << " ms, "
+              << mesh.n_vertices() << " vertices, " << mesh.n_faces() << " faces" << std::endl;
+
+    start = Clock::now();
+    if (!meshcore::saveMesh(mesh, outPath)) {
+        std::cerr << "Failed to write mesh: " << outPath << std::endl;
+        return 1;
+    }
+    if (op == "curvature" && !writeCurvature(mesh, outPath + ".curv")) {
+        std::cerr << "Failed to write curvature: " << outPath << ".curv" << std::endl;
+        return 1;
+    }
+    std::cerr << "save: " << elapsedMs(start) << " ms" << std::endl;
+    return 0;
+}
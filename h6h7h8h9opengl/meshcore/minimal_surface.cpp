@@ -0,0 +1,205 @@
+#include "minimal_surface.h"
+#include "laplacian.h"
+#include "jacobi_smoother.h"
+#include "dirty_region.h"
+#include "solver_cache.h"
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+namespace meshcore {
+
+namespace {
+
+// 均匀权重：step_ij = 1/deg
+void uniformRow(const LaplacianOperator& op, size_t i, SmoothingStep& step)
+{
+    const unsigned int degree = op.end(i) - op.begin(i);
+    for (unsigned int k = op.begin(i); k < op.end(i); ++k) {
+        step.weights[k] = 1.0f / degree;
+    }
+    step.scale[i] = 1.0f;
+}
+
+// 余切权重截断负值后归一化；无有效权重时退化为均匀权重。返回是否使用了余切权重
+bool cotangentRow(const LaplacianOperator& op, size_t i, SmoothingStep& step)
+{
+    float total = 0.0f;
+    for (unsigned int k = op.begin(i); k < op.end(i); ++k) {
+        total += std::max(op.values[k], 0.0f);
+    }
+    if (total <= EPSILON) {
+        uniformRow(op, i, step);
+        return false;
+    }
+    for (unsigned int k = op.begin(i); k < op.end(i); ++k) {
+        step.weights[k] = std::max(op.values[k], 0.0f) / total;
+    }
+    step.scale[i] = 1.0f;
+    return true;
+}
+
+// 权重在整个迭代过程中保持不变，由扁平Jacobi内核执行后一次性写回
+void smoothMesh(Mesh& openMesh, const LaplacianOperator& op, const SmoothingStep& step,
+                int iterations, float lambda)
+{
+    PositionArrays positions;
+    positions.resize(op.vertexCount());
+    for (auto vh : openMesh.vertices()) {
+        const Mesh::Point& p = openMesh.point(vh);
+        positions.x[vh.idx()] = p[0];
+        positions.y[vh.idx()] = p[1];
+        positions.z[vh.idx()] = p[2];
+    }
+
+    jacobiSmooth(op, step, positions, iterations, lambda);
+
+    // 写回顶点位置，只标记实际移动的顶点
+    for (auto vh : openMesh.vertices()) {
+        const int i = vh.idx();
+        Mesh::Point newPos(positions.x[i], positions.y[i], positions.z[i]);
+        if (newPos != openMesh.point(vh)) {
+            openMesh.set_point(vh, newPos);
+            markDirty(openMesh, vh);
+        }
+    }
+
+    // 只更新脏区域的法线
+    updateDirtyNormals(openMesh);
+}
+
+// 把求解结果写回网格，只标记实际移动的顶点（边界行保持原值，不会被标记）
+void applyPositions(Mesh& openMesh, const Eigen::MatrixXd& xyz)
+{
+    for (auto vh : openMesh.vertices()) {
+        const int i = vh.idx();
+        Mesh::Point newPos(xyz(i, 0), xyz(i, 1), xyz(i, 2));
+        if (newPos != openMesh.point(vh)) {
+            openMesh.set_point(vh, newPos);
+            markDirty(openMesh, vh);
+        }
+    }
+    updateDirtyNormals(openMesh);
+}
+
+Eigen::MatrixXd currentPositions(const Mesh& openMesh)
+{
+    Eigen::MatrixXd xyz(openMesh.n_vertices(), 3);
+    for (auto vh : openMesh.vertices()) {
+        const Mesh::Point& p = openMesh.point(vh);
+        xyz.row(vh.idx()) << p[0], p[1], p[2];
+    }
+    return xyz;
+}
+
+} // namespace
+
+void cotangentWeightsIteration(Mesh& openMesh, int iterations, float lambda) {
+    if (openMesh.n_vertices() == 0) return;
+
+    LaplacianOperator op;
+    buildLaplacian(openMesh, LaplacianWeights::Cotangent, op);
+    SmoothingStep step;
+    step.weights.resize(op.nonZeros());
+    step.scale.resize(op.vertexCount());
+    for (size_t i = 0; i < op.vertexCount(); ++i) {
+        cotangentRow(op, i, step);
+    }
+    smoothMesh(openMesh, op, step, iterations, lambda);
+}
+
+void uniformLaplacianIteration(Mesh& openMesh, int iterations, float lambda) {
+    if (openMesh.n_vertices() == 0) return;
+
+    LaplacianOperator op;
+    buildLaplacian(openMesh, LaplacianWeights::Uniform, op);
+    SmoothingStep step;
+    step.weights.resize(op.nonZeros());
+    step.scale.resize(op.vertexCount());
+    for (size_t i = 0; i < op.vertexCount(); ++i) {
+        uniformRow(op, i, step);
+    }
+    smoothMesh(openMesh, op, step, iterations, lambda);
+}
+
+void cotangentWithAreaIteration(Mesh& openMesh, int iterations, float lambda) {
+    if (openMesh.n_vertices() == 0) return;
+
+    LaplacianOperator op;
+    buildLaplacian(openMesh, LaplacianWeights::Cotangent, op);
+    SmoothingStep step;
+    step.weights.resize(op.nonZeros());
+    step.scale.resize(op.vertexCount());
+    for (size_t i = 0; i < op.vertexCount(); ++i) {
+        // Laplace-Beltrami算子：Δf = (1/4A) * Σ(cotα + cotβ)(f_j - f_i)；面积过大时退化为均匀权重
+        const float area = op.mixedArea[i];
+        if (area > 10 * EPSILON && lambda / area > 200 && cotangentRow(op, i, step)) {
+            step.scale[i] = 1.0f / (4 * area);
+        } else {
+            uniformRow(op, i, step);
+        }
+    }
+    smoothMesh(openMesh, op, step, iterations, lambda);
+}
+
+bool solveMinimalSurface(Mesh& openMesh, DirichletSolverCache* cache) {
+    if (openMesh.n_vertices() == 0) return false;
+
+    // 余切拉普拉斯算子（保留负权重）
+    LaplacianOperator op;
+    buildLaplacian(openMesh, LaplacianWeights::Cotangent, op);
+    int boundaryCount = 0;
+    for (unsigned char b : op.isBoundary) {
+        boundaryCount += b;
+    }
+
+    // 关键检查：必须有边界顶点
+    if (boundaryCount == 0) {
+        std::cerr << "错误：网格没有边界顶点！无法求解极小曲面问题。" << std::endl;
+        return false;
+    }
+
+    // 边界列移到右端，对称正定的内部块由缓存的分解（或预处理CG）求解；
+    // 以当前位置为初值，统计信息见 cache->lastStats()
+    DirichletSolverCache localCache;
+    DirichletSolverCache& solver = cache ? *cache : localCache;
+    if (!solver.prepare(op)) return false;
+
+    Eigen::MatrixXd xyz = currentPositions(openMesh);
+    if (!solver.solve(xyz)) {
+        std::cerr << "极小曲面求解失败" << std::endl;
+        return false;
+    }
+    applyPositions(openMesh, xyz);
+    return true;
+}
+
+bool implicitFairingIteration(Mesh& openMesh, int iterations, float lambda, DirichletSolverCache* cache) {
+    if (openMesh.n_vertices() == 0 || iterations <= 0 || lambda <= 0.0f) return false;
+
+    // 余切权重与混合面积在整个调用中保持不变，每步只做一次回代
+    LaplacianOperator op;
+    buildLaplacian(openMesh, LaplacianWeights::Cotangent, op);
+    double totalArea = 0.0;
+    for (float area : op.mixedArea) {
+        totalArea += area;
+    }
+    // 时间步以平均顶点面积为单位；cotα+cotβ权重需乘1/2才是Laplace-Beltrami
+    const double timeStep = 0.5 * lambda * totalArea / op.vertexCount();
+
+    DirichletSolverCache localCache;
+    DirichletSolverCache& solver = cache ? *cache : localCache;
+    if (!solver.prepare(op, timeStep)) return false;
+
+    Eigen::MatrixXd xyz = currentPositions(openMesh);
+    for (int step = 0; step < iterations; ++step) {
+        if (!solver.solve(xyz)) {
+            std::cerr << "隐式平滑第 " << step << " 步求解失败" << std::endl;
+            return false;
+        }
+    }
+    applyPositions(openMesh, xyz);
+    return true;
+}
+
+} // namespace meshcore
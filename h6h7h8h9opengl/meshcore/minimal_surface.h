@@ -0,0 +1,36 @@
+#ifndef MESHCORE_MINIMAL_SURFACE_H
+#define MESHCORE_MINIMAL_SURFACE_H
+
+#include "mesh_types.h"
+
+namespace meshcore {
+
+class DirichletSolverCache;
+
+// Explicit smoothing iterations, boundary vertices stay fixed. Moved vertices are
+// marked dirty and only their normals are refreshed.
+// 显式平滑迭代，边界顶点保持固定。移动的顶点被标记为脏，只更新其附近的法线
+void uniformLaplacianIteration(Mesh& mesh, int iterations, float lambda);   // Uniform Laplacian (均匀拉普拉斯)
+void cotangentWeightsIteration(Mesh& mesh, int iterations, float lambda);   // Cotangent weights (余切权重)
+void cotangentWithAreaIteration(Mesh& mesh, int iterations, float lambda);  // Area-weighted cotangent (带面积加权的余切)
+
+// Implicit fairing (Desbrun et al. 1999): each step solves the backward-Euler mean
+// curvature flow (M + dt L) x' = M x with the boundary fixed. dt is lambda times the mean
+// vertex area, so lambda reads like the explicit step size but may be far above 1.
+// Weights and the factorization are frozen for the call; every step is one back-substitution.
+// 隐式光顺：每步求解平均曲率流的隐式欧拉方程 (M + dt L) x' = M x，边界固定。
+// dt为lambda乘以平均顶点面积，lambda的含义与显式步长相近但可远大于1。
+// 权重与分解在整个调用中固定，每步只做一次回代
+bool implicitFairingIteration(Mesh& mesh, int iterations, float lambda,
+                              DirichletSolverCache* cache = nullptr);
+
+// Solve the minimal surface with fixed boundary in one sparse solve. Pass a cache that
+// outlives the call to reuse the factorization across repeated solves on the same mesh,
+// pick the solver (setMethod) and read iterations/residual (lastStats).
+// 固定边界，一次稀疏求解得到极小曲面。传入长期存在的cache可在同一网格的多次求解间复用分解，
+// 并可选择求解方式(setMethod)、读取迭代次数与残差(lastStats)
+bool solveMinimalSurface(Mesh& mesh, DirichletSolverCache* cache = nullptr);
+
+} // namespace meshcore
+
+#endif // MESHCORE_MINIMAL_SURFACE_H
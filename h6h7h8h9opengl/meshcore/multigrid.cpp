@@ -0,0 +1,195 @@
+#include "multigrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace meshcore {
+
+namespace {
+
+typedef Eigen::SparseMatrix<double> SpMat;
+
+const Eigen::Index kCoarsestSize = 500;   // 不超过该规模时直接分解
+const int kMaxLevels = 16;
+const double kStrengthThreshold = 0.08;   // |a_ij| > theta * sqrt(a_ii a_jj) 视为强连接
+const double kMinCoarsening = 0.85;       // 聚合数超过该比例说明已无法有效粗化
+
+// 贪心聚合：第一遍以强邻域全部空闲的节点为根建立聚合，第二遍把剩余节点并入连接最强的
+// 相邻聚合，第三遍把仍然孤立的节点各自成组。矩阵对称，第j列即第j行
+int aggregateNodes(const SpMat& A, std::vector<int>& aggregate)
+{
+    const Eigen::Index n = A.rows();
+    const Eigen::VectorXd diag = A.diagonal();
+    std::vector<int> offsets(n + 1, 0), strong;
+    std::vector<double> strength;
+    for (Eigen::Index j = 0; j < n; ++j) {
+        for (SpMat::InnerIterator it(A, j); it; ++it) {
+            const Eigen::Index i = it.row();
+            if (i == j) continue;
+            const double s = std::abs(it.value());
+            if (s > kStrengthThreshold * std::sqrt(std::abs(diag[i] * diag[j]))) {
+                strong.push_back(static_cast<int>(i));
+                strength.push_back(s);
+            }
+        }
+        offsets[j + 1] = static_cast<int>(strong.size());
+    }
+
+    aggregate.assign(n, -1);
+    int count = 0;
+    for (Eigen::Index i = 0; i < n; ++i) {
+        if (aggregate[i] >= 0 || offsets[i] == offsets[i + 1]) continue;
+        bool free = true;
+        for (int k = offsets[i]; k < offsets[i + 1] && free; ++k) {
+            free = aggregate[strong[k]] < 0;
+        }
+        if (!free) continue;
+        aggregate[i] = count;
+        for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+            aggregate[strong[k]] = count;
+        }
+        ++count;
+    }
+
+    const std::vector<int> roots = aggregate;
+    for (Eigen::Index i = 0; i < n; ++i) {
+        if (aggregate[i] >= 0) continue;
+        double best = 0.0;
+        for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+            if (roots[strong[k]] >= 0 && strength[k] > best) {
+                best = strength[k];
+                aggregate[i] = roots[strong[k]];
+            }
+        }
+    }
+
+    for (Eigen::Index i = 0; i < n; ++i) {
+        if (aggregate[i] >= 0) continue;
+        aggregate[i] = count;
+        for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+            if (aggregate[strong[k]] < 0) aggregate[strong[k]] = count;
+        }
+        ++count;
+    }
+    return count;
+}
+
+// 光滑延拓 P = (I - omega D^-1 A) T，T为列归一化的分段常数延拓；
+// omega = 4/3 / rho(D^-1 A)，rho用Gershgorin上界估计
+void smoothedProlongator(const SpMat& A, const Eigen::VectorXd& invDiagonal,
+                         const std::vector<int>& aggregate, int aggregateCount, SpMat& P)
+{
+    const Eigen::Index n = A.rows();
+    std::vector<int> size(aggregateCount, 0);
+    for (int a : aggregate) {
+        ++size[a];
+    }
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(n);
+    for (Eigen::Index i = 0; i < n; ++i) {
+        entries.emplace_back(i, aggregate[i], 1.0 / std::sqrt(static_cast<double>(size[aggregate[i]])));
+    }
+    SpMat T(n, aggregateCount);
+    T.setFromTriplets(entries.begin(), entries.end());
+
+    double rho = 0.0;
+    for (Eigen::Index j = 0; j < n; ++j) {
+        double rowSum = 0.0;
+        for (SpMat::InnerIterator it(A, j); it; ++it) {
+            rowSum += std::abs(it.value());
+        }
+        rho = std::max(rho, rowSum * invDiagonal[j]);
+    }
+    const double omega = rho > 0.0 ? 4.0 / (3.0 * rho) : 0.0;
+
+    // 逐项缩放A*T后与T相加（Eigen的对角阵乘稀疏阵再相减的表达式在大矩阵上很慢）
+    P = A * T;
+    for (Eigen::Index j = 0; j < P.outerSize(); ++j) {
+        for (SpMat::InnerIterator it(P, j); it; ++it) {
+            it.valueRef() *= -omega * invDiagonal[it.row()];
+        }
+    }
+    P += T;
+    P.prune(0.0);
+}
+
+// 按forward方向做一次Gauss-Seidel扫描
+void gaussSeidel(const SpMat& A, const Eigen::VectorXd& invDiagonal, const Eigen::VectorXd& b,
+                 Eigen::VectorXd& x, bool forward)
+{
+    const Eigen::Index n = A.rows();
+    for (Eigen::Index step = 0; step < n; ++step) {
+        const Eigen::Index i = forward ? step : n - 1 - step;
+        double sum = b[i];
+        for (SpMat::InnerIterator it(A, i); it; ++it) {
+            if (it.row() != i) sum -= it.value() * x[it.row()];
+        }
+        x[i] = sum * invDiagonal[i];
+    }
+}
+
+} // namespace
+
+void AlgebraicMultigrid::setup(const Matrix& A, bool reuseAggregates)
+{
+    reuseAggregates = reuseAggregates && !levels_.empty() && levels_[0].A.rows() == A.rows();
+    const size_t reusable = reuseAggregates ? levels_.size() : 0;
+    if (!reuseAggregates) levels_.clear();
+
+    // 逐层：对角逆、聚合（或沿用）、光滑延拓与Galerkin粗化 A_c = P^T A P
+    Matrix current = A;
+    size_t l = 0;
+    for (;; ++l) {
+        if (l == levels_.size()) levels_.emplace_back();
+        Level& level = levels_[l];
+        level.A = std::move(current);
+        level.invDiagonal = level.A.diagonal().cwiseInverse();
+
+        const bool coarsest = level.A.rows() <= kCoarsestSize || static_cast<int>(l) + 1 == kMaxLevels;
+        if (coarsest || (reuseAggregates && l + 1 == reusable)) break;
+        if (!reuseAggregates) {
+            level.aggregateCount = aggregateNodes(level.A, level.aggregate);
+            if (level.aggregateCount == 0 || level.aggregateCount > kMinCoarsening * level.A.rows()) {
+                level.aggregate.clear();
+                break;
+            }
+        }
+        smoothedProlongator(level.A, level.invDiagonal, level.aggregate, level.aggregateCount, level.P);
+        level.R = level.P.transpose();
+        current = level.R * level.A * level.P;
+    }
+    levels_.resize(l + 1);
+    levels_.back().aggregate.clear();
+    levels_.back().P.resize(0, 0);
+    levels_.back().R.resize(0, 0);
+
+    coarse_.compute(levels_.back().A);
+    info_ = coarse_.info();
+}
+
+void AlgebraicMultigrid::cycle(size_t l, const Vector& b, Vector& x) const
+{
+    const Level& level = levels_[l];
+    if (l + 1 == levels_.size()) {
+        x = coarse_.solve(b);
+        return;
+    }
+    x.setZero(b.size());
+    gaussSeidel(level.A, level.invDiagonal, b, x, true);
+    const Vector coarseRhs = level.R * (b - level.A * x);
+    Vector correction;
+    cycle(l + 1, coarseRhs, correction);
+    x += level.P * correction;
+    gaussSeidel(level.A, level.invDiagonal, b, x, false);
+}
+
+double AlgebraicMultigrid::operatorComplexity() const
+{
+    if (levels_.empty() || levels_[0].A.nonZeros() == 0) return 0.0;
+    double total = 0.0;
+    for (const Level& level : levels_) {
+        total += static_cast<double>(level.A.nonZeros());
+    }
+    return total / static_cast<double>(levels_[0].A.nonZeros());
+}
+
+} // namespace meshcore
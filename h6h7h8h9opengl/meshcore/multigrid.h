@@ -0,0 +1,75 @@
+#ifndef MESHCORE_MULTIGRID_H
+#define MESHCORE_MULTIGRID_H
+
+#include <vector>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace meshcore {
+
+// Smoothed-aggregation algebraic multigrid for SPD Laplace-type matrices (Vanek et al. 1996).
+// Each application is one symmetric V-cycle (forward Gauss-Seidel down, backward up, LDLT on
+// the coarsest level), so it can precondition CG. Implements Eigen's preconditioner interface:
+// analyzePattern builds the aggregates of every level, factorize recomputes the smoothed
+// prolongators, Galerkin products and the coarse factor for new values on the same aggregates.
+// Setup and cycle cost are linear in the number of non-zeros.
+// 用于SPD拉普拉斯类矩阵的光滑聚合代数多重网格。每次作用为一个对称V循环（下行前向Gauss-Seidel，
+// 上行后向Gauss-Seidel，最粗层LDLT），可作CG预处理器。实现Eigen预处理器接口：
+// analyzePattern构建各层聚合，factorize在相同聚合上为新数值重算光滑延拓、Galerkin乘积与粗层分解。
+// 建立与循环的代价都与非零元个数成线性
+class AlgebraicMultigrid {
+public:
+    typedef double Scalar;
+    typedef Eigen::VectorXd Vector;
+    typedef Eigen::SparseMatrix<double> Matrix;
+
+    AlgebraicMultigrid() {}
+    template <typename MatType>
+    explicit AlgebraicMultigrid(const MatType& A) { compute(A); }
+
+    template <typename MatType>
+    AlgebraicMultigrid& analyzePattern(const MatType& A) { setup(Matrix(A), false); return *this; }
+    template <typename MatType>
+    AlgebraicMultigrid& factorize(const MatType& A) { setup(Matrix(A), true); return *this; }
+    template <typename MatType>
+    AlgebraicMultigrid& compute(const MatType& A) { setup(Matrix(A), false); return *this; }
+
+    // z = M^-1 b, one V-cycle from a zero guess (以零初值做一次V循环)
+    template <typename Rhs>
+    Vector solve(const Eigen::MatrixBase<Rhs>& b) const
+    {
+        Vector x;
+        cycle(0, b, x);
+        return x;
+    }
+
+    Eigen::ComputationInfo info() const { return info_; }
+    Eigen::Index rows() const { return levels_.empty() ? 0 : levels_[0].A.rows(); }
+    Eigen::Index cols() const { return rows(); }
+
+    size_t levelCount() const { return levels_.size(); }
+    double operatorComplexity() const;      // Sum of nnz over levels / finest nnz (各层非零元之和/最细层)
+
+private:
+    struct Level {
+        Matrix A;
+        Vector invDiagonal;
+        Matrix P;                       // Prolongation from the next coarser level (来自下一粗层的延拓)
+        Matrix R;                       // P^T
+        std::vector<int> aggregate;     // Node -> coarse node (节点所属聚合)
+        int aggregateCount = 0;
+    };
+
+    // reuseAggregates: keep the aggregates from the last analysis if the size still matches
+    // reuseAggregates：规模不变时沿用上次分析得到的聚合
+    void setup(const Matrix& A, bool reuseAggregates);
+    void cycle(size_t level, const Vector& b, Vector& x) const;
+
+    std::vector<Level> levels_;
+    Eigen::SimplicialLDLT<Matrix> coarse_;
+    Eigen::ComputationInfo info_ = Eigen::Success;
+};
+
+} // namespace meshcore
+
+#endif // MESHCORE_MULTIGRID_H
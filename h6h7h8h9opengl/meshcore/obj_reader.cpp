@@ -0,0 +1,239 @@
+#include "obj_reader.h"
+#include "mapped_file.h"
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace meshcore {
+
+void ObjData::clear()
+{
+    positions.clear();
+    faceOffsets.clear();
+    faceVertices.clear();
+    faceGroups.clear();
+}
+
+namespace {
+
+// 每块至少1MB，避免小文件切得过碎
+const size_t kMinChunkBytes = 1 << 20;
+
+// 单个分块的解析结果，之后按前缀和拼接
+struct ObjChunk {
+    std::vector<float> positions;
+    std::vector<unsigned int> faceSizes;
+    std::vector<long long> faceVertices;    // 绝对索引为0起始；相对索引暂存为块内位置
+    std::vector<size_t> relativeSlots;      // 需要加上块的顶点基址的位置（负索引）
+    std::vector<long long> faceGroups;      // 每个面的平滑组；块内第一条s记录之前为-1，沿用上一块的状态
+    long long group = -1;                   // 当前平滑组
+    bool hasGroups = false;
+    bool ok = true;
+};
+
+inline const char* skipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+inline const char* skipLine(const char* p, const char* end)
+{
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl + 1 : end;
+}
+
+inline bool isLineEnd(const char* p, const char* end)
+{
+    return p >= end || *p == '\n' || *p == '\r' || *p == '#';
+}
+
+void parseChunk(const char* p, const char* end, ObjChunk& chunk)
+{
+    while (p < end) {
+        p = skipSpaces(p, end);
+        if (p + 1 < end && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+            // 顶点：v x y z [w]，多余分量（w或顶点颜色）忽略
+            p += 2;
+            float xyz[3];
+            for (int i = 0; i < 3; ++i) {
+                p = skipSpaces(p, end);
+                // from_chars不接受前导'+'
+                if (p < end && *p == '+') ++p;
+                auto res = std::from_chars(p, end, xyz[i]);
+                if (res.ec != std::errc()) {
+                    chunk.ok = false;
+                    return;
+                }
+                p = res.ptr;
+            }
+            chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+        }
+        else if (p + 1 < end && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            // 面：f a a/b a//c a/b/c，只取顶点索引
+            p += 2;
+            unsigned int count = 0;
+            long long localVertices = static_cast<long long>(chunk.positions.size() / 3);
+            for (;;) {
+                p = skipSpaces(p, end);
+                if (isLineEnd(p, end)) break;
+                long long idx = 0;
+                auto res = std::from_chars(p, end, idx);
+                if (res.ec != std::errc() || idx == 0) {
+                    chunk.ok = false;
+                    return;
+                }
+                p = res.ptr;
+                if (idx > 0) {
+                    chunk.faceVertices.push_back(idx - 1);
+                }
+                else {
+                    // 负索引相对于当前已定义的顶点，先记录块内位置
+                    chunk.relativeSlots.push_back(chunk.faceVertices.size());
+                    chunk.faceVertices.push_back(localVertices + idx);
+                }
+                ++count;
+                // 跳过纹理/法线索引
+                while (p < end && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') ++p;
+            }
+            if (count >= 3) {
+                chunk.faceSizes.push_back(count);
+                chunk.faceGroups.push_back(chunk.group);
+            }
+            else {
+                chunk.faceVertices.resize(chunk.faceVertices.size() - count);
+                while (!chunk.relativeSlots.empty() && chunk.relativeSlots.back() >= chunk.faceVertices.size()) {
+                    chunk.relativeSlots.pop_back();
+                }
+            }
+        }
+        else if (p + 1 < end && p[0] == 's' && (p[1] == ' ' || p[1] == '\t')) {
+            // 平滑组：s N，s off与s 0表示不平滑
+            p = skipSpaces(p + 2, end);
+            unsigned int group = 0;
+            std::from_chars(p, end, group);
+            chunk.group = group;
+            chunk.hasGroups = true;
+        }
+        p = skipLine(p, end);
+    }
+}
+
+} // namespace
+
+bool parseObj(const char* begin, const char* end, ObjData& data)
+{
+    data.clear();
+    size_t length = end - begin;
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threads * 4, length / kMinChunkBytes));
+
+    // 块边界对齐到行首
+    std::vector<const char*> bounds(chunkCount + 1);
+    bounds[0] = begin;
+    bounds[chunkCount] = end;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        const char* p = std::max(begin + length * i / chunkCount, bounds[i - 1]);
+        bounds[i] = (p > begin && p[-1] == '\n') ? p : skipLine(p, end);
+    }
+
+    std::vector<ObjChunk> chunks(chunkCount);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long i = 0; i < static_cast<long long>(chunkCount); ++i) {
+        parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+    }
+
+    // 前缀和得到每块在全局数组中的偏移
+    std::vector<size_t> vertexBase(chunkCount + 1, 0), faceBase(chunkCount + 1, 0), cornerBase(chunkCount + 1, 0);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        if (!chunks[i].ok) {
+            std::cerr << "OBJ parse error in chunk " << i << std::endl;
+            return false;
+        }
+        vertexBase[i + 1] = vertexBase[i] + chunks[i].positions.size() / 3;
+        faceBase[i + 1] = faceBase[i] + chunks[i].faceSizes.size();
+        cornerBase[i + 1] = cornerBase[i] + chunks[i].faceVertices.size();
+    }
+
+    const size_t vertexCount = vertexBase[chunkCount];
+    data.positions.resize(vertexCount * 3);
+    data.faceOffsets.resize(faceBase[chunkCount] + 1);
+    data.faceVertices.resize(cornerBase[chunkCount]);
+    data.faceOffsets[0] = 0;
+
+    // 平滑组沿块顺序传递：块内第一条s记录之前的面属于上一块结束时的组（文件开头为0）
+    bool hasGroups = false;
+    for (const ObjChunk& chunk : chunks) hasGroups = hasGroups || chunk.hasGroups;
+    if (hasGroups) {
+        data.faceGroups.resize(faceBase[chunkCount]);
+        long long carried = 0;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            unsigned int* groups = data.faceGroups.data() + faceBase[i];
+            for (long long group : chunks[i].faceGroups) {
+                *groups++ = static_cast<unsigned int>(group < 0 ? carried : group);
+            }
+            if (chunks[i].group >= 0) carried = chunks[i].group;
+        }
+    }
+
+    bool indicesValid = true;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(&& : indicesValid)
+    for (long long i = 0; i < static_cast<long long>(chunkCount); ++i) {
+        ObjChunk& chunk = chunks[i];
+        std::copy(chunk.positions.begin(), chunk.positions.end(), data.positions.begin() + vertexBase[i] * 3);
+
+        for (size_t slot : chunk.relativeSlots) {
+            chunk.faceVertices[slot] += static_cast<long long>(vertexBase[i]);
+        }
+        unsigned int* out = data.faceVertices.data() + cornerBase[i];
+        for (long long idx : chunk.faceVertices) {
+            if (idx < 0 || idx >= static_cast<long long>(vertexCount)) {
+                indicesValid = false;
+                idx = 0;
+            }
+            *out++ = static_cast<unsigned int>(idx);
+        }
+
+        unsigned int offset = static_cast<unsigned int>(cornerBase[i]);
+        unsigned int* offsets = data.faceOffsets.data() + faceBase[i] + 1;
+        for (unsigned int size : chunk.faceSizes) {
+            offset += size;
+            *offsets++ = offset;
+        }
+        // 释放块内存
+        std::vector<float>().swap(chunk.positions);
+        std::vector<long long>().swap(chunk.faceVertices);
+    }
+
+    if (!indicesValid) {
+        std::cerr << "OBJ face references a vertex out of range" << std::endl;
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool readObj(const std::string& path, ObjData& data)
+{
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Cannot open OBJ file: " << path << std::endl;
+        return false;
+    }
+    if (file.size() == 0) {
+        data.clear();
+        return true;
+    }
+    return parseObj(file.data(), file.data() + file.size(), data);
+}
+
+} // namespace meshcore
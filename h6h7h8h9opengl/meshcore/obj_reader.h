@@ -0,0 +1,33 @@
+#ifndef MESHCORE_OBJ_READER_H
+#define MESHCORE_OBJ_READER_H
+
+#include <string>
+#include <vector>
+
+namespace meshcore {
+
+// Flat OBJ contents: positions and polygon faces in CSR form
+// 扁平化的OBJ数据：顶点坐标与CSR形式的多边形面
+struct ObjData {
+    std::vector<float> positions;            // x,y,z per vertex (每个顶点的xyz)
+    std::vector<unsigned int> faceOffsets;   // face i uses faceVertices[faceOffsets[i], faceOffsets[i+1]) (面i的顶点区间)
+    std::vector<unsigned int> faceVertices;  // 0-based vertex indices (从0开始的顶点索引)
+    // Smoothing group per face from `s` records, 0 for "s off"; empty when the file has none
+    // 每个面的平滑组（来自s记录，"s off"为0）；文件中没有s记录时为空
+    std::vector<unsigned int> faceGroups;
+
+    size_t vertexCount() const { return positions.size() / 3; }
+    size_t faceCount() const { return faceOffsets.empty() ? 0 : faceOffsets.size() - 1; }
+    void clear();
+};
+
+// Memory-mapped, chunk-parallel OBJ parser (v/f/s records only)
+// 内存映射、分块并行的OBJ解析器（只解析v/f/s记录）
+bool readObj(const std::string& path, ObjData& data);
+
+// Parse an in-memory OBJ buffer (解析内存中的OBJ文本)
+bool parseObj(const char* begin, const char* end, ObjData& data);
+
+} // namespace meshcore
+
+#endif // MESHCORE_OBJ_READER_H
@@ -0,0 +1,602 @@
+#include "parallel_simplification.h"
+#include "mesh_io.h"
+#include "qem_common.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MESHCORE_HAS_AVX2_PATH 1
+#endif
+
+namespace meshcore {
+
+namespace {
+
+const double kDetEpsilon = 1e-10;       // 相对行列式下限，低于它视为奇异并取中点
+const unsigned int kMaxCorners = 48;    // 角数更多的顶点本批不参与折叠（局部数组容量）
+const float kBatchFraction = 0.25f;     // 每批只考虑代价最低的这部分边
+const int kIndependentSetPasses = 4;    // 每批选独立集的遍数
+const uint64_t kNoCandidate = ~uint64_t(0);
+const unsigned int kDeadTriangle = ~0u;
+
+// 对称4x4二次误差矩阵上三角的10个分量（xx xy xz xw yy yz yw zz zw ww），按分量分开存放，
+// 便于按4条边一组收集
+struct QuadricArrays {
+    std::vector<double> q[10];
+
+    void assign(size_t n)
+    {
+        for (std::vector<double>& c : q) c.assign(n, 0.0);
+    }
+    void addPlane(size_t v, double a, double b, double c, double d, double weight)
+    {
+        double plane[10] = {};
+        qem::addPlane(plane, a, b, c, d, weight);
+        for (int k = 0; k < 10; ++k) q[k][v] += plane[k];
+    }
+    void sum(unsigned int a, unsigned int b, double out[10]) const
+    {
+        for (int k = 0; k < 10; ++k) out[k] = q[k][a] + q[k][b];
+    }
+};
+
+// 本批的边（a < b）、共享三角形数、折叠后的位置与代价
+struct EdgeArrays {
+    std::vector<unsigned int> a, b;
+    std::vector<unsigned char> shared;
+    std::vector<float> x, y, z;
+    std::vector<double> cost;
+
+    size_t size() const { return a.size(); }
+    void resize(size_t n)
+    {
+        a.resize(n); b.resize(n); shared.resize(n);
+        x.resize(n); y.resize(n); z.resize(n); cost.resize(n);
+    }
+};
+
+inline unsigned int cornerNext(const unsigned int* tri, unsigned int c) { return tri[c - c % 3 + (c + 1) % 3]; }
+inline unsigned int cornerPrev(const unsigned int* tri, unsigned int c) { return tri[c - c % 3 + (c + 2) % 3]; }
+
+// 面平面按面积加权；无配对的有向边为边界边，加过该边且垂直于面的约束平面。每个顶点只写自己的分量
+void initializeQuadrics(const FlatMesh& mesh, const VertexCorners& adj, QuadricArrays& Q)
+{
+    const long long nv = static_cast<long long>(mesh.vertexCount());
+    const float* p = mesh.positions.data();
+    const unsigned int* tri = mesh.triangles.data();
+    Q.assign(nv);
+
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        for (unsigned int i = adj.begin(v); i < adj.end(v); ++i) {
+            const unsigned int c = adj.corners[i];
+            const unsigned int* t = tri + (c - c % 3);
+            double n[3];
+            qem::triangleNormal(p + 3 * t[0], p + 3 * t[1], p + 3 * t[2], n);
+            const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len <= 0.0) continue;
+            const double a = n[0] / len, b = n[1] / len, cc = n[2] / len;
+            const float* x = p + 3 * t[0];
+            Q.addPlane(v, a, b, cc, -(a * x[0] + b * x[1] + cc * x[2]), 0.5 * len);
+
+            // 本角的出边v->next与入边prev->v，各自在v的其他角中找反向边
+            const unsigned int ends[2] = {cornerNext(tri, c), cornerPrev(tri, c)};
+            for (int side = 0; side < 2; ++side) {
+                bool paired = false;
+                for (unsigned int j = adj.begin(v); j < adj.end(v) && !paired; ++j) {
+                    const unsigned int d = adj.corners[j];
+                    paired = side == 0 ? cornerPrev(tri, d) == ends[0] : cornerNext(tri, d) == ends[1];
+                }
+                if (paired) continue;
+                const float* pa = side == 0 ? p + 3 * v : p + 3 * ends[1];
+                const float* pb = side == 0 ? p + 3 * ends[0] : p + 3 * v;
+                double plane[4], weight;
+                if (!qem::boundaryPlane(pa, pb, n, plane, weight)) continue;
+                Q.addPlane(v, plane[0], plane[1], plane[2], plane[3], weight);
+            }
+        }
+    }
+}
+
+// 每个顶点列出编号更大的邻点作为边（两遍：计数、填充）。邻点在角的next/prev中出现的次数
+// 即共享该边的三角形数：1为边界，超过2为非流形（端点永久锁定）
+void buildEdges(const FlatMesh& mesh, const VertexCorners& adj, EdgeArrays& edges,
+                std::vector<unsigned char>& boundary, std::vector<unsigned char>& locked)
+{
+    const long long nv = static_cast<long long>(mesh.vertexCount());
+    const unsigned int* tri = mesh.triangles.data();
+    std::vector<unsigned int> offsets(nv + 1, 0);
+    boundary.assign(nv, 0);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        #pragma omp parallel
+        {
+            std::vector<unsigned int> ring;
+            #pragma omp for schedule(static)
+            for (long long v = 0; v < nv; ++v) {
+                ring.clear();
+                for (unsigned int i = adj.begin(v); i < adj.end(v); ++i) {
+                    ring.push_back(cornerNext(tri, adj.corners[i]));
+                    ring.push_back(cornerPrev(tri, adj.corners[i]));
+                }
+                std::sort(ring.begin(), ring.end());
+                unsigned int out = pass == 0 ? 0 : offsets[v];
+                for (size_t i = 0; i < ring.size();) {
+                    size_t j = i;
+                    while (j < ring.size() && ring[j] == ring[i]) ++j;
+                    const size_t shared = j - i;
+                    if (pass == 0) {
+                        if (shared == 1) boundary[v] = 1;
+                        if (shared > 2) locked[v] = 1;
+                        out += ring[i] > v;
+                    } else if (ring[i] > v) {
+                        edges.a[out] = static_cast<unsigned int>(v);
+                        edges.b[out] = ring[i];
+                        edges.shared[out] = static_cast<unsigned char>(std::min<size_t>(shared, 255));
+                        ++out;
+                    }
+                    i = j;
+                }
+                if (pass == 0) offsets[v + 1] = out;
+            }
+        }
+        if (pass == 0) {
+            for (long long v = 0; v < nv; ++v) offsets[v + 1] += offsets[v];
+            edges.resize(offsets[nv]);
+        }
+    }
+}
+
+// 最优位置解A p = -b；矩阵接近奇异或解离边中点超过边长时取中点
+void solveEdgeScalar(const QuadricArrays& Q, const float* p, EdgeArrays& edges, size_t e)
+{
+    double q[10];
+    Q.sum(edges.a[e], edges.b[e], q);
+    const float* pa = p + 3 * edges.a[e];
+    const float* pb = p + 3 * edges.b[e];
+    const double mx = 0.5 * (pa[0] + pb[0]), my = 0.5 * (pa[1] + pb[1]), mz = 0.5 * (pa[2] + pb[2]);
+    double x = mx, y = my, z = mz;
+
+    const double c00 = q[4] * q[7] - q[5] * q[5], c01 = q[2] * q[5] - q[1] * q[7], c02 = q[1] * q[5] - q[2] * q[4];
+    const double c11 = q[0] * q[7] - q[2] * q[2], c12 = q[1] * q[2] - q[0] * q[5], c22 = q[0] * q[4] - q[1] * q[1];
+    const double det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+    const double trace = q[0] + q[4] + q[7];
+    if (std::fabs(det) > kDetEpsilon * trace * trace * trace) {
+        const double inv = -1.0 / det;
+        const double ox = inv * (c00 * q[3] + c01 * q[6] + c02 * q[8]);
+        const double oy = inv * (c01 * q[3] + c11 * q[6] + c12 * q[8]);
+        const double oz = inv * (c02 * q[3] + c12 * q[6] + c22 * q[8]);
+        const double d2 = (ox - mx) * (ox - mx) + (oy - my) * (oy - my) + (oz - mz) * (oz - mz);
+        const double ex = pb[0] - pa[0], ey = pb[1] - pa[1], ez = pb[2] - pa[2];
+        if (d2 <= ex * ex + ey * ey + ez * ez) {
+            x = ox; y = oy; z = oz;
+        }
+    }
+    edges.x[e] = static_cast<float>(x);
+    edges.y[e] = static_cast<float>(y);
+    edges.z[e] = static_cast<float>(z);
+    edges.cost[e] = std::max(0.0, qem::evaluate(q, x, y, z));
+}
+
+void solveEdgesScalar(const QuadricArrays& Q, const float* p, EdgeArrays& edges)
+{
+    const long long ne = static_cast<long long>(edges.size());
+    #pragma omp parallel for schedule(static)
+    for (long long e = 0; e < ne; ++e) {
+        solveEdgeScalar(Q, p, edges, e);
+    }
+}
+
+#ifdef MESHCORE_HAS_AVX2_PATH
+
+// 与solveEdgeScalar相同的计算，每次4条边：二次误差与端点用gather收集，分支改为掩码混合
+__attribute__((target("avx2,fma")))
+void solveEdgesAvx2(const QuadricArrays& Q, const float* p, EdgeArrays& edges)
+{
+    const long long ne = static_cast<long long>(edges.size());
+    const long long blocks = ne / 4;
+    #pragma omp parallel for schedule(static)
+    for (long long block = 0; block < blocks; ++block) {
+        const long long e = 4 * block;
+        const __m128i ia = _mm_loadu_si128(reinterpret_cast<const __m128i*>(edges.a.data() + e));
+        const __m128i ib = _mm_loadu_si128(reinterpret_cast<const __m128i*>(edges.b.data() + e));
+        __m256d q[10];
+        for (int k = 0; k < 10; ++k) {
+            q[k] = _mm256_add_pd(_mm256_i32gather_pd(Q.q[k].data(), ia, 8),
+                                 _mm256_i32gather_pd(Q.q[k].data(), ib, 8));
+        }
+        const __m128i ia3 = _mm_add_epi32(_mm_add_epi32(ia, ia), ia);
+        const __m128i ib3 = _mm_add_epi32(_mm_add_epi32(ib, ib), ib);
+        const __m256d ax = _mm256_cvtps_pd(_mm_i32gather_ps(p, ia3, 4));
+        const __m256d ay = _mm256_cvtps_pd(_mm_i32gather_ps(p + 1, ia3, 4));
+        const __m256d az = _mm256_cvtps_pd(_mm_i32gather_ps(p + 2, ia3, 4));
+        const __m256d bx = _mm256_cvtps_pd(_mm_i32gather_ps(p, ib3, 4));
+        const __m256d by = _mm256_cvtps_pd(_mm_i32gather_ps(p + 1, ib3, 4));
+        const __m256d bz = _mm256_cvtps_pd(_mm_i32gather_ps(p + 2, ib3, 4));
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d mx = _mm256_mul_pd(_mm256_add_pd(ax, bx), half);
+        const __m256d my = _mm256_mul_pd(_mm256_add_pd(ay, by), half);
+        const __m256d mz = _mm256_mul_pd(_mm256_add_pd(az, bz), half);
+
+        const __m256d c00 = _mm256_fmsub_pd(q[4], q[7], _mm256_mul_pd(q[5], q[5]));
+        const __m256d c01 = _mm256_fmsub_pd(q[2], q[5], _mm256_mul_pd(q[1], q[7]));
+        const __m256d c02 = _mm256_fmsub_pd(q[1], q[5], _mm256_mul_pd(q[2], q[4]));
+        const __m256d c11 = _mm256_fmsub_pd(q[0], q[7], _mm256_mul_pd(q[2], q[2]));
+        const __m256d c12 = _mm256_fmsub_pd(q[1], q[2], _mm256_mul_pd(q[0], q[5]));
+        const __m256d c22 = _mm256_fmsub_pd(q[0], q[4], _mm256_mul_pd(q[1], q[1]));
+        const __m256d det = _mm256_fmadd_pd(q[0], c00, _mm256_fmadd_pd(q[1], c01, _mm256_mul_pd(q[2], c02)));
+        const __m256d trace = _mm256_add_pd(q[0], _mm256_add_pd(q[4], q[7]));
+        const __m256d limit = _mm256_mul_pd(_mm256_set1_pd(kDetEpsilon),
+                                            _mm256_mul_pd(trace, _mm256_mul_pd(trace, trace)));
+        const __m256d absDet = _mm256_andnot_pd(_mm256_set1_pd(-0.0), det);
+        __m256d use = _mm256_cmp_pd(absDet, limit, _CMP_GT_OQ);
+
+        const __m256d inv = _mm256_div_pd(_mm256_set1_pd(-1.0), det);
+        const __m256d ox = _mm256_mul_pd(inv, _mm256_fmadd_pd(c00, q[3], _mm256_fmadd_pd(c01, q[6], _mm256_mul_pd(c02, q[8]))));
+        const __m256d oy = _mm256_mul_pd(inv, _mm256_fmadd_pd(c01, q[3], _mm256_fmadd_pd(c11, q[6], _mm256_mul_pd(c12, q[8]))));
+        const __m256d oz = _mm256_mul_pd(inv, _mm256_fmadd_pd(c02, q[3], _mm256_fmadd_pd(c12, q[6], _mm256_mul_pd(c22, q[8]))));
+        const __m256d dx = _mm256_sub_pd(ox, mx), dy = _mm256_sub_pd(oy, my), dz = _mm256_sub_pd(oz, mz);
+        const __m256d d2 = _mm256_fmadd_pd(dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dz, dz)));
+        const __m256d ex = _mm256_sub_pd(bx, ax), ey = _mm256_sub_pd(by, ay), ez = _mm256_sub_pd(bz, az);
+        const __m256d len2 = _mm256_fmadd_pd(ex, ex, _mm256_fmadd_pd(ey, ey, _mm256_mul_pd(ez, ez)));
+        use = _mm256_and_pd(use, _mm256_cmp_pd(d2, len2, _CMP_LE_OQ));
+        const __m256d x = _mm256_blendv_pd(mx, ox, use);
+        const __m256d y = _mm256_blendv_pd(my, oy, use);
+        const __m256d z = _mm256_blendv_pd(mz, oz, use);
+
+        // x^T A x + 2 b^T x + w
+        const __m256d rx = _mm256_fmadd_pd(q[0], x, _mm256_fmadd_pd(q[1], y, _mm256_fmadd_pd(q[2], z, q[3])));
+        const __m256d ry = _mm256_fmadd_pd(q[1], x, _mm256_fmadd_pd(q[4], y, _mm256_fmadd_pd(q[5], z, q[6])));
+        const __m256d rz = _mm256_fmadd_pd(q[2], x, _mm256_fmadd_pd(q[5], y, _mm256_fmadd_pd(q[7], z, q[8])));
+        const __m256d linear = _mm256_fmadd_pd(q[3], x, _mm256_fmadd_pd(q[6], y, _mm256_fmadd_pd(q[8], z, q[9])));
+        const __m256d cost = _mm256_fmadd_pd(rx, x, _mm256_fmadd_pd(ry, y, _mm256_fmadd_pd(rz, z, linear)));
+
+        _mm_storeu_ps(edges.x.data() + e, _mm256_cvtpd_ps(x));
+        _mm_storeu_ps(edges.y.data() + e, _mm256_cvtpd_ps(y));
+        _mm_storeu_ps(edges.z.data() + e, _mm256_cvtpd_ps(z));
+        _mm256_storeu_pd(edges.cost.data() + e, _mm256_max_pd(cost, _mm256_setzero_pd()));
+    }
+    for (long long e = 4 * blocks; e < ne; ++e) {
+        solveEdgeScalar(Q, p, edges, e);
+    }
+}
+
+#endif // MESHCORE_HAS_AVX2_PATH
+
+// 连接条件与翻转检查只读取两端点周围的三角形，同一批中其他被选中的折叠不会改动它们。
+// 只有一端在边界上时改为并到边界端点，位置与代价随之改写
+bool collapseAllowed(const FlatMesh& mesh, const VertexCorners& adj, const QuadricArrays& Q,
+                     const std::vector<unsigned char>& boundary, const std::vector<unsigned char>& locked,
+                     EdgeArrays& edges, size_t e)
+{
+    const unsigned int a = edges.a[e], b = edges.b[e];
+    const unsigned int* tri = mesh.triangles.data();
+    const float* p = mesh.positions.data();
+    if (locked[a] || locked[b]) return false;
+    if (adj.end(a) - adj.begin(a) > kMaxCorners || adj.end(b) - adj.begin(b) > kMaxCorners) return false;
+    const unsigned int shared = edges.shared[e];
+    if (shared == 0 || shared > 2) return false;
+    if (boundary[a] && boundary[b]) {
+        // 两个边界顶点之间的内部边会把网格捏断
+        if (shared != 1) return false;
+    } else if (boundary[a] || boundary[b]) {
+        const float* keep = p + 3 * (boundary[a] ? a : b);
+        double q[10];
+        Q.sum(a, b, q);
+        edges.x[e] = keep[0];
+        edges.y[e] = keep[1];
+        edges.z[e] = keep[2];
+        edges.cost[e] = std::max(0.0, qem::evaluate(q, keep[0], keep[1], keep[2]));
+    }
+
+    // 连接条件：公共邻点恰好是共享三角形的第三个顶点
+    unsigned int ringA[2 * kMaxCorners], ringB[2 * kMaxCorners];
+    unsigned int na = 0, nb = 0;
+    for (unsigned int i = adj.begin(a); i < adj.end(a); ++i) {
+        ringA[na++] = cornerNext(tri, adj.corners[i]);
+        ringA[na++] = cornerPrev(tri, adj.corners[i]);
+    }
+    for (unsigned int i = adj.begin(b); i < adj.end(b); ++i) {
+        ringB[nb++] = cornerNext(tri, adj.corners[i]);
+        ringB[nb++] = cornerPrev(tri, adj.corners[i]);
+    }
+    std::sort(ringA, ringA + na);
+    std::sort(ringB, ringB + nb);
+    na = static_cast<unsigned int>(std::unique(ringA, ringA + na) - ringA);
+    nb = static_cast<unsigned int>(std::unique(ringB, ringB + nb) - ringB);
+    unsigned int common = 0;
+    for (unsigned int i = 0, j = 0; i < na && j < nb;) {
+        if (ringA[i] < ringB[j]) {
+            ++i;
+        } else if (ringB[j] < ringA[i]) {
+            ++j;
+        } else {
+            common += ringA[i] != a && ringA[i] != b;
+            ++i;
+            ++j;
+        }
+    }
+    if (common != shared) return false;
+
+    // 不含另一端点的三角形在端点移到新位置后不得翻转或退化
+    const float target[3] = {edges.x[e], edges.y[e], edges.z[e]};
+    const unsigned int ends[2] = {a, b};
+    for (int side = 0; side < 2; ++side) {
+        const unsigned int v = ends[side], other = ends[1 - side];
+        for (unsigned int i = adj.begin(v); i < adj.end(v); ++i) {
+            const unsigned int* t = tri + (adj.corners[i] - adj.corners[i] % 3);
+            if (t[0] == other || t[1] == other || t[2] == other) continue;
+            const float* corner[3];
+            const float* moved[3];
+            for (int k = 0; k < 3; ++k) {
+                corner[k] = p + 3 * t[k];
+                moved[k] = t[k] == v ? target : corner[k];
+            }
+            double before[3], after[3];
+            qem::triangleNormal(corner[0], corner[1], corner[2], before);
+            qem::triangleNormal(moved[0], moved[1], moved[2], after);
+            if (qem::foldsOver(before, after)) return false;
+        }
+    }
+    return true;
+}
+
+// 代价转为float后位模式与数值同序；低32位放边号，代价相同时按边号决定
+inline uint64_t candidateKey(double cost, size_t e)
+{
+    const float value = static_cast<float>(cost);
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (static_cast<uint64_t>(bits) << 32) | static_cast<uint64_t>(e);
+}
+
+inline void atomicMin(std::atomic<uint64_t>& slot, uint64_t value)
+{
+    uint64_t current = slot.load(std::memory_order_relaxed);
+    while (value < current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+bool parallelSimplifierUsesAvx2()
+{
+#ifdef MESHCORE_HAS_AVX2_PATH
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// 按顺序列出被三角形引用的顶点，即removeUnreferencedVertices之后各顶点原来的编号
+static void referencedVertices(const FlatMesh& mesh, std::vector<unsigned int>& vertices)
+{
+    std::vector<unsigned char> referenced(mesh.vertexCount(), 0);
+    for (unsigned int v : mesh.triangles) referenced[v] = 1;
+    vertices.clear();
+    for (size_t v = 0; v < referenced.size(); ++v) {
+        if (referenced[v]) vertices.push_back(static_cast<unsigned int>(v));
+    }
+}
+
+bool simplifyFlatMesh(FlatMesh& mesh, float ratio, ParallelSimplifyStats* stats, std::vector<unsigned int>* sourceVertex)
+{
+    if (stats) *stats = ParallelSimplifyStats();
+    const size_t nv = mesh.vertexCount();
+    if (nv == 0 || mesh.triangleCount() == 0) return false;
+    // 折叠时保留端点a的编号，两次压缩都保持顺序，因此幸存顶点可追溯到输入顶点
+    std::vector<unsigned int> origin;
+    if (sourceVertex) referencedVertices(mesh, origin);
+    removeUnreferencedVertices(mesh);
+    size_t alive = mesh.vertexCount();
+    const size_t target = std::max<size_t>(4, static_cast<size_t>(alive * (1.0f - std::min(std::max(ratio, 0.0f), 1.0f))));
+
+    VertexCorners adj;
+    adj.build(mesh);
+    QuadricArrays Q;
+    initializeQuadrics(mesh, adj, Q);
+
+    const bool avx2 = parallelSimplifierUsesAvx2();
+    EdgeArrays edges;
+    std::vector<unsigned char> boundary, locked(mesh.vertexCount(), 0);
+    std::vector<uint64_t> keys;
+    std::vector<unsigned int> candidates, active, selected;
+    std::vector<unsigned char> claimed, chosen;
+    std::vector<double> costs;
+    std::unique_ptr<std::atomic<uint64_t>[]> best(new std::atomic<uint64_t>[mesh.vertexCount()]);
+    for (size_t v = 0; v < mesh.vertexCount(); ++v) best[v].store(kNoCandidate, std::memory_order_relaxed);
+    float fraction = kBatchFraction;
+    ParallelSimplifyStats counters;
+    bool adjacencyStale = false;
+
+    while (alive > target) {
+        if (adjacencyStale) adj.build(mesh);
+        adjacencyStale = false;
+        const long long vertexCount = static_cast<long long>(mesh.vertexCount());
+        const float* p = mesh.positions.data();
+        const unsigned int* tri = mesh.triangles.data();
+
+        // 1. 所有边的最优位置与代价
+        buildEdges(mesh, adj, edges, boundary, locked);
+#ifdef MESHCORE_HAS_AVX2_PATH
+        if (avx2) {
+            solveEdgesAvx2(Q, p, edges);
+        } else {
+            solveEdgesScalar(Q, p, edges);
+        }
+#else
+        (void)avx2;
+        solveEdgesScalar(Q, p, edges);
+#endif
+
+        // 2. 只考虑代价最低的一部分边，避免一批中选入代价高的折叠
+        costs.clear();
+        for (size_t e = 0; e < edges.size(); ++e) {
+            if (!locked[edges.a[e]] && !locked[edges.b[e]]) costs.push_back(edges.cost[e]);
+        }
+        if (costs.empty()) break;
+        const size_t k = std::min(costs.size() - 1, static_cast<size_t>(costs.size() * fraction));
+        std::nth_element(costs.begin(), costs.begin() + k, costs.end());
+        const double threshold = costs[k];
+        candidates.clear();
+        for (size_t e = 0; e < edges.size(); ++e) {
+            if (edges.cost[e] <= threshold) candidates.push_back(static_cast<unsigned int>(e));
+        }
+
+        // 3. 合法性检查；合法候选进入本批的活动列表
+        const long long candidateCount = static_cast<long long>(candidates.size());
+        keys.resize(candidates.size());
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (long long i = 0; i < candidateCount; ++i) {
+            const unsigned int e = candidates[i];
+            keys[i] = collapseAllowed(mesh, adj, Q, boundary, locked, edges, e)
+                    ? candidateKey(edges.cost[e], e) : kNoCandidate;
+        }
+        active.clear();
+        for (long long i = 0; i < candidateCount; ++i) {
+            if (keys[i] != kNoCandidate) active.push_back(static_cast<unsigned int>(i));
+        }
+
+        // 4. 独立集：边的键在两端点闭1环内所有顶点的最小键中最小即入选。两条入选边的端点互不在
+        //    对方的1环中，因此它们改写与读取的三角形互不相交。入选边占用两端点的1环，剩余候选
+        //    再选几遍，使每批接近极大独立集
+        selected.clear();
+        claimed.assign(vertexCount, 0);
+        for (int pass = 0; pass < kIndependentSetPasses && !active.empty(); ++pass) {
+            const long long activeCount = static_cast<long long>(active.size());
+            #pragma omp parallel for schedule(static)
+            for (long long j = 0; j < activeCount; ++j) {
+                const unsigned int i = active[j];
+                atomicMin(best[edges.a[candidates[i]]], keys[i]);
+                atomicMin(best[edges.b[candidates[i]]], keys[i]);
+            }
+            chosen.assign(active.size(), 0);
+            #pragma omp parallel for schedule(static)
+            for (long long j = 0; j < activeCount; ++j) {
+                const unsigned int i = active[j];
+                const unsigned int ends[2] = {edges.a[candidates[i]], edges.b[candidates[i]]};
+                uint64_t m = kNoCandidate;
+                for (unsigned int v : ends) {
+                    m = std::min(m, best[v].load(std::memory_order_relaxed));
+                    for (unsigned int k = adj.begin(v); k < adj.end(v); ++k) {
+                        const unsigned int c = adj.corners[k];
+                        m = std::min(m, best[cornerNext(tri, c)].load(std::memory_order_relaxed));
+                        m = std::min(m, best[cornerPrev(tri, c)].load(std::memory_order_relaxed));
+                    }
+                }
+                chosen[j] = m == keys[i];
+            }
+            for (long long j = 0; j < activeCount; ++j) {
+                if (!chosen[j]) continue;
+                const unsigned int e = candidates[active[j]];
+                selected.push_back(e);
+                for (unsigned int v : {edges.a[e], edges.b[e]}) {
+                    claimed[v] = 1;
+                    for (unsigned int k = adj.begin(v); k < adj.end(v); ++k) {
+                        claimed[cornerNext(tri, adj.corners[k])] = 1;
+                        claimed[cornerPrev(tri, adj.corners[k])] = 1;
+                    }
+                }
+            }
+            // 复位本遍写过的最小键，下一遍只剩两端都未被占用的候选
+            size_t kept = 0;
+            for (long long j = 0; j < activeCount; ++j) {
+                const unsigned int e = candidates[active[j]];
+                best[edges.a[e]].store(kNoCandidate, std::memory_order_relaxed);
+                best[edges.b[e]].store(kNoCandidate, std::memory_order_relaxed);
+                if (!chosen[j] && !claimed[edges.a[e]] && !claimed[edges.b[e]]) active[kept++] = active[j];
+            }
+            active.resize(kept);
+        }
+        if (selected.empty()) {
+            // 低代价边都不合法时放宽到全部边，仍没有则已无法继续
+            if (fraction >= 1.0f) break;
+            fraction = 1.0f;
+            continue;
+        }
+        // 放宽只对触发它的这一批有效，之后恢复只取低代价边
+        fraction = kBatchFraction;
+        if (selected.size() > alive - target) {
+            std::nth_element(selected.begin(), selected.begin() + (alive - target), selected.end(),
+                             [&](unsigned int x, unsigned int y) {
+                                 return candidateKey(edges.cost[x], x) < candidateKey(edges.cost[y], y);
+                             });
+            selected.resize(alive - target);
+        }
+
+        // 5. 并发折叠：b并到a，b周围含a的三角形删除，其余三角形的b角改为a
+        const long long selectedCount = static_cast<long long>(selected.size());
+        #pragma omp parallel for schedule(static)
+        for (long long i = 0; i < selectedCount; ++i) {
+            const unsigned int e = selected[i];
+            const unsigned int a = edges.a[e], b = edges.b[e];
+            for (unsigned int j = adj.begin(b); j < adj.end(b); ++j) {
+                const unsigned int c = adj.corners[j];
+                unsigned int* t = mesh.triangles.data() + (c - c % 3);
+                if (t[0] == a || t[1] == a || t[2] == a) {
+                    t[0] = t[1] = t[2] = kDeadTriangle;
+                } else {
+                    t[c % 3] = a;
+                }
+            }
+            mesh.positions[3 * a] = edges.x[e];
+            mesh.positions[3 * a + 1] = edges.y[e];
+            mesh.positions[3 * a + 2] = edges.z[e];
+            for (int k = 0; k < 10; ++k) Q.q[k][a] += Q.q[k][b];
+        }
+
+        // 6. 压缩三角形数组
+        size_t out = 0;
+        for (size_t t = 0; t < mesh.triangles.size(); t += 3) {
+            if (mesh.triangles[t] == kDeadTriangle) continue;
+            for (int k = 0; k < 3; ++k) mesh.triangles[out + k] = mesh.triangles[t + k];
+            out += 3;
+        }
+        mesh.triangles.resize(out);
+        alive -= selected.size();
+        adjacencyStale = true;
+        ++counters.rounds;
+        counters.collapses += selected.size();
+    }
+
+    if (sourceVertex) {
+        std::vector<unsigned int> survivors;
+        referencedVertices(mesh, survivors);
+        sourceVertex->resize(survivors.size());
+        for (size_t v = 0; v < survivors.size(); ++v) (*sourceVertex)[v] = origin[survivors[v]];
+    }
+    removeUnreferencedVertices(mesh);
+    if (stats) *stats = counters;
+    return true;
+}
+
+bool simplifyMeshParallel(Mesh& mesh, float ratio)
+{
+    if (mesh.n_vertices() == 0) return false;
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    std::vector<unsigned int> sourceVertex;
+    if (!simplifyFlatMesh(flat, ratio, nullptr, &sourceVertex)) return false;
+    Mesh result;
+    if (!fromFlatMesh(flat, result)) return false;
+
+    // 幸存顶点沿用其输入顶点的纹理坐标，与ProgressiveMesh::extract一致
+    if (mesh.has_vertex_texcoords2D()) {
+        result.request_vertex_texcoords2D();
+        for (size_t v = 0; v < sourceVertex.size(); ++v) {
+            result.set_texcoord2D(Mesh::VertexHandle(static_cast<int>(v)),
+                                  mesh.texcoord2D(Mesh::VertexHandle(static_cast<int>(sourceVertex[v]))));
+        }
+    }
+    mesh = std::move(result);
+    return true;
+}
+
+} // namespace meshcore
@@ -0,0 +1,38 @@
+#ifndef MESHCORE_PARALLEL_SIMPLIFICATION_H
+#define MESHCORE_PARALLEL_SIMPLIFICATION_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include <cstddef>
+#include <vector>
+
+namespace meshcore {
+
+// Counters of one parallel decimation (一次并行简化的统计)
+struct ParallelSimplifyStats {
+    size_t rounds = 0;              // Batches collapsed (执行的批次数)
+    size_t collapses = 0;           // Edge collapses performed (执行的边折叠数)
+};
+
+// QEM decimation in rounds instead of one global heap. Every round evaluates all edges in
+// parallel (optimal-position quadric solve, AVX2 when available), keeps the edges whose
+// cost is a minimum over the 1-rings of both endpoints (a few passes, each excluding the
+// rings already claimed), and collapses that independent set concurrently: no two of them
+// touch the same triangle. Removes `ratio` (0-1) of the
+// vertices like simplifyMesh; boundaries are kept by perpendicular quadric planes.
+// sourceVertex, when given, receives the input vertex each surviving vertex descends from.
+// 分批执行的QEM简化，不使用全局堆。每批并行评估所有边（求解最优位置，可用时使用AVX2），
+// 分几遍选出代价在两端点1环内最小的边（后一遍排除已占用的1环），这一独立集互不共享三角形，可并发折叠。
+// 与simplifyMesh一样删除ratio比例(0-1)的顶点；边界由垂直约束平面保持。
+// 若给出sourceVertex，则写入每个幸存顶点对应的输入顶点
+bool simplifyFlatMesh(FlatMesh& mesh, float ratio, ParallelSimplifyStats* stats = nullptr,
+                      std::vector<unsigned int>* sourceVertex = nullptr);
+// Through FlatMesh, texcoords follow the surviving vertices; mesh is kept on failure
+// (经由FlatMesh，纹理坐标随幸存顶点保留；失败时网格不变)
+bool simplifyMeshParallel(Mesh& mesh, float ratio);
+
+bool parallelSimplifierUsesAvx2();  // Whether edge costs use the AVX2 path on this CPU (当前CPU是否用AVX2计算边代价)
+
+} // namespace meshcore
+
+#endif // MESHCORE_PARALLEL_SIMPLIFICATION_H
@@ -0,0 +1,225 @@
+#include "parameterization.h"
+#include "boundary_loops.h"
+#include "dirty_region.h"
+#include "laplacian.h"
+#include "mesh_io.h"
+#include "solver_cache.h"
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+namespace meshcore {
+
+namespace {
+
+// 边界映射到圆形。boundary按边界半边顺序排列，它与面的朝向相反，因此按顺时针摆放，
+// 参数域中的三角形保持逆时针
+bool mapLoopToCircle(Mesh& openMesh, const std::vector<Mesh::VertexHandle>& boundary) {
+    if (boundary.size() < 3) return false;
+
+    // 计算总弧长
+    float arc_len = 0.0f;
+    for(size_t i = 1; i < boundary.size(); ++i) {
+        arc_len += (openMesh.point(boundary[i]) - openMesh.point(boundary[i-1])).norm();
+    }
+    arc_len += (openMesh.point(boundary[boundary.size()-1]) - openMesh.point(boundary[0])).norm();
+    
+    // 计算每段弧长对应的角度增量
+    std::vector<float> delta;
+    for(size_t i = 1; i < boundary.size(); ++i) {
+        float seg_len = (openMesh.point(boundary[i]) - openMesh.point(boundary[i-1])).norm();
+        delta.push_back(2.0f * M_PI * (seg_len / arc_len));
+    }
+    
+    // 映射到单位圆
+    float angle_now = 0.0f;
+    for(size_t i = 0; i < boundary.size(); ++i) {
+        float x = cos(angle_now);
+        float y = sin(angle_now);
+        openMesh.set_point(boundary[i], Mesh::Point(x, y, 0));
+        if(i < boundary.size() - 1) {
+            angle_now -= delta[i];
+        }
+    }
+    return true;
+}
+
+// 边界映射到矩形；角点按(0,0)、(0,1)、(1,1)、(1,0)顺时针排列，与边界半边顺序一致
+bool mapLoopToRectangle(Mesh& openMesh, const std::vector<Mesh::VertexHandle>& boundary) {
+    if (boundary.size() < 4) return false;
+
+    const int n = boundary.size();
+    const float length = 1.0f; // 正方形边长
+    
+    // 计算四条边上的点数（尽可能平均分配）
+    int side1 = n / 4;
+    int side2 = n / 4;
+    int side3 = n / 4;
+    int side4 = n - 3 * (n / 4);
+    
+    // 设置四个角点
+    openMesh.set_point(boundary[0], Mesh::Point(0.0f, 0.0f, 0.0f));
+    openMesh.set_point(boundary[side1], Mesh::Point(0.0f, length, 0.0f));
+    openMesh.set_point(boundary[side1 + side2], Mesh::Point(length, length, 0.0f));
+    openMesh.set_point(boundary[side1 + side2 + side3], Mesh::Point(length, 0.0f, 0.0f));
+    
+    // 左边 (y: 0 → length)
+    float delta = length / side1;
+    for (int i = 1; i < side1; ++i) {
+        float y = i * delta;
+        openMesh.set_point(boundary[i], Mesh::Point(0.0f, y, 0.0f));
+    }
+    
+    // 上边 (x: 0 → length)
+    delta = length / side2;
+    for (int i = 1; i < side2; ++i) {
+        int idx = side1 + i;
+        float x = i * delta;
+        openMesh.set_point(boundary[idx], Mesh::Point(x, length, 0.0f));
+    }
+    
+    // 右边 (y: length → 0)
+    delta = length / side3;
+    for (int i = 1; i < side3; ++i) {
+        int idx = side1 + side2 + i;
+        float y = length - i * delta;
+        openMesh.set_point(boundary[idx], Mesh::Point(length, y, 0.0f));
+    }
+    
+    // 下边 (x: length → 0)
+    delta = length / side4;
+    for (int i = 1; i < side4; ++i) {
+        int idx = side1 + side2 + side3 + i;
+        float x = length - i * delta;
+        openMesh.set_point(boundary[idx], Mesh::Point(x, 0.0f, 0.0f));
+    }
+    return true;
+}
+
+// 求解参数化：固定最长的边界环，其余的洞用虚拟的扇形三角形补上，
+// 洞边上的顶点因此成为内部顶点，而不是被钉在原来的三维坐标上
+bool solveWithHoles(Mesh& openMesh, const std::vector<BoundaryLoop>& loops, DirichletSolverCache* cache) {
+    if (openMesh.n_vertices() == 0) return false;
+
+    // 每个洞在形心处加一个虚拟顶点，与洞边的每条边组成三角形；边界半边a->b的方向与虚拟面一致
+    FlatMesh flat;
+    toFlatMesh(openMesh, flat);
+    const int n = openMesh.n_vertices();
+    for (size_t k = 1; k < loops.size(); ++k) {
+        const std::vector<Mesh::VertexHandle>& hole = loops[k].vertices;
+        const unsigned int center = static_cast<unsigned int>(flat.vertexCount());
+        Mesh::Point c(0.0f, 0.0f, 0.0f);
+        for (auto vh : hole) c += openMesh.point(vh);
+        c /= static_cast<float>(hole.size());
+        flat.positions.insert(flat.positions.end(), {c[0], c[1], c[2]});
+        for (size_t i = 0; i < hole.size(); ++i) {
+            const unsigned int a = hole[i].idx(), b = hole[(i + 1) % hole.size()].idx();
+            flat.triangles.insert(flat.triangles.end(), {a, b, center});
+        }
+    }
+
+    // 余切拉普拉斯算子（边界已映射到平面，权重按当前位置计算）
+    VertexCorners adjacency;
+    adjacency.build(flat);
+    LaplacianOperator op;
+    buildLaplacian(flat, adjacency, LaplacianWeights::Cotangent, op);
+
+    // 边界(u, v)作为固定值，内部块由缓存的LDLT分解求解，u、v两列一次回代
+    DirichletSolverCache localCache;
+    DirichletSolverCache& solver = cache ? *cache : localCache;
+    if (!solver.prepare(op)) {
+        std::cerr << "Matrix factorization failed!" << std::endl;
+        return false;
+    }
+
+    // 虚拟顶点只参与求解，不写回网格
+    const int total = static_cast<int>(flat.vertexCount());
+    Eigen::MatrixXd uv(total, 2);
+    for (int i = 0; i < total; i++) {
+        const float* p = &flat.positions[3 * i];
+        uv.row(i) << p[0], p[1];
+    }
+    if (!solver.solve(uv)) {
+        std::cerr << "Parameterization solve failed!" << std::endl;
+        return false;
+    }
+    
+    // 更新顶点位置
+    for (int i = 0; i < n; i++) {
+        Mesh::Point newPos(uv(i, 0), uv(i, 1), 0.0f);
+        openMesh.set_point(Mesh::VertexHandle(i), newPos);
+    }
+    return true;
+}
+
+} // namespace
+
+bool mapBoundaryToCircle(Mesh& openMesh) {
+    const std::vector<BoundaryLoop> loops = findBoundaryLoops(openMesh);
+    return !loops.empty() && mapLoopToCircle(openMesh, loops.front().vertices);
+}
+
+bool mapBoundaryToRectangle(Mesh& openMesh) {
+    const std::vector<BoundaryLoop> loops = findBoundaryLoops(openMesh);
+    return !loops.empty() && mapLoopToRectangle(openMesh, loops.front().vertices);
+}
+
+bool solveParameterization(Mesh& openMesh, DirichletSolverCache* cache) {
+    return solveWithHoles(openMesh, findBoundaryLoops(openMesh), cache);
+}
+
+// 按包围盒的较长边把平面坐标归一化到[0,1]作为纹理坐标
+void computeParamTexCoords(const Mesh& openMesh, std::vector<float>& texCoords) {
+    texCoords.clear();
+    texCoords.reserve(openMesh.n_vertices() * 2);
+    
+    // 计算最小最大值用于归一化
+    float minX = 1e9, maxX = -1e9;
+    float minY = 1e9, maxY = -1e9;
+    for (auto vh : openMesh.vertices()) {
+        auto p = openMesh.point(vh);
+        minX = std::min(minX, p[0]);
+        maxX = std::max(maxX, p[0]);
+        minY = std::min(minY, p[1]);
+        maxY = std::max(maxY, p[1]);
+    }
+    
+    // 归一化到[0,1]范围；两轴按较长边统一缩放，自由边界的保角映射不被拉伸
+    float range = std::max(maxX - minX, maxY - minY);
+    for (auto vh : openMesh.vertices()) {
+        auto p = openMesh.point(vh);
+        float u = (p[0] - minX) / range;
+        float v = (p[1] - minY) / range;
+        texCoords.push_back(u);
+        texCoords.push_back(v);
+    }
+}
+
+// 执行参数化：边界映射 + 求解内部顶点
+bool parameterize(Mesh& openMesh, ParamBoundary boundary, DirichletSolverCache* cache) {
+    // 边界环只追踪一次：最长的环按边界类型映射，其余的洞在求解时虚拟补上
+    const std::vector<BoundaryLoop> loops = findBoundaryLoops(openMesh);
+    if (loops.empty()) {
+        std::cerr << "Parameterization requires a mesh with a boundary" << std::endl;
+        return false;
+    }
+    const std::vector<Mesh::VertexHandle>& outer = loops.front().vertices;
+    bool mapped = (boundary == ParamBoundary::Circle) ? mapLoopToCircle(openMesh, outer)
+                                                      : mapLoopToRectangle(openMesh, outer);
+    if (!mapped) {
+        std::cerr << "Parameterization: the boundary has too few vertices" << std::endl;
+        return false;
+    }
+    if (loops.size() > 1) {
+        std::cerr << "Parameterization: pinned the longest of " << loops.size()
+                  << " boundary loops, filling the others" << std::endl;
+    }
+    
+    // 求解参数化；全部顶点都被移到平面上
+    if (!solveWithHoles(openMesh, loops, cache)) return false;
+    markAllDirty(openMesh);
+    return true;
+}
+
+} // namespace meshcore
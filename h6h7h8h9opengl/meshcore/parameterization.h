@@ -0,0 +1,38 @@
+#ifndef MESHCORE_PARAMETERIZATION_H
+#define MESHCORE_PARAMETERIZATION_H
+
+#include "mesh_types.h"
+#include <vector>
+
+namespace meshcore {
+
+class DirichletSolverCache;
+
+// Boundary shapes for parameterization
+// 参数化边界形状
+enum class ParamBoundary {
+    Rectangle,           // Rectangular boundary (矩形边界)
+    Circle               // Circular boundary (圆形边界)
+};
+
+// Tutte/harmonic parameterization, vertex positions become (u, v, 0). The longest boundary
+// loop (see boundary_loops.h) is pinned to the boundary shape; every other loop is a hole,
+// closed for the solve by a virtual fan around its centroid so its vertices stay free.
+// An optional cache keeps the factorization between calls (see solver_cache.h)
+// 调和参数化，顶点坐标被替换为(u, v, 0)。最长的边界环（见boundary_loops.h）被固定到边界形状；
+// 其余的环都是洞，求解时由绕其形心的虚拟扇形封闭，洞边顶点保持自由。
+// 可选的cache在多次调用间保留分解
+bool parameterize(Mesh& mesh, ParamBoundary boundary, DirichletSolverCache* cache = nullptr);
+
+bool mapBoundaryToCircle(Mesh& mesh);        // Map the longest boundary loop to a circle (将最长的边界环映射到圆形)
+bool mapBoundaryToRectangle(Mesh& mesh);     // Map the longest boundary loop to a rectangle (将最长的边界环映射到矩形)
+bool solveParameterization(Mesh& mesh, DirichletSolverCache* cache = nullptr);  // Solve interior and hole vertices (求解内部与洞边顶点)
+
+// Normalize planar positions into [0,1] texture coordinates, both axes scaled by the longer
+// bounding-box side so conformal maps keep their angles
+// 将平面坐标归一化为[0,1]纹理坐标，两轴都按包围盒的较长边缩放，保角映射的角度保持不变
+void computeParamTexCoords(const Mesh& mesh, std::vector<float>& texCoords);
+
+} // namespace meshcore
+
+#endif // MESHCORE_PARAMETERIZATION_H
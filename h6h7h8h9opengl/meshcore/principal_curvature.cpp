@@ -0,0 +1,226 @@
+#include "principal_curvature.h"
+#include "laplacian.h"
+#include <algorithm>
+#include <cmath>
+
+namespace meshcore {
+
+namespace {
+
+struct Vec3 {
+    float x, y, z;
+};
+
+inline Vec3 load(const float* p) { return {p[0], p[1], p[2]}; }
+inline Vec3 operator+(Vec3 a, Vec3 b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline Vec3 operator-(Vec3 a, Vec3 b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline Vec3 operator*(float s, Vec3 a) { return {s * a.x, s * a.y, s * a.z}; }
+inline Vec3 operator-(Vec3 a) { return {-a.x, -a.y, -a.z}; }
+inline float dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 cross(Vec3 a, Vec3 b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+inline float length(Vec3 a) { return std::sqrt(dot(a, a)); }
+inline Vec3 normalized(Vec3 a)
+{
+    const float len = length(a);
+    return len > 0.0f ? (1.0f / len) * a : a;
+}
+inline void store(float* p, Vec3 a) { p[0] = a.x; p[1] = a.y; p[2] = a.z; }
+
+// 把坐标系(u,v)绕轴旋转，使其法向与newNormal一致
+void rotateFrame(Vec3& u, Vec3& v, Vec3 newNormal)
+{
+    const Vec3 oldNormal = cross(u, v);
+    const float ndot = dot(oldNormal, newNormal);
+    if (ndot <= -1.0f) {
+        u = -u;
+        v = -v;
+        return;
+    }
+    const Vec3 perpOld = newNormal - ndot * oldNormal;
+    const Vec3 dperp = (1.0f / (1.0f + ndot)) * (oldNormal + newNormal);
+    u = u - dot(perpOld, u) * dperp;
+    v = v - dot(perpOld, v) * dperp;
+}
+
+// 将坐标系(oldU,oldV)下的张量(ku,kuv,kv)变换到(newU,newV)下
+void projectTensor(Vec3 oldU, Vec3 oldV, float ku, float kuv, float kv,
+                   Vec3 newU, Vec3 newV, float& outKu, float& outKuv, float& outKv)
+{
+    rotateFrame(newU, newV, cross(oldU, oldV));
+    const float u1 = dot(newU, oldU), v1 = dot(newU, oldV);
+    const float u2 = dot(newV, oldU), v2 = dot(newV, oldV);
+    outKu = ku * u1 * u1 + kuv * (2.0f * u1 * v1) + kv * v1 * v1;
+    outKuv = ku * u1 * u2 + kuv * (u1 * v2 + u2 * v1) + kv * v1 * v2;
+    outKv = ku * u2 * u2 + kuv * (2.0f * u2 * v2) + kv * v2 * v2;
+}
+
+// 求解3x3对称正定系统（LDLT），奇异时返回false
+bool solveSymmetric3(float a[3][3], float b[3], float x[3])
+{
+    float d[3], l[3][3] = {};
+    for (int i = 0; i < 3; ++i) {
+        float s = a[i][i];
+        for (int k = 0; k < i; ++k) s -= l[i][k] * l[i][k] * d[k];
+        if (std::fabs(s) < 1e-20f) return false;
+        d[i] = s;
+        for (int j = i + 1; j < 3; ++j) {
+            float t = a[j][i];
+            for (int k = 0; k < i; ++k) t -= l[j][k] * l[i][k] * d[k];
+            l[j][i] = t / d[i];
+        }
+    }
+    float y[3];
+    for (int i = 0; i < 3; ++i) {
+        y[i] = b[i];
+        for (int k = 0; k < i; ++k) y[i] -= l[i][k] * y[k];
+    }
+    for (int i = 2; i >= 0; --i) {
+        x[i] = y[i] / d[i];
+        for (int k = i + 1; k < 3; ++k) x[i] -= l[k][i] * x[k];
+    }
+    return true;
+}
+
+} // namespace
+
+void computePrincipalCurvatures(const FlatMesh& mesh, const VertexCorners& adjacency,
+                                PrincipalCurvatures& result)
+{
+    const long long nv = static_cast<long long>(mesh.vertexCount());
+    const long long nt = static_cast<long long>(mesh.triangleCount());
+    const float* pos = mesh.positions.data();
+    const unsigned int* tri = mesh.triangles.data();
+
+    // 1. 三角形：未归一化法线（长度为面积的2倍）与各角面积
+    std::vector<float> faceNormals(nt * 3);
+    std::vector<float> areas(nt * 3);
+    #pragma omp parallel for schedule(static)
+    for (long long t = 0; t < nt; ++t) {
+        const Vec3 p0 = load(pos + 3 * tri[3 * t]);
+        const Vec3 p1 = load(pos + 3 * tri[3 * t + 1]);
+        const Vec3 p2 = load(pos + 3 * tri[3 * t + 2]);
+        const Vec3 n = cross(p1 - p0, p2 - p0);
+        store(&faceNormals[3 * t], n);
+        TriangleCorners corners;
+        triangleCorners(pos + 3 * tri[3 * t], pos + 3 * tri[3 * t + 1], pos + 3 * tri[3 * t + 2], corners);
+        std::copy(corners.area, corners.area + 3, &areas[3 * t]);
+    }
+
+    // 2. 顶点：面积加权法线与初始局部坐标系
+    result.normals.assign(nv * 3, 0.0f);
+    result.dir1.assign(nv * 3, 0.0f);
+    result.dir2.assign(nv * 3, 0.0f);
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        Vec3 n = {0.0f, 0.0f, 0.0f};
+        for (unsigned int i = adjacency.begin(v); i < adjacency.end(v); ++i) {
+            n = n + load(&faceNormals[3 * (adjacency.corners[i] / 3)]);
+        }
+        n = normalized(n);
+        store(&result.normals[3 * v], n);
+
+        Vec3 u = {0.0f, 0.0f, 0.0f};
+        if (adjacency.begin(v) < adjacency.end(v)) {
+            const unsigned int c = adjacency.corners[adjacency.begin(v)];
+            const unsigned int next = tri[c - c % 3 + (c + 1) % 3];
+            u = load(pos + 3 * next) - load(pos + 3 * v);
+        }
+        u = normalized(cross(u, n));
+        store(&result.dir1[3 * v], u);
+        store(&result.dir2[3 * v], cross(n, u));
+    }
+
+    // 3. 三角形：拟合第二基本形式并变换到各角顶点的坐标系，按角面积加权
+    std::vector<float> cornerTensor(nt * 9);
+    #pragma omp parallel for schedule(static)
+    for (long long t = 0; t < nt; ++t) {
+        float* out = &cornerTensor[9 * t];
+        std::fill(out, out + 9, 0.0f);
+        const unsigned int vi[3] = {tri[3 * t], tri[3 * t + 1], tri[3 * t + 2]};
+        const Vec3 p[3] = {load(pos + 3 * vi[0]), load(pos + 3 * vi[1]), load(pos + 3 * vi[2])};
+        const Vec3 e[3] = {p[2] - p[1], p[0] - p[2], p[1] - p[0]};
+        const Vec3 fn = load(&faceNormals[3 * t]);
+        if (length(fn) <= 0.0f) continue;
+
+        // 面内正交坐标系(tu, tv)
+        const Vec3 tu = normalized(e[0]);
+        const Vec3 tv = normalized(cross(fn, tu));
+
+        float w[3][3] = {}, m[3] = {};
+        for (int j = 0; j < 3; ++j) {
+            const float u = dot(e[j], tu);
+            const float v = dot(e[j], tv);
+            w[0][0] += u * u;
+            w[0][1] += u * v;
+            w[2][2] += v * v;
+            const Vec3 dn = load(&result.normals[3 * vi[(j + 2) % 3]]) - load(&result.normals[3 * vi[(j + 1) % 3]]);
+            const float dnu = dot(dn, tu);
+            const float dnv = dot(dn, tv);
+            m[0] += dnu * u;
+            m[1] += dnu * v + dnv * u;
+            m[2] += dnv * v;
+        }
+        w[1][1] = w[0][0] + w[2][2];
+        w[1][2] = w[0][1];
+        w[1][0] = w[0][1];
+        w[2][1] = w[1][2];
+        float x[3];
+        if (!solveSymmetric3(w, m, x)) continue;
+
+        for (int j = 0; j < 3; ++j) {
+            float ku, kuv, kv;
+            projectTensor(tu, tv, x[0], x[1], x[2],
+                          load(&result.dir1[3 * vi[j]]), load(&result.dir2[3 * vi[j]]), ku, kuv, kv);
+            const float a = areas[3 * t + j];
+            out[3 * j] = a * ku;
+            out[3 * j + 1] = a * kuv;
+            out[3 * j + 2] = a * kv;
+        }
+    }
+
+    // 4. 顶点：汇总张量并对角化
+    result.k1.assign(nv, 0.0f);
+    result.k2.assign(nv, 0.0f);
+    #pragma omp parallel for schedule(static)
+    for (long long v = 0; v < nv; ++v) {
+        float ku = 0.0f, kuv = 0.0f, kv = 0.0f, area = 0.0f;
+        for (unsigned int i = adjacency.begin(v); i < adjacency.end(v); ++i) {
+            const unsigned int c = adjacency.corners[i];
+            const float* tensor = &cornerTensor[9 * (c / 3) + 3 * (c % 3)];
+            ku += tensor[0];
+            kuv += tensor[1];
+            kv += tensor[2];
+            area += areas[c];
+        }
+        if (area <= 0.0f) continue;
+        ku /= area;
+        kuv /= area;
+        kv /= area;
+
+        // 2x2对称矩阵的Jacobi旋转
+        float c = 1.0f, s = 0.0f, tt = 0.0f;
+        if (kuv != 0.0f) {
+            const float h = 0.5f * (kv - ku) / kuv;
+            tt = h < 0.0f ? 1.0f / (h - std::sqrt(1.0f + h * h)) : 1.0f / (h + std::sqrt(1.0f + h * h));
+            c = 1.0f / std::sqrt(1.0f + tt * tt);
+            s = tt * c;
+        }
+        float k1 = ku - tt * kuv;
+        float k2 = kv + tt * kuv;
+        const Vec3 u = load(&result.dir1[3 * v]);
+        const Vec3 w = load(&result.dir2[3 * v]);
+        const Vec3 n = load(&result.normals[3 * v]);
+        Vec3 d1 = c * u - s * w;
+        if (k1 < k2) {
+            std::swap(k1, k2);
+            d1 = s * u + c * w;
+        }
+        d1 = normalized(d1);
+        result.k1[v] = k1;
+        result.k2[v] = k2;
+        store(&result.dir1[3 * v], d1);
+        store(&result.dir2[3 * v], cross(n, d1));
+    }
+}
+
+} // namespace meshcore
@@ -0,0 +1,27 @@
+#ifndef MESHCORE_PRINCIPAL_CURVATURE_H
+#define MESHCORE_PRINCIPAL_CURVATURE_H
+
+#include "flat_mesh.h"
+#include <vector>
+
+namespace meshcore {
+
+// Principal curvatures and directions per vertex (每个顶点的主曲率与主方向)
+struct PrincipalCurvatures {
+    std::vector<float> k1, k2;         // Signed, k1 >= k2 (有符号，k1 >= k2)
+    std::vector<float> dir1, dir2;     // Unit tangent directions xyz (单位切向主方向)
+    std::vector<float> normals;        // Area-weighted vertex normals used by the fit (拟合用的面积加权法线)
+};
+
+// Rusinkiewicz-style estimator: a second fundamental form is fitted per triangle
+// from the normal variation along its edges, rotated into each corner's vertex
+// frame and averaged with mixed-area weights, then diagonalized per vertex.
+// Triangles and vertices are processed in parallel.
+// Rusinkiewicz方法：逐三角形由边上法线变化拟合第二基本形式，旋转到各角顶点的
+// 局部坐标系后按混合面积加权平均，再逐顶点对角化；三角形与顶点均并行处理
+void computePrincipalCurvatures(const FlatMesh& mesh, const VertexCorners& adjacency,
+                                PrincipalCurvatures& result);
+
+} // namespace meshcore
+
+#endif // MESHCORE_PRINCIPAL_CURVATURE_H
@@ -0,0 +1,434 @@
+#include "progressive_mesh.h"
+#include "mesh_io.h"
+#include "qem_common.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+
+namespace meshcore {
+
+namespace {
+
+using qem::Quadric;
+
+// 折叠序列的原始记录，面、边与角以原始编号表示；*Ends为每次折叠结束时的累计长度
+struct ProgressiveRecord {
+    std::vector<unsigned int> kept, removed;
+    std::vector<unsigned int> faceChanges, edgeChanges;         // 3*面+角 / 2*边+端点
+    std::vector<unsigned int> removedFaces, removedEdges;
+    std::vector<unsigned int> faceChangeEnds, edgeChangeEnds, removedFaceEnds, removedEdgeEnds;
+};
+
+struct Candidate {
+    double cost;
+    unsigned int from, to;              // 折叠from -> to
+    unsigned int fromStamp, toStamp;    // 入堆时两端的版本号，不一致即已过时
+
+    bool operator>(const Candidate& o) const { return cost > o.cost; }
+};
+
+// 折叠过程中的可变连接关系：顶点到面、顶点到边的邻接表
+class CollapseRecorder {
+public:
+    CollapseRecorder(const FlatMesh& mesh, const std::vector<unsigned int>& edges)
+        : mesh_(mesh), p_(mesh.positions.data()), tri_(mesh.triangles), edge_(edges)
+    {
+        const size_t nv = mesh.vertexCount();
+        const size_t nf = mesh.triangleCount();
+        const size_t ne = edge_.size() / 2;
+        vertexFaces_.resize(nv);
+        vertexEdges_.resize(nv);
+        for (size_t f = 0; f < nf; ++f) {
+            for (int k = 0; k < 3; ++k) vertexFaces_[tri_[3 * f + k]].push_back(static_cast<unsigned int>(f));
+        }
+        for (size_t e = 0; e < ne; ++e) {
+            vertexEdges_[edge_[2 * e]].push_back(static_cast<unsigned int>(e));
+            vertexEdges_[edge_[2 * e + 1]].push_back(static_cast<unsigned int>(e));
+        }
+        alive_.assign(nv, 1);
+        stamp_.assign(nv, 0);
+        mark_.assign(nv, 0);
+        boundary_.assign(nv, 0);
+        locked_.assign(nv, 0);
+        quadric_.resize(nv);
+        aliveCount_ = 0;
+        for (size_t v = 0; v < nv; ++v) aliveCount_ += !vertexFaces_[v].empty();
+    }
+
+    // 面平面二次误差（按面积加权），边界边加垂直约束平面；非流形边的端点锁定
+    void initialize()
+    {
+        const size_t nf = mesh_.triangleCount();
+        for (size_t f = 0; f < nf; ++f) {
+            const unsigned int* t = &tri_[3 * f];
+            double n[3];
+            qem::triangleNormal(p_ + 3 * t[0], p_ + 3 * t[1], p_ + 3 * t[2], n);
+            const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len <= 0.0) continue;
+            const double a = n[0] / len, b = n[1] / len, c = n[2] / len;
+            const float* x = p_ + 3 * t[0];
+            const double d = -(a * x[0] + b * x[1] + c * x[2]);
+            for (int k = 0; k < 3; ++k) quadric_[t[k]].addPlane(a, b, c, d, 0.5 * len);
+        }
+
+        const size_t ne = edge_.size() / 2;
+        for (size_t e = 0; e < ne; ++e) {
+            const unsigned int a = edge_[2 * e], b = edge_[2 * e + 1];
+            unsigned int shared = 0, face = 0;
+            for (unsigned int f : vertexFaces_[a]) {
+                if (hasVertex(f, b)) { ++shared; face = f; }
+            }
+            if (shared > 2) {
+                locked_[a] = locked_[b] = 1;
+            } else if (shared == 1) {
+                boundary_[a] = boundary_[b] = 1;
+                const unsigned int* t = &tri_[3 * face];
+                double n[3], plane[4], weight;
+                qem::triangleNormal(p_ + 3 * t[0], p_ + 3 * t[1], p_ + 3 * t[2], n);
+                if (!qem::boundaryPlane(p_ + 3 * a, p_ + 3 * b, n, plane, weight)) continue;
+                quadric_[a].addPlane(plane[0], plane[1], plane[2], plane[3], weight);
+                quadric_[b].addPlane(plane[0], plane[1], plane[2], plane[3], weight);
+            }
+        }
+
+        for (size_t e = 0; e < ne; ++e) {
+            pushEdge(edge_[2 * e], edge_[2 * e + 1]);
+        }
+    }
+
+    // 按代价从小到大执行合法折叠，直到剩余minVertices个顶点或没有候选
+    void run(size_t minVertices, ProgressiveRecord& record)
+    {
+        while (!heap_.empty() && aliveCount_ > minVertices) {
+            const Candidate c = heap_.top();
+            heap_.pop();
+            if (!alive_[c.from] || !alive_[c.to]) continue;
+            if (stamp_[c.from] != c.fromStamp || stamp_[c.to] != c.toStamp) continue;
+            if (!collapseAllowed(c.from, c.to)) continue;
+            collapse(c.from, c.to, record);
+        }
+    }
+
+private:
+    bool hasVertex(unsigned int f, unsigned int v) const
+    {
+        return tri_[3 * f] == v || tri_[3 * f + 1] == v || tri_[3 * f + 2] == v;
+    }
+
+    void pushEdge(unsigned int a, unsigned int b)
+    {
+        Quadric q = quadric_[a];
+        q.add(quadric_[b]);
+        if (!locked_[a]) heap_.push({q.evaluate(p_ + 3 * b), a, b, stamp_[a], stamp_[b]});
+        if (!locked_[b]) heap_.push({q.evaluate(p_ + 3 * a), b, a, stamp_[b], stamp_[a]});
+    }
+
+    bool collapseAllowed(unsigned int v, unsigned int u)
+    {
+        // 共享面：内部边2个，边界边1个
+        unsigned int shared = 0;
+        for (unsigned int f : vertexFaces_[v]) {
+            shared += hasVertex(f, u);
+        }
+        if (shared == 0 || shared > 2) return false;
+        // 边界顶点只能沿边界边移动，否则边界会被撕开或收缩
+        if (boundary_[v] && shared != 1) return false;
+
+        // 连接条件：u、v的公共邻点恰好是共享面的第三个顶点
+        ++token_;
+        for (unsigned int e : vertexEdges_[u]) {
+            mark_[other(e, u)] = token_;
+        }
+        unsigned int common = 0;
+        for (unsigned int e : vertexEdges_[v]) {
+            common += mark_[other(e, v)] == token_;
+        }
+        if (common != shared) return false;
+
+        // v的其余面在v移到u后不得翻转或退化
+        const float* pu = p_ + 3 * u;
+        for (unsigned int f : vertexFaces_[v]) {
+            if (hasVertex(f, u)) continue;
+            const float* corner[3];
+            const float* moved[3];
+            for (int k = 0; k < 3; ++k) {
+                corner[k] = p_ + 3 * tri_[3 * f + k];
+                moved[k] = tri_[3 * f + k] == v ? pu : corner[k];
+            }
+            double before[3], after[3];
+            qem::triangleNormal(corner[0], corner[1], corner[2], before);
+            qem::triangleNormal(moved[0], moved[1], moved[2], after);
+            if (qem::foldsOver(before, after)) return false;
+        }
+        return true;
+    }
+
+    unsigned int other(unsigned int e, unsigned int v) const
+    {
+        return edge_[2 * e] == v ? edge_[2 * e + 1] : edge_[2 * e];
+    }
+
+    void eraseFrom(std::vector<unsigned int>& list, unsigned int value)
+    {
+        auto it = std::find(list.begin(), list.end(), value);
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    }
+
+    void collapse(unsigned int v, unsigned int u, ProgressiveRecord& record)
+    {
+        record.kept.push_back(u);
+        record.removed.push_back(v);
+
+        // 含u的面被删除，其余面的v角改为u
+        for (unsigned int f : vertexFaces_[v]) {
+            if (hasVertex(f, u)) {
+                record.removedFaces.push_back(f);
+                for (int k = 0; k < 3; ++k) {
+                    const unsigned int w = tri_[3 * f + k];
+                    if (w != v) eraseFrom(vertexFaces_[w], f);
+                }
+            } else {
+                for (int k = 0; k < 3; ++k) {
+                    if (tri_[3 * f + k] == v) {
+                        tri_[3 * f + k] = u;
+                        record.faceChanges.push_back(3 * f + k);
+                    }
+                }
+                vertexFaces_[u].push_back(f);
+            }
+        }
+
+        // 边uv删除；v的其余边若与u的边重合则删除，否则端点v改为u
+        ++token_;
+        for (unsigned int e : vertexEdges_[u]) {
+            mark_[other(e, u)] = token_;
+        }
+        for (unsigned int e : vertexEdges_[v]) {
+            const unsigned int w = other(e, v);
+            if (w == u || mark_[w] == token_) {
+                record.removedEdges.push_back(e);
+                eraseFrom(vertexEdges_[w], e);
+            } else {
+                const unsigned int end = edge_[2 * e] == v ? 0 : 1;
+                edge_[2 * e + end] = u;
+                record.edgeChanges.push_back(2 * e + end);
+                vertexEdges_[u].push_back(e);
+            }
+        }
+        record.faceChangeEnds.push_back(static_cast<unsigned int>(record.faceChanges.size()));
+        record.edgeChangeEnds.push_back(static_cast<unsigned int>(record.edgeChanges.size()));
+        record.removedFaceEnds.push_back(static_cast<unsigned int>(record.removedFaces.size()));
+        record.removedEdgeEnds.push_back(static_cast<unsigned int>(record.removedEdges.size()));
+
+        alive_[v] = 0;
+        --aliveCount_;
+        std::vector<unsigned int>().swap(vertexFaces_[v]);
+        std::vector<unsigned int>().swap(vertexEdges_[v]);
+        quadric_[u].add(quadric_[v]);
+        boundary_[u] |= boundary_[v];
+
+        // u的二次误差已变，以u为端点的候选全部重新入堆
+        ++stamp_[u];
+        for (unsigned int e : vertexEdges_[u]) {
+            pushEdge(u, other(e, u));
+        }
+    }
+
+    const FlatMesh& mesh_;
+    const float* p_;
+    std::vector<unsigned int> tri_;             // 当前（已折叠）的三角形
+    std::vector<unsigned int> edge_;            // 当前的边端点
+    std::vector<std::vector<unsigned int>> vertexFaces_;
+    std::vector<std::vector<unsigned int>> vertexEdges_;
+    std::vector<unsigned char> alive_, boundary_, locked_;
+    std::vector<unsigned int> stamp_, mark_;
+    unsigned int token_ = 0;
+    std::vector<Quadric> quadric_;
+    size_t aliveCount_;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> heap_;
+};
+
+// 三角形的唯一无向边，按(min,max)排序
+void collectEdges(const FlatMesh& mesh, std::vector<unsigned int>& edges)
+{
+    std::vector<uint64_t> keys;
+    keys.reserve(mesh.triangles.size());
+    for (size_t f = 0; f < mesh.triangleCount(); ++f) {
+        for (int k = 0; k < 3; ++k) {
+            const uint64_t a = mesh.triangles[3 * f + k];
+            const uint64_t b = mesh.triangles[3 * f + (k + 1) % 3];
+            keys.push_back(a < b ? (a << 32 | b) : (b << 32 | a));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    edges.resize(keys.size() * 2);
+    for (size_t e = 0; e < keys.size(); ++e) {
+        edges[2 * e] = static_cast<unsigned int>(keys[e] >> 32);
+        edges[2 * e + 1] = static_cast<unsigned int>(keys[e] & 0xffffffffu);
+    }
+}
+
+// 槽位：从未删除的元素在前，其后按删除时间倒序；counts[c]为c次折叠后的有效元素数
+void assignSlots(size_t elementCount, const std::vector<unsigned int>& removed,
+                 const std::vector<unsigned int>& removedEnds, std::vector<unsigned int>& slot,
+                 std::vector<unsigned int>& counts)
+{
+    const size_t collapses = removedEnds.size();
+    std::vector<unsigned char> isRemoved(elementCount, 0);
+    for (unsigned int e : removed) isRemoved[e] = 1;
+    slot.assign(elementCount, 0);
+    unsigned int next = 0;
+    for (size_t e = 0; e < elementCount; ++e) {
+        if (!isRemoved[e]) slot[e] = next++;
+    }
+    counts.assign(collapses + 1, 0);
+    counts[collapses] = next;
+    for (size_t c = collapses; c-- > 0;) {
+        const unsigned int begin = c == 0 ? 0 : removedEnds[c - 1];
+        for (unsigned int i = begin; i < removedEnds[c]; ++i) {
+            slot[removed[i]] = next++;
+        }
+        counts[c] = next;
+    }
+}
+
+} // namespace
+
+void ProgressiveMesh::clear()
+{
+    positions_.clear();
+    faces0_.clear();
+    edges0_.clear();
+    faceCounts_.assign(1, 0);
+    edgeCounts_.assign(1, 0);
+    kept_.clear();
+    removed_.clear();
+    faceChangeOffsets_.assign(1, 0);
+    faceChanges_.clear();
+    edgeChangeOffsets_.assign(1, 0);
+    edgeChanges_.clear();
+}
+
+bool ProgressiveMesh::build(const Mesh& mesh)
+{
+    FlatMesh flat;
+    toFlatMesh(mesh, flat);
+    return build(flat);
+}
+
+bool ProgressiveMesh::build(const FlatMesh& mesh)
+{
+    clear();
+    if (mesh.vertexCount() == 0 || mesh.triangleCount() == 0) return false;
+
+    std::vector<unsigned int> edges;
+    collectEdges(mesh, edges);
+    ProgressiveRecord record;
+    {
+        CollapseRecorder recorder(mesh, edges);
+        recorder.initialize();
+        recorder.run(kMinVertices, record);
+    }
+
+    // 把以原始编号记录的面、边与角换成槽位编号
+    std::vector<unsigned int> faceSlot, edgeSlot;
+    assignSlots(mesh.triangleCount(), record.removedFaces, record.removedFaceEnds, faceSlot, faceCounts_);
+    assignSlots(edges.size() / 2, record.removedEdges, record.removedEdgeEnds, edgeSlot, edgeCounts_);
+
+    positions_ = mesh.positions;
+    faces0_.resize(mesh.triangles.size());
+    for (size_t f = 0; f < mesh.triangleCount(); ++f) {
+        for (int k = 0; k < 3; ++k) faces0_[3 * faceSlot[f] + k] = mesh.triangles[3 * f + k];
+    }
+    edges0_.resize(edges.size());
+    for (size_t e = 0; e < edges.size() / 2; ++e) {
+        edges0_[2 * edgeSlot[e]] = edges[2 * e];
+        edges0_[2 * edgeSlot[e] + 1] = edges[2 * e + 1];
+    }
+
+    kept_.swap(record.kept);
+    removed_.swap(record.removed);
+    faceChanges_.swap(record.faceChanges);
+    for (unsigned int& c : faceChanges_) c = 3 * faceSlot[c / 3] + c % 3;
+    edgeChanges_.swap(record.edgeChanges);
+    for (unsigned int& c : edgeChanges_) c = 2 * edgeSlot[c / 2] + c % 2;
+    faceChangeOffsets_.insert(faceChangeOffsets_.end(), record.faceChangeEnds.begin(), record.faceChangeEnds.end());
+    edgeChangeOffsets_.insert(edgeChangeOffsets_.end(), record.edgeChangeEnds.begin(), record.edgeChangeEnds.end());
+    return true;
+}
+
+size_t ProgressiveMesh::collapsesForRatio(float ratio) const
+{
+    const size_t n = vertexCount();
+    size_t target = static_cast<size_t>(n * (1.0f - std::min(std::max(ratio, 0.0f), 1.0f)));
+    target = std::max(target, kMinVertices);
+    return std::min(n > target ? n - target : 0, maxCollapses());
+}
+
+void ProgressiveMesh::reset(Level& level) const
+{
+    level.faces = faces0_;
+    level.edges = edges0_;
+    level.collapses = 0;
+}
+
+size_t ProgressiveMesh::seek(Level& level, size_t collapses) const
+{
+    collapses = std::min(collapses, maxCollapses());
+    const size_t begin = std::min(level.collapses, collapses);
+    const size_t end = std::max(level.collapses, collapses);
+    // 同一个角可能被先后多次折叠改写，撤销时必须倒序
+    const auto write = [&](size_t c, unsigned int value) {
+        for (unsigned int i = faceChangeOffsets_[c]; i < faceChangeOffsets_[c + 1]; ++i) {
+            level.faces[faceChanges_[i]] = value;
+        }
+        for (unsigned int i = edgeChangeOffsets_[c]; i < edgeChangeOffsets_[c + 1]; ++i) {
+            level.edges[edgeChanges_[i]] = value;
+        }
+    };
+    if (collapses > level.collapses) {
+        for (size_t c = begin; c < end; ++c) write(c, kept_[c]);
+    } else {
+        for (size_t c = end; c-- > begin;) write(c, removed_[c]);
+    }
+    level.collapses = collapses;
+    return (faceChangeOffsets_[end] - faceChangeOffsets_[begin]) + (edgeChangeOffsets_[end] - edgeChangeOffsets_[begin]);
+}
+
+bool ProgressiveMesh::extract(size_t collapses, Mesh& mesh, const std::vector<float>* texCoords) const
+{
+    if (positions_.empty()) return false;
+    Level level;
+    reset(level);
+    seek(level, collapses);
+
+    FlatMesh flat;
+    flat.positions = positions_;
+    flat.triangles.assign(level.faces.begin(), level.faces.begin() + faceIndexCount(level.collapses));
+    std::vector<unsigned char> referenced;
+    if (texCoords && texCoords->size() == 2 * vertexCount()) {
+        referenced.assign(vertexCount(), 0);
+        for (unsigned int v : flat.triangles) referenced[v] = 1;
+    }
+    removeUnreferencedVertices(flat);
+    if (!fromFlatMesh(flat, mesh)) return false;
+
+    // 压缩保持剩余顶点的原有顺序
+    if (!referenced.empty()) {
+        mesh.request_vertex_texcoords2D();
+        int next = 0;
+        for (size_t v = 0; v < referenced.size(); ++v) {
+            if (!referenced[v]) continue;
+            mesh.set_texcoord2D(Mesh::VertexHandle(next++), Mesh::TexCoord2D((*texCoords)[2 * v], (*texCoords)[2 * v + 1]));
+        }
+    }
+    return true;
+}
+
+} // namespace meshcore
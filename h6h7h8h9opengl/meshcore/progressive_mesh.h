@@ -0,0 +1,74 @@
+#ifndef MESHCORE_PROGRESSIVE_MESH_H
+#define MESHCORE_PROGRESSIVE_MESH_H
+
+#include "mesh_types.h"
+#include "flat_mesh.h"
+#include <cstddef>
+#include <vector>
+
+namespace meshcore {
+
+// Progressive mesh (Hoppe 1996) recorded from one run of QEM half-edge collapses.
+// A collapse moves vertex `removed` onto vertex `kept`, which keeps its position, so every
+// level uses the original vertex buffer and only index buffers change. Faces and edges are
+// stored in the reverse order of their removal: the active ones at any level are a prefix.
+// Moving between levels rewrites only the corners touched by the collapses in between.
+// 由一次QEM半边折叠记录的渐进网格。每次折叠把顶点removed并到保留原位置的顶点kept上，
+// 因此各层级共用原始顶点缓冲，只有索引缓冲变化。面与边按删除的逆序存放，任一层级的有效部分都是前缀。
+// 层级之间切换只改写其间折叠涉及的角
+class ProgressiveMesh {
+public:
+    // Index buffers of one level, edited in place by seek (某一层级的索引缓冲，由seek就地修改)
+    struct Level {
+        std::vector<unsigned int> faces;    // 3 per triangle; first faceIndexCount(collapses) are active (前faceIndexCount个有效)
+        std::vector<unsigned int> edges;    // 2 per edge; first edgeIndexCount(collapses) are active (前edgeIndexCount个有效)
+        size_t collapses = 0;               // Collapses applied (已应用的折叠数)
+    };
+
+    ProgressiveMesh() { clear(); }
+
+    // Record the collapse sequence down to kMinVertices; false for an empty mesh
+    // 记录直到kMinVertices个顶点的折叠序列；空网格返回false
+    bool build(const FlatMesh& mesh);
+    bool build(const Mesh& mesh);
+    void clear();
+
+    size_t vertexCount() const { return positions_.size() / 3; }
+    const std::vector<float>& positions() const { return positions_; }   // Original positions, xyz per vertex (原始顶点位置)
+    size_t maxCollapses() const { return kept_.size(); }
+    // Collapses that remove `ratio` (0-1) of the vertices, clamped to the recorded sequence
+    // 删除ratio比例(0-1)顶点所需的折叠数，不超过已记录的序列
+    size_t collapsesForRatio(float ratio) const;
+    size_t faceIndexCount(size_t collapses) const { return 3 * faceCounts_[collapses]; }
+    size_t edgeIndexCount(size_t collapses) const { return 2 * edgeCounts_[collapses]; }
+
+    void reset(Level& level) const;                        // Full-resolution buffers (全分辨率索引)
+    // Apply or undo collapses until `collapses` are applied; cost is proportional to the
+    // corners changed in between. Returns the number of rewritten indices.
+    // 应用或撤销折叠直到已应用collapses个；代价与其间改变的角数成正比。返回改写的索引个数
+    size_t seek(Level& level, size_t collapses) const;
+
+    // Compact the mesh at a level into a half-edge mesh. Surviving vertices never move, so
+    // per-vertex texcoords of the original (2 per vertex) carry over unchanged when given.
+    // 将某层级的网格压缩为半边网格。保留的顶点从不移动，给出原始网格的逐顶点纹理坐标（每个顶点2个）时原样带入
+    bool extract(size_t collapses, Mesh& mesh, const std::vector<float>* texCoords = nullptr) const;
+
+    static constexpr size_t kMinVertices = 4;
+
+private:
+    std::vector<float> positions_;              // Original positions (原始顶点位置)
+    std::vector<unsigned int> faces0_;          // Level 0 faces in slot order (按槽位排列的第0层面索引)
+    std::vector<unsigned int> edges0_;
+    std::vector<unsigned int> faceCounts_;      // Active triangles after c collapses (c次折叠后的有效三角形数)
+    std::vector<unsigned int> edgeCounts_;
+    std::vector<unsigned int> kept_;            // Per collapse (每次折叠)
+    std::vector<unsigned int> removed_;
+    std::vector<unsigned int> faceChangeOffsets_;   // Collapse c rewrites faceChanges_[offsets[c], offsets[c+1]) (折叠c改写的面角区间)
+    std::vector<unsigned int> faceChanges_;         // Index positions holding removed_[c] (值为removed_[c]的索引位置)
+    std::vector<unsigned int> edgeChangeOffsets_;
+    std::vector<unsigned int> edgeChanges_;
+};
+
+} // namespace meshcore
+
+#endif // MESHCORE_PROGRESSIVE_MESH_H
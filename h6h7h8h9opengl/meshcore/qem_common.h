@@ -0,0 +1,83 @@
+#ifndef MESHCORE_QEM_COMMON_H
+#define MESHCORE_QEM_COMMON_H
+
+#include <cmath>
+
+// Error metric and fold-over rule shared by the QEM simplifiers (progressive_mesh,
+// parallel_simplification, attribute_simplification). Internal to meshcore.
+// QEM简化器（渐进网格、并行简化、属性简化）共用的误差度量与翻转规则，仅供meshcore内部使用
+
+namespace meshcore {
+namespace qem {
+
+const double kBoundaryWeight = 100.0;   // Boundary constraint planes relative to the area-weighted face planes (边界约束平面相对面积加权面平面的权重)
+const double kMinNormalCos = 0.2;       // Lower bound on cos(face normal before, after) of a collapse; stops flips and slivers (折叠前后面法线夹角余弦的下限，防止翻转与狭长三角形)
+
+// Upper triangle of the symmetric 4x4 quadric: xx xy xz xw yy yz yw zz zw ww
+// 对称4x4二次误差矩阵的上三角：xx xy xz xw yy yz yw zz zw ww
+inline void addPlane(double q[10], double a, double b, double c, double d, double weight)
+{
+    q[0] += weight * a * a; q[1] += weight * a * b; q[2] += weight * a * c; q[3] += weight * a * d;
+    q[4] += weight * b * b; q[5] += weight * b * c; q[6] += weight * b * d;
+    q[7] += weight * c * c; q[8] += weight * c * d;
+    q[9] += weight * d * d;
+}
+
+inline double evaluate(const double q[10], double x, double y, double z)
+{
+    return x * (q[0] * x + q[1] * y + q[2] * z) + y * (q[1] * x + q[4] * y + q[5] * z)
+         + z * (q[2] * x + q[5] * y + q[7] * z) + 2.0 * (q[3] * x + q[6] * y + q[8] * z) + q[9];
+}
+
+struct Quadric {
+    double q[10] = {};
+
+    void addPlane(double a, double b, double c, double d, double weight) { qem::addPlane(q, a, b, c, d, weight); }
+    void add(const Quadric& o)
+    {
+        for (int i = 0; i < 10; ++i) q[i] += o.q[i];
+    }
+    double evaluate(const float* p) const { return qem::evaluate(q, p[0], p[1], p[2]); }
+};
+
+// Unnormalized normal (b - a) x (c - a), twice the area (未归一化的法线，长度为面积的两倍)
+template <typename T>
+inline void triangleNormal(const T* a, const T* b, const T* c, double n[3])
+{
+    const double e1[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+    const double e2[3] = {double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2]};
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+// Plane through the boundary edge a->b perpendicular to its face (normal n), weighted by the
+// squared edge length. False if the edge or the face is degenerate
+// 过边界边a->b且垂直于其所在面（法线n）的约束平面，权重按边长平方。边或面退化时返回false
+template <typename T>
+inline bool boundaryPlane(const T* a, const T* b, const double n[3], double plane[4], double& weight)
+{
+    const double dir[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+    double m[3] = {dir[1] * n[2] - dir[2] * n[1], dir[2] * n[0] - dir[0] * n[2], dir[0] * n[1] - dir[1] * n[0]};
+    const double length = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+    if (length <= 0.0) return false;
+    for (int k = 0; k < 3; ++k) plane[k] = m[k] / length;
+    plane[3] = -(plane[0] * a[0] + plane[1] * a[1] + plane[2] * a[2]);
+    weight = kBoundaryWeight * (dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+    return true;
+}
+
+// A collapse is rejected when a surviving face degenerates or turns by more than acos(kMinNormalCos)
+// 幸存面退化或法线转过acos(kMinNormalCos)以上时拒绝折叠
+inline bool foldsOver(const double before[3], const double after[3])
+{
+    const double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+    const double lb = std::sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2]);
+    const double la = std::sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+    return la <= 0.0 || dot <= kMinNormalCos * lb * la;
+}
+
+} // namespace qem
+} // namespace meshcore
+
+#endif // MESHCORE_QEM_COMMON_H
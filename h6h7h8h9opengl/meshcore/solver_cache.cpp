@@ -0,0 +1,218 @@
+#include "solver_cache.h"
+#include "meshcore_internal.h"
+#include <algorithm>
+#include <iostream>
+
+namespace meshcore {
+
+namespace {
+
+const double kIterativeTolerance = 1e-7;   // CG相对残差容差（位置以float存储，更小没有意义）
+
+// 以x的当前值为初值逐列求解，统计最坏列的迭代次数
+template <typename Solver>
+bool solveColumns(const Solver& solver, const Eigen::MatrixXd& rhs, Eigen::MatrixXd& x, SolveStats& stats)
+{
+    for (Eigen::Index c = 0; c < x.cols(); ++c) {
+        const Eigen::VectorXd column = solver.solveWithGuess(rhs.col(c), x.col(c));
+        x.col(c) = column;
+        stats.iterations = std::max(stats.iterations, static_cast<int>(solver.iterations()));
+        if (solver.info() != Eigen::Success) {
+            std::cerr << "CG did not converge: " << solver.iterations()
+                      << " iterations, error " << solver.error() << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+const char* dirichletMethodName(DirichletMethod method)
+{
+    switch (method) {
+    case DirichletMethod::Auto:              return "auto";
+    case DirichletMethod::Cholesky:          return "ldlt";
+    case DirichletMethod::ConjugateGradient: return "cg";
+    case DirichletMethod::Multigrid:         return "amg";
+    }
+    return "unknown";
+}
+
+void DirichletSolverCache::clear()
+{
+    patternKey_ = valuesKey_ = 0;
+    analyzed_ = factorized_ = false;
+    timeStep_ = 0.0;
+    mass_.resize(0);
+    interior_.clear();
+    stiffness_.resize(0, 0);
+    coupling_.resize(0, 0);
+}
+
+bool DirichletSolverCache::prepare(const LaplacianOperator& op, double timeStep)
+{
+    const size_t n = op.vertexCount();
+    size_t interiorCount = 0;
+    for (unsigned char b : op.isBoundary) {
+        interiorCount += !b;
+    }
+    DirichletMethod method = method_;
+    if (method == DirichletMethod::Auto) {
+        method = interiorCount > kIterativeSolveThreshold ? DirichletMethod::Multigrid
+                                                          : DirichletMethod::Cholesky;
+    }
+
+    uint64_t pattern = hashArray(op.offsets, kFnvOffset ^ static_cast<uint64_t>(method));
+    pattern = hashArray(op.columns, pattern);
+    pattern = hashArray(op.isBoundary, pattern);
+    uint64_t values = hashArray(op.values, pattern);
+    if (timeStep > 0.0) {
+        values = hashArray(op.mixedArea, values);
+        values = hashArray(std::vector<double>(1, timeStep), values);
+    }
+
+    stats_ = SolveStats();
+    stats_.method = method;
+    stats_.unknowns = interiorCount;
+    stats_.boundary = n - interiorCount;
+
+    // 权重与结构都未变：直接复用数值分解
+    if (factorized_ && values == valuesKey_) {
+        if (method == DirichletMethod::Multigrid) {
+            stats_.levels = static_cast<int>(multigrid_.preconditioner().levelCount());
+        }
+        return true;
+    }
+
+    const bool samePattern = analyzed_ && pattern == patternKey_;
+    if (!samePattern) {
+        interior_.clear();
+        for (size_t v = 0; v < n; ++v) {
+            if (!op.isBoundary[v]) interior_.push_back(static_cast<unsigned int>(v));
+        }
+    }
+    if (interior_.empty()) {
+        std::cerr << "Dirichlet system has no interior vertices" << std::endl;
+        return false;
+    }
+
+    // 顶点 -> 内部未知量编号
+    std::vector<int> unknown(n, -1);
+    for (size_t a = 0; a < interior_.size(); ++a) {
+        unknown[interior_[a]] = static_cast<int>(a);
+    }
+
+    // K = -L_II：对角为权重和，非对角为 -w_ij；到边界顶点的权重进入耦合块。
+    // 时间步时矩阵为 M_I + dt K，耦合块乘以dt
+    typedef Eigen::Triplet<double> Entry;
+    const double scale = timeStep > 0.0 ? timeStep : 1.0;
+    std::vector<Entry> stiffness, coupling;
+    stiffness.reserve(op.nonZeros() + interior_.size());
+    mass_.setZero(timeStep > 0.0 ? interior_.size() : 0);
+    for (size_t a = 0; a < interior_.size(); ++a) {
+        const unsigned int v = interior_[a];
+        double diagonal = scale * op.diagonal[v];
+        if (timeStep > 0.0) {
+            mass_[a] = op.mixedArea[v];
+            diagonal += mass_[a];
+        }
+        stiffness.emplace_back(a, a, diagonal);
+        for (unsigned int k = op.begin(v); k < op.end(v); ++k) {
+            const unsigned int j = op.columns[k];
+            if (unknown[j] >= 0) {
+                stiffness.emplace_back(a, unknown[j], -scale * op.values[k]);
+            } else {
+                coupling.emplace_back(a, j, scale * op.values[k]);
+            }
+        }
+    }
+    timeStep_ = timeStep;
+    stiffness_.resize(interior_.size(), interior_.size());
+    stiffness_.setFromTriplets(stiffness.begin(), stiffness.end());
+    coupling_.resize(interior_.size(), n);
+    coupling_.setFromTriplets(coupling.begin(), coupling.end());
+
+    // 结构改变时重新做符号分析（填充消减排序），否则只做数值分解/预处理器
+    active_ = method;
+    if (!samePattern) {
+        switch (active_) {
+        case DirichletMethod::ConjugateGradient: iterative_.analyzePattern(stiffness_); break;
+        case DirichletMethod::Multigrid:         multigrid_.analyzePattern(stiffness_); break;
+        default:                                 direct_.analyzePattern(stiffness_); break;
+        }
+        patternKey_ = pattern;
+        analyzed_ = true;
+        stats_.analyzed = true;
+        ++symbolicCount_;
+    }
+    Eigen::ComputationInfo info;
+    switch (active_) {
+    case DirichletMethod::ConjugateGradient:
+        iterative_.factorize(stiffness_);
+        iterative_.setTolerance(kIterativeTolerance);
+        info = iterative_.info();
+        break;
+    case DirichletMethod::Multigrid:
+        multigrid_.factorize(stiffness_);
+        multigrid_.setTolerance(kIterativeTolerance);
+        info = multigrid_.info();
+        stats_.levels = static_cast<int>(multigrid_.preconditioner().levelCount());
+        break;
+    default:
+        direct_.factorize(stiffness_);
+        info = direct_.info();
+        break;
+    }
+    ++numericCount_;
+    stats_.factorized = true;
+    factorized_ = info == Eigen::Success;
+    if (!factorized_) {
+        std::cerr << "Dirichlet system factorization failed" << std::endl;
+        return false;
+    }
+    valuesKey_ = values;
+    return true;
+}
+
+bool DirichletSolverCache::solve(Eigen::MatrixXd& x)
+{
+    if (!factorized_ || x.rows() != coupling_.cols()) return false;
+
+    // 所有坐标列组成一个分块右端；时间步时加上 M_I x_I
+    Eigen::MatrixXd rhs = coupling_ * x;
+    if (timeStep_ > 0.0) {
+        for (size_t a = 0; a < interior_.size(); ++a) {
+            rhs.row(a) += mass_[a] * x.row(interior_[a]);
+        }
+    }
+    Eigen::MatrixXd interior(interior_.size(), x.cols());
+    if (active_ == DirichletMethod::Cholesky) {
+        interior = direct_.solve(rhs);
+        if (direct_.info() != Eigen::Success) return false;
+    } else {
+        // 迭代法以当前内部值为初值
+        for (size_t a = 0; a < interior_.size(); ++a) {
+            interior.row(a) = x.row(interior_[a]);
+        }
+        const bool converged = active_ == DirichletMethod::Multigrid
+                                   ? solveColumns(multigrid_, rhs, interior, stats_)
+                                   : solveColumns(iterative_, rhs, interior, stats_);
+        if (!converged) return false;
+    }
+
+    // 各列的相对残差 |Kx - b| / |b|
+    const Eigen::MatrixXd residual = stiffness_ * interior - rhs;
+    for (Eigen::Index c = 0; c < x.cols(); ++c) {
+        const double norm = rhs.col(c).norm();
+        stats_.residual = std::max(stats_.residual,
+                                   norm > 0.0 ? residual.col(c).norm() / norm : residual.col(c).norm());
+    }
+
+    for (size_t a = 0; a < interior_.size(); ++a) {
+        x.row(interior_[a]) = interior.row(a);
+    }
+    return true;
+}
+
+} // namespace meshcore
@@ -0,0 +1,105 @@
+#ifndef MESHCORE_SOLVER_CACHE_H
+#define MESHCORE_SOLVER_CACHE_H
+
+#include "laplacian.h"
+#include "multigrid.h"
+#include <cstdint>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <Eigen/IterativeLinearSolvers>
+
+namespace meshcore {
+
+// How the interior system is solved (内部系统的求解方式)
+enum class DirichletMethod {
+    Auto,                // LDLT up to kIterativeSolveThreshold unknowns, multigrid above (规模较小用LDLT，否则用多重网格)
+    Cholesky,            // Sparse LDLT factorization (稀疏LDLT分解)
+    ConjugateGradient,   // CG with incomplete Cholesky, warm-started (不完全Cholesky预处理CG，热启动)
+    Multigrid            // CG with an algebraic multigrid V-cycle, warm-started (代数多重网格预处理CG，热启动)
+};
+
+// Short name for logs: "auto", "ldlt", "cg", "amg" (日志用的简称)
+const char* dirichletMethodName(DirichletMethod method);
+
+// Interior unknowns above which Auto switches to multigrid: the fill-in of the direct
+// factor grows faster than the (linear) multigrid cost
+// 超过该内部未知量个数时Auto改用多重网格：直接分解的填充增长快于多重网格的线性代价
+const size_t kIterativeSolveThreshold = 200000;
+
+// Outcome of the last prepare/solve (最近一次准备与求解的结果)
+struct SolveStats {
+    DirichletMethod method = DirichletMethod::Cholesky;   // Method actually used (实际使用的方法)
+    size_t unknowns = 0;        // Interior vertices (内部顶点数)
+    size_t boundary = 0;        // Fixed boundary vertices (固定的边界顶点数)
+    bool analyzed = false;      // Symbolic analysis was redone (重新做了符号分析)
+    bool factorized = false;    // Factor/preconditioner was recomputed (重新计算了分解或预处理器)
+    int iterations = 0;         // CG iterations, worst column; 0 for LDLT (CG迭代次数，取各列最大值)
+    int levels = 0;             // Multigrid levels; 0 otherwise (多重网格层数)
+    double residual = 0.0;      // Relative residual |Kx-b|/|b|, worst column (相对残差，取各列最大值)
+};
+
+// Reusable factorization of the Dirichlet Laplace problem L x = 0 with fixed boundary values.
+// Boundary columns are moved to the right-hand side, leaving the symmetric interior block
+// K = -L_II (K x_I = L_IB x_B), which is factored by SimplicialLDLT. The symbolic analysis is
+// kept while the sparsity pattern and boundary set stay the same; the numeric factorization
+// is kept while the weights stay the same as well. All coordinates are solved in one call.
+// With ConjugateGradient/Multigrid the same caching applies to the preconditioner (the AMG
+// aggregates play the role of the symbolic analysis), and the solve starts from the values
+// already in the interior rows of x.
+// With a positive timeStep the cache instead holds one backward-Euler step of the diffusion
+// L x = dx/dt with lumped mass M = diag(mixedArea): (M_I + dt K) x_I' = M_I x_I + dt L_IB x_B.
+// 固定边界值的Dirichlet拉普拉斯问题 L x = 0 的可复用分解。
+// 边界列移到右端，剩下对称的内部块 K = -L_II（K x_I = L_IB x_B），用SimplicialLDLT分解。
+// 稀疏结构与边界集合不变时复用符号分析，权重也不变时复用数值分解。所有坐标一次求解。
+// 使用CG/多重网格时预处理器同样被缓存（AMG聚合相当于符号分析），迭代从x内部行的现有值开始。
+// timeStep为正时改为缓存扩散方程的一步隐式欧拉：(M_I + dt K) x_I' = M_I x_I + dt L_IB x_B，
+// 其中M为混合面积组成的集中质量矩阵
+class DirichletSolverCache {
+public:
+    // Bring the factorization up to date with op (and timeStep); false if it is singular or
+    // has no interior
+    // 使分解与op（及timeStep）保持一致；矩阵奇异或没有内部顶点时返回false
+    bool prepare(const LaplacianOperator& op, double timeStep = 0.0);
+
+    // x: vertexCount x k, boundary rows hold the fixed values, interior rows are overwritten
+    // (they are the initial guess for CG, and x_I of the right-hand side for a time step)
+    // x：vertexCount行k列，边界行为固定值，内部行被求解结果覆盖（CG以其为初值，时间步时即右端的x_I）
+    bool solve(Eigen::MatrixXd& x);
+
+    void clear();
+    void setMethod(DirichletMethod method) { method_ = method; }
+    DirichletMethod method() const { return method_; }
+    const SolveStats& lastStats() const { return stats_; }
+
+    size_t interiorCount() const { return interior_.size(); }
+    int symbolicCount() const { return symbolicCount_; }   // Pattern analyses so far (已进行的符号分析次数)
+    int numericCount() const { return numericCount_; }     // Numeric factorizations so far (已进行的数值分解次数)
+
+private:
+    DirichletMethod method_ = DirichletMethod::Auto;
+    DirichletMethod active_ = DirichletMethod::Cholesky;   // Resolved method of the cached factor (缓存分解对应的方法)
+    SolveStats stats_;
+    uint64_t patternKey_ = 0;           // Hash of offsets/columns/boundary flags (稀疏结构哈希)
+    uint64_t valuesKey_ = 0;            // Hash of the weights (权重哈希)
+    bool analyzed_ = false;
+    bool factorized_ = false;
+    double timeStep_ = 0.0;
+    int symbolicCount_ = 0;
+    int numericCount_ = 0;
+
+    std::vector<unsigned int> interior_;        // Interior unknown -> vertex (内部未知量对应的顶点)
+    Eigen::SparseMatrix<double> stiffness_;     // K = -L_II, or M_I + dt K for a time step (或时间步的M_I + dt K)
+    Eigen::VectorXd mass_;                      // M_I when timeStep > 0 (时间步的内部质量)
+    Eigen::SparseMatrix<double> coupling_;      // L_IB, columns indexed by vertex (以顶点为列的耦合块)
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct_;
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper,
+                             Eigen::IncompleteCholesky<double>> iterative_;
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper,
+                             AlgebraicMultigrid> multigrid_;
+};
+
+} // namespace meshcore
+
+#endif // MESHCORE_SOLVER_CACHE_H
@@ -16,6 +16,7 @@
 #include <QCheckBox>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QProgressBar>
 
 // 声明UIUtils命名空间中的函数
 namespace UIUtils {
@@ -69,6 +70,7 @@ QGroupBox* createRenderingModeGroup(GLWidget* glWidget, QTabWidget* tabWidget) {
     QRadioButton *gaussianRadio = new QRadioButton("Gaussian Curvature");
     QRadioButton *meanRadio = new QRadioButton("Mean Curvature");
     QRadioButton *maxRadio = new QRadioButton("Max Curvature");
+    QRadioButton *directionsRadio = new QRadioButton("Principal Directions");
     QRadioButton *textureRadio = new QRadioButton("Texture Mapping");
     
     solidRadio->setChecked(true);
@@ -77,6 +79,7 @@ QGroupBox* createRenderingModeGroup(GLWidget* glWidget, QTabWidget* tabWidget) {
     layout->addWidget(gaussianRadio);
     layout->addWidget(meanRadio);
     layout->addWidget(maxRadio);
+    layout->addWidget(directionsRadio);
     layout->addWidget(textureRadio);
     
     // 连接渲染模式信号
@@ -93,6 +96,7 @@ QGroupBox* createRenderingModeGroup(GLWidget* glWidget, QTabWidget* tabWidget) {
     connectMode(gaussianRadio, GLWidget::GaussianCurvature);
     connectMode(meanRadio, GLWidget::MeanCurvature);
     connectMode(maxRadio, GLWidget::MaxCurvature);
+    connectMode(directionsRadio, GLWidget::PrincipalDirections);
     connectMode(textureRadio, GLWidget::TextureMapping);
     
     return group;
@@ -182,6 +186,7 @@ QGroupBox* createIterationMethodGroup(GLWidget* glWidget, QTabWidget* tabWidget)
     QRadioButton *cotangentRadio = new QRadioButton("Cotangent Weights");
     QRadioButton *cotangentAreaRadio = new QRadioButton("Cotangent with Area (Laplace-Beltrami)"); 
     QRadioButton *eigenRadio = new QRadioButton("Eigen Sparse Solver");
+    QRadioButton *implicitRadio = new QRadioButton("Implicit Fairing (large steps)");
 
     uniformRadio->setChecked(true);
     
@@ -189,6 +194,7 @@ QGroupBox* createIterationMethodGroup(GLWidget* glWidget, QTabWidget* tabWidget)
     layout->addWidget(cotangentRadio);
     layout->addWidget(cotangentAreaRadio);
     layout->addWidget(eigenRadio);
+    layout->addWidget(implicitRadio);
 
     // 连接迭代方法信号
     auto connectMethod = [glWidget, tabWidget](QRadioButton* radio, GLWidget::IterationMethod method) {
@@ -204,6 +210,7 @@ QGroupBox* createIterationMethodGroup(GLWidget* glWidget, QTabWidget* tabWidget)
     connectMethod(cotangentRadio, GLWidget::CotangentWeights);
     connectMethod(cotangentAreaRadio, GLWidget::CotangentWithArea);
     connectMethod(eigenRadio, GLWidget::EigenSparseSolver);
+    connectMethod(implicitRadio, GLWidget::ImplicitFairing);
 
     return group;
 }
@@ -219,7 +226,7 @@ QGroupBox* createMinimalSurfaceGroup(GLWidget* glWidget, QTabWidget* tabWidget)
     iterationsSpinBox->setValue(10);
     
     QDoubleSpinBox *lambdaSpinBox = new QDoubleSpinBox;
-    lambdaSpinBox->setRange(0.0001, 0.5);
+    lambdaSpinBox->setRange(0.0001, 1000.0);   // 显式格式在GLWidget中截断到0.5
     lambdaSpinBox->setValue(0.1);
     lambdaSpinBox->setSingleStep(0.01);
     lambdaSpinBox->setDecimals(4);
@@ -306,10 +313,45 @@ QGroupBox* createMeshOperationsGroup(GLWidget* glWidget, QTabWidget* tabWidget)
         }
     });
     
+    // 简化算法选项：切换后按当前滑块位置重新简化
+    QRadioButton *progressiveRadio = new QRadioButton("Progressive QEM");
+    QRadioButton *parallelRadio = new QRadioButton("Parallel QEM");
+    QRadioButton *decimaterRadio = new QRadioButton("OpenMesh Decimater");
+    QRadioButton *attributeRadio = new QRadioButton("Attribute QEM (keeps UVs)");
+    progressiveRadio->setChecked(true);
+    auto connectMethod = [glWidget, tabWidget, slider](QRadioButton* radio, GLWidget::SimplificationMethod method) {
+        QObject::connect(radio, &QRadioButton::clicked, [glWidget, tabWidget, slider, method]() {
+            GLWidget* targetWidget = UIUtils::getCurrentGLWidget(glWidget, tabWidget);
+            if (targetWidget) {
+                targetWidget->setSimplificationMethod(method);
+                targetWidget->applyMeshOperation(slider->value());
+            }
+        });
+    };
+    connectMethod(progressiveRadio, GLWidget::ProgressiveQem);
+    connectMethod(parallelRadio, GLWidget::ParallelQem);
+    connectMethod(decimaterRadio, GLWidget::OpenMeshDecimater);
+    connectMethod(attributeRadio, GLWidget::AttributeQem);
+    
+    // 自动LOD：按模型在屏幕上的大小逐帧选择原始网格的简化层级
+    QCheckBox *lodCheckbox = new QCheckBox("Automatic LOD");
+    lodCheckbox->setStyleSheet("color: white;");
+    QObject::connect(lodCheckbox, &QCheckBox::stateChanged, [glWidget, tabWidget](int state) {
+        GLWidget* targetWidget = UIUtils::getCurrentGLWidget(glWidget, tabWidget);
+        if (targetWidget) {
+            targetWidget->setLodEnabled(state == Qt::Checked);
+        }
+    });
+    
     // 添加控件
+    layout->addWidget(progressiveRadio);
+    layout->addWidget(parallelRadio);
+    layout->addWidget(decimaterRadio);
+    layout->addWidget(attributeRadio);
     layout->addWidget(new QLabel("Original                                                     simplify"));
     layout->addWidget(slider);
     layout->addWidget(statusLabel);
+    layout->addWidget(lodCheckbox);
     
     // 添加重置按钮
     QPushButton *resetButton = new QPushButton("Reset to Original");
@@ -362,23 +404,42 @@ QGroupBox* createLoopSubdivisionGroup(GLWidget* glWidget, QTabWidget* tabWidget)
         "QPushButton:disabled { background-color: #404040; color: #808080; }"
     );
     
-    // 连接按钮信号
-    QObject::connect(subdivideButton, &QPushButton::clicked, [glWidget, levelLabel, subdivideButton, tabWidget]() {
+    // 连接按钮信号（细分在后台执行）
+    QObject::connect(subdivideButton, &QPushButton::clicked, [glWidget, tabWidget]() {
         GLWidget* targetWidget = UIUtils::getCurrentGLWidget(glWidget, tabWidget);
         if (targetWidget) {
             targetWidget->performLoopSubdivision();
-            
-            // 更新级别标签
-            int currentLevel = targetWidget->getCurrentSubdivisionLevel();
-            levelLabel->setText(QString("Current Level: %1").arg(currentLevel));
-            
-            // 如果达到最大级别，禁用按钮
-            if (currentLevel >= 3) {
-                subdivideButton->setEnabled(false);
-            }
         }
     });
     
+    // 自适应细分按钮：只细分弯曲或在屏幕上过大的面
+    QPushButton *adaptiveButton = new QPushButton("Adaptive Subdivision");
+    adaptiveButton->setStyleSheet(subdivideButton->styleSheet());
+    QObject::connect(adaptiveButton, &QPushButton::clicked, [glWidget, tabWidget]() {
+        GLWidget* targetWidget = UIUtils::getCurrentGLWidget(glWidget, tabWidget);
+        if (targetWidget) {
+            targetWidget->performAdaptiveSubdivision();
+        }
+    });
+    
+    // 没有平滑组的模型可按二面角补充折痕
+    QCheckBox *creaseCheckbox = new QCheckBox("Creases above 60°");
+    creaseCheckbox->setStyleSheet("color: white;");
+    QObject::connect(creaseCheckbox, &QCheckBox::stateChanged, [glWidget, tabWidget](int state) {
+        GLWidget* targetWidget = UIUtils::getCurrentGLWidget(glWidget, tabWidget);
+        if (targetWidget) {
+            targetWidget->setAdaptiveCreaseAngle(state == Qt::Checked ? 60.0f : 0.0f);
+        }
+    });
+    
+    // 任务完成后更新级别标签；达到最大级别时禁用按钮
+    QObject::connect(glWidget, &GLWidget::meshJobFinished, [glWidget, levelLabel, subdivideButton, adaptiveButton]() {
+        int currentLevel = glWidget->getCurrentSubdivisionLevel();
+        levelLabel->setText(QString("Current Level: %1").arg(currentLevel));
+        subdivideButton->setEnabled(currentLevel < GLWidget::kMaxSubdivisionLevel);
+        adaptiveButton->setEnabled(currentLevel < GLWidget::kMaxSubdivisionLevel);
+    });
+    
     // 添加重置按钮
     QPushButton *resetButton = new QPushButton("Reset Subdivision");
     resetButton->setStyleSheet(
@@ -392,23 +453,78 @@ QGroupBox* createLoopSubdivisionGroup(GLWidget* glWidget, QTabWidget* tabWidget)
         "}"
         "QPushButton:hover { background-color: #606060; }"
     );
-    QObject::connect(resetButton, &QPushButton::clicked, [glWidget, levelLabel, subdivideButton, tabWidget]() {
+    QObject::connect(resetButton, &QPushButton::clicked, [glWidget, tabWidget]() {
         GLWidget* targetWidget = UIUtils::getCurrentGLWidget(glWidget, tabWidget);
         if (targetWidget) {
             targetWidget->resetMeshOperation();
-            levelLabel->setText("Current Level: 0");
-            subdivideButton->setEnabled(true);
         }
     });
     
     // 添加控件
     layout->addWidget(levelLabel);
     layout->addWidget(subdivideButton);
+    layout->addWidget(adaptiveButton);
+    layout->addWidget(creaseCheckbox);
     layout->addWidget(resetButton);
     
     return group;
 }
 
+// 创建后台任务进度组：显示运行中的网格操作并可取消
+QGroupBox* createMeshJobGroup(GLWidget* glWidget) {
+    QGroupBox *group = new QGroupBox("Background Job");
+    QVBoxLayout *layout = new QVBoxLayout(group);
+    
+    QLabel *jobLabel = new QLabel("Idle");
+    jobLabel->setAlignment(Qt::AlignCenter);
+    jobLabel->setStyleSheet("color: white;");
+    
+    QProgressBar *progressBar = new QProgressBar;
+    progressBar->setRange(0, 100);
+    progressBar->setValue(0);
+    
+    QPushButton *cancelButton = new QPushButton("Cancel");
+    cancelButton->setStyleSheet(
+        "QPushButton {"
+        "   background-color: #505050;"
+        "   color: white;"
+        "   border: none;"
+        "   padding: 8px 16px;"
+        "   font-size: 14px;"
+        "   border-radius: 5px;"
+        "}"
+        "QPushButton:hover { background-color: #606060; }"
+        "QPushButton:disabled { background-color: #404040; color: #808080; }"
+    );
+    cancelButton->setEnabled(false);
+    
+    // 开始时显示忙碌状态，直到任务汇报第一个进度
+    QObject::connect(glWidget, &GLWidget::meshJobStarted, [jobLabel, progressBar, cancelButton](const QString& name) {
+        jobLabel->setText(name);
+        progressBar->setRange(0, 0);
+        cancelButton->setEnabled(true);
+    });
+    QObject::connect(glWidget, &GLWidget::meshJobProgress, [progressBar](const QString&, int percent) {
+        progressBar->setRange(0, 100);
+        progressBar->setValue(percent);
+    });
+    QObject::connect(glWidget, &GLWidget::meshJobFinished, [glWidget, jobLabel, progressBar, cancelButton](const QString& name, bool applied) {
+        if (glWidget->isMeshJobRunning()) return;
+        jobLabel->setText(applied ? QString("%1: done").arg(name) : QString("%1: cancelled").arg(name));
+        progressBar->setRange(0, 100);
+        progressBar->setValue(applied ? 100 : 0);
+        cancelButton->setEnabled(false);
+    });
+    QObject::connect(cancelButton, &QPushButton::clicked, [glWidget]() {
+        glWidget->cancelMeshJobs();
+    });
+    
+    layout->addWidget(jobLabel);
+    layout->addWidget(progressBar);
+    layout->addWidget(cancelButton);
+    return group;
+}
+
 // 创建OBJ模型控制面板
 QWidget* createModelControlPanel(GLWidget* glWidget, QLabel* infoLabel, QWidget* mainWindow, QTabWidget* tabWidget) {
     QWidget *panel = new QWidget;
@@ -426,6 +542,7 @@ QWidget* createModelControlPanel(GLWidget* glWidget, QLabel* infoLabel, QWidget*
     // 添加网格操作和Loop细分组（只在模型标签页显示）
     layout->addWidget(createMeshOperationsGroup(glWidget, tabWidget));
     layout->addWidget(createLoopSubdivisionGroup(glWidget, tabWidget));
+    layout->addWidget(createMeshJobGroup(glWidget));
     
     layout->addStretch();
     return panel;
@@ -81,6 +81,7 @@ QGroupBox* createRenderingModeGroupForDualView(GLWidget* leftView, GLWidget* rig
     QRadioButton *gaussianRadio = new QRadioButton("Gaussian Curvature");
     QRadioButton *meanRadio = new QRadioButton("Mean Curvature");
     QRadioButton *maxRadio = new QRadioButton("Max Curvature");
+    QRadioButton *directionsRadio = new QRadioButton("Principal Directions");
     QRadioButton *textureRadio = new QRadioButton("Texture Mapping");
     
     solidRadio->setChecked(true);
@@ -89,6 +90,7 @@ QGroupBox* createRenderingModeGroupForDualView(GLWidget* leftView, GLWidget* rig
     layout->addWidget(gaussianRadio);
     layout->addWidget(meanRadio);
     layout->addWidget(maxRadio);
+    layout->addWidget(directionsRadio);
     layout->addWidget(textureRadio);
     
     // 连接信号：同时设置左右视图
@@ -103,6 +105,7 @@ QGroupBox* createRenderingModeGroupForDualView(GLWidget* leftView, GLWidget* rig
     connectMode(gaussianRadio, GLWidget::GaussianCurvature);
     connectMode(meanRadio, GLWidget::MeanCurvature);
     connectMode(maxRadio, GLWidget::MaxCurvature);
+    connectMode(directionsRadio, GLWidget::PrincipalDirections);
     connectMode(textureRadio, GLWidget::TextureMapping);
     
     return group;
@@ -154,6 +157,9 @@ QWidget* createParameterizationControlPanel(GLWidget* glWidget, QWidget* paramTa
     
     QRadioButton *rectRadio = new QRadioButton("Rectangle");
     QRadioButton *circleRadio = new QRadioButton("Circle");
+    QRadioButton *freeRadio = new QRadioButton("Free (Conformal)");
+    QRadioButton *arapRadio = new QRadioButton("ARAP");
+    QRadioButton *atlasRadio = new QRadioButton("Atlas (closed meshes)");
     rectRadio->setChecked(true);
 
     // 连接边界选项信号
@@ -163,9 +169,21 @@ QWidget* createParameterizationControlPanel(GLWidget* glWidget, QWidget* paramTa
     QObject::connect(circleRadio, &QRadioButton::clicked, [rightView]() {
         rightView->setBoundaryType(GLWidget::Circle);
     });
+    QObject::connect(freeRadio, &QRadioButton::clicked, [rightView]() {
+        rightView->setBoundaryType(GLWidget::FreeBoundary);
+    });
+    QObject::connect(arapRadio, &QRadioButton::clicked, [rightView]() {
+        rightView->setBoundaryType(GLWidget::AsRigidAsPossible);
+    });
+    QObject::connect(atlasRadio, &QRadioButton::clicked, [rightView]() {
+        rightView->setBoundaryType(GLWidget::Atlas);
+    });
     
     boundaryLayout->addWidget(rectRadio);
     boundaryLayout->addWidget(circleRadio);
+    boundaryLayout->addWidget(freeRadio);
+    boundaryLayout->addWidget(arapRadio);
+    boundaryLayout->addWidget(atlasRadio);
     layout->addWidget(boundaryGroup);
     
     // 添加参数化按钮
@@ -184,14 +202,19 @@ QWidget* createParameterizationControlPanel(GLWidget* glWidget, QWidget* paramTa
 
     // 连接参数化按钮信号
     QObject::connect(paramButton, &QPushButton::clicked, [glWidget, paramTab]() {
-        GLWidget* leftView = paramTab->property("leftGLWidget").value<GLWidget*>();
         GLWidget* rightView = paramTab->property("rightGLWidget").value<GLWidget*>();
         
-        // 在右视图执行参数化
+        // 在右视图执行参数化（后台执行，完成后传递纹理坐标）
         rightView->performParameterization();
-        
-        // 将右视图的参数化纹理坐标传递给左视图
-        leftView->setParameterizationTexCoords(rightView->paramTexCoords);
+    });
+    
+    // 将右视图的参数化纹理坐标传递给左视图；图集结果的顶点沿接缝拆分，左视图先换成接缝网格
+    QObject::connect(rightView, &GLWidget::parameterizationFinished, [leftView, rightView]() {
+        if (rightView->atlasMesh) {
+            leftView->applyAtlasMesh(rightView->atlasMesh, rightView->paramTexCoords);
+        } else {
+            leftView->setParameterizationTexCoords(rightView->paramTexCoords);
+        }
     });
     
     layout->addWidget(paramButton);
@@ -0,0 +1,103 @@
+#include "test_common.h"
+#include "adaptive_subdivision.h"
+#include "mesh_io.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+using namespace meshcore;
+
+namespace {
+
+float longestEdge(const FlatMesh& mesh, size_t t)
+{
+    float longest = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+        const float* a = &mesh.positions[3 * mesh.triangles[3 * t + k]];
+        const float* b = &mesh.positions[3 * mesh.triangles[3 * t + (k + 1) % 3]];
+        const float dx = b[0] - a[0], dy = b[1] - a[1], dz = b[2] - a[2];
+        longest = std::max(longest, std::sqrt(dx * dx + dy * dy + dz * dz));
+    }
+    return longest;
+}
+
+std::pair<unsigned int, unsigned int> edgeKey(unsigned int a, unsigned int b)
+{
+    return {std::min(a, b), std::max(a, b)};
+}
+
+} // namespace
+
+MESHCORE_TEST(adaptiveSubdivisionStaysWatertight)
+{
+    // 把x>0的半球拉长，只有那里的面超过屏幕尺寸阈值；曲率阈值关闭
+    FlatMesh control = icosphere(2);
+    for (size_t i = 0; i < control.positions.size(); i += 3) {
+        if (control.positions[i] > 0.0f) control.positions[i] *= 2.0f;
+    }
+    float shortest = 1e30f, longest = 0.0f;
+    for (size_t t = 0; t < control.triangleCount(); ++t) {
+        shortest = std::min(shortest, longestEdge(control, t));
+        longest = std::max(longest, longestEdge(control, t));
+    }
+    AdaptiveSubdivisionOptions options;
+    options.curvatureTolerance = 1e30f;
+    options.maxEdgePixels = 0.5f * (shortest + longest);
+    options.pixelsPerUnit = 1.0f;
+
+    // 独立计算红绿闭包：有两条被分边的面一分为四，只有一条的二等分
+    const size_t faceCount = control.triangleCount();
+    std::vector<unsigned char> refine(faceCount, 0);
+    for (size_t t = 0; t < faceCount; ++t) {
+        refine[t] = longestEdge(control, t) > options.maxEdgePixels ? 1 : 0;
+    }
+    const size_t seeds = std::count(refine.begin(), refine.end(), 1);
+    REQUIRE(seeds > 0 && seeds < faceCount);
+    std::map<std::pair<unsigned int, unsigned int>, unsigned char> split;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t t = 0; t < faceCount; ++t) {
+            const unsigned int* v = &control.triangles[3 * t];
+            int count = 0;
+            for (int k = 0; k < 3; ++k) count += split[edgeKey(v[k], v[(k + 1) % 3])];
+            if (!refine[t] && count >= 2) refine[t] = 1;
+            if (!refine[t]) continue;
+            for (int k = 0; k < 3; ++k) {
+                unsigned char& s = split[edgeKey(v[k], v[(k + 1) % 3])];
+                if (!s) changed = true;
+                s = 1;
+            }
+        }
+    }
+    size_t red = 0, green = 0, splitEdges = 0;
+    for (size_t t = 0; t < faceCount; ++t) {
+        const unsigned int* v = &control.triangles[3 * t];
+        int count = 0;
+        for (int k = 0; k < 3; ++k) count += split[edgeKey(v[k], v[(k + 1) % 3])];
+        if (refine[t]) ++red;
+        else if (count == 1) ++green;
+    }
+    for (const auto& edge : split) splitEdges += edge.second;
+    REQUIRE(red < faceCount);
+
+    Mesh mesh;
+    REQUIRE(fromFlatMesh(control, mesh));
+    size_t refined = 0;
+    REQUIRE(adaptiveSubdivide(mesh, options, &refined));
+    CHECK(refined == red);
+    CHECK(mesh.n_faces() == faceCount + 3 * red + green);
+    CHECK(mesh.n_vertices() == control.vertexCount() + splitEdges);
+
+    FlatMesh result;
+    toFlatMesh(mesh, result);
+    CHECK(isClosedManifold(result));
+    CHECK(eulerCharacteristic(result) == 2);
+
+    // 第二步中二等分出的面只能一分为四，结果仍然封闭
+    options.maxEdgePixels = 0.5f * options.maxEdgePixels;
+    REQUIRE(adaptiveSubdivide(mesh, options));
+    toFlatMesh(mesh, result);
+    CHECK(isClosedManifold(result));
+    CHECK(eulerCharacteristic(result) == 2);
+}
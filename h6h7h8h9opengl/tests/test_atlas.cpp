@@ -0,0 +1,127 @@
+#include "test_common.h"
+#include "atlas_packer.h"
+#include "chart_atlas.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace meshcore;
+
+MESHCORE_TEST(chartAtlasChartsAreDisks)
+{
+    for (const FlatMesh& mesh : {torus(96, 48), icosphere(3)}) {
+        ChartAtlas atlas;
+        REQUIRE(buildChartAtlas(mesh, ChartAtlasOptions(), atlas));
+        REQUIRE(atlas.chartCount > 1);
+        REQUIRE(atlas.faceChart.size() == mesh.triangleCount());
+        REQUIRE(atlas.mesh.triangleCount() == mesh.triangleCount());
+        REQUIRE(atlas.texCoords.size() == 2 * atlas.mesh.vertexCount());
+
+        // 每个图块连通且欧拉示性数为1即为拓扑圆盘；拆分后的顶点只属于一个图块，各图块互不相连
+        std::vector<FlatMesh> charts(atlas.chartCount);
+        for (size_t f = 0; f < mesh.triangleCount(); ++f) {
+            const unsigned int* v = &atlas.mesh.triangles[3 * f];
+            charts[atlas.faceChart[f]].triangles.insert(charts[atlas.faceChart[f]].triangles.end(), v, v + 3);
+        }
+        size_t nonDisks = 0;
+        for (const FlatMesh& chart : charts) nonDisks += eulerCharacteristic(chart) != 1;
+        CHECK(nonDisks == 0);
+        CHECK(eulerCharacteristic(atlas.mesh) == static_cast<int>(atlas.chartCount));
+
+        CHECK(flippedTriangles(atlas.mesh, atlas.texCoords) == 0);
+        const auto range = std::minmax_element(atlas.texCoords.begin(), atlas.texCoords.end());
+        CHECK(*range.first >= 0.0f && *range.second <= 1.0f);
+    }
+}
+
+MESHCORE_TEST(atlasPackerRectsDoNotOverlap)
+{
+    // 随机尺寸、随机朝向的矩形图块（含狭长图块）
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> size(0.02, 0.5), angle(0.0, M_PI), aspect(1.0, 8.0);
+    const size_t chartCount = 300;
+    std::vector<unsigned int> chartBegin(1, 0);
+    std::vector<double> uv;
+    for (size_t c = 0; c < chartCount; ++c) {
+        const double w = size(random) * aspect(random), h = size(random);
+        const double theta = angle(random), cs = std::cos(theta), sn = std::sin(theta);
+        const double corners[4][2] = {{0, 0}, {w, 0}, {w, h}, {0, h}};
+        for (const auto& p : corners) {
+            uv.push_back(cs * p[0] - sn * p[1] + c);
+            uv.push_back(sn * p[0] + cs * p[1]);
+        }
+        chartBegin.push_back(chartBegin.back() + 4);
+    }
+    // 所有uv重合的退化图块
+    for (int k = 0; k < 4; ++k) uv.insert(uv.end(), {chartCount + 0.5, 0.25});
+    chartBegin.push_back(chartBegin.back() + 4);
+
+    AtlasPackOptions options;
+    options.resolution = 2048;
+    options.padding = 2;
+    std::vector<float> texCoords;
+    AtlasPackResult result;
+    REQUIRE(packAtlas(chartBegin, uv, options, texCoords, &result));
+    REQUIRE(texCoords.size() == uv.size());
+    CHECK(result.width > 0 && result.width <= options.resolution);
+    CHECK(result.height > 0 && result.height <= options.resolution);
+    CHECK(result.fill > 0.0f && result.fill <= 1.0f);
+
+    // 图块的包围矩形（纹素）都在图集内且互不重叠
+    struct Rect { double x0, y0, x1, y1; };
+    std::vector<Rect> rects;
+    for (size_t c = 0; c + 1 < chartBegin.size(); ++c) {
+        Rect r = {1e30, 1e30, -1e30, -1e30};
+        for (unsigned int v = chartBegin[c]; v < chartBegin[c + 1]; ++v) {
+            const double x = texCoords[2 * v] * double(result.width), y = texCoords[2 * v + 1] * double(result.height);
+            r = {std::min(r.x0, x), std::min(r.y0, y), std::max(r.x1, x), std::max(r.y1, y)};
+        }
+        rects.push_back(r);
+    }
+    const float lo = *std::min_element(texCoords.begin(), texCoords.end());
+    const float hi = *std::max_element(texCoords.begin(), texCoords.end());
+    CHECK(lo >= 0.0f && hi <= 1.0f);
+    size_t overlaps = 0;
+    const double tolerance = 1e-3;
+    for (size_t a = 0; a < rects.size(); ++a) {
+        for (size_t b = a + 1; b < rects.size(); ++b) {
+            const double w = std::min(rects[a].x1, rects[b].x1) - std::max(rects[a].x0, rects[b].x0);
+            const double h = std::min(rects[a].y1, rects[b].y1) - std::max(rects[a].y0, rects[b].y0);
+            overlaps += w > tolerance && h > tolerance;
+        }
+    }
+    CHECK(overlaps == 0);
+
+    // 退化图块落在自己的位置上，不在其他图块内部
+    const Rect& point = rects.back();
+    CHECK(point.x1 - point.x0 < tolerance && point.y1 - point.y0 < tolerance);
+    size_t inside = 0;
+    for (size_t a = 0; a + 1 < rects.size(); ++a) {
+        inside += point.x0 > rects[a].x0 + tolerance && point.x0 < rects[a].x1 - tolerance &&
+                  point.y0 > rects[a].y0 + tolerance && point.y0 < rects[a].y1 - tolerance;
+    }
+    CHECK(inside == 0);
+}
+
+MESHCORE_TEST(atlasPackerRespectsResolution)
+{
+    // 300个单位正方形图块：每个至少占(1 + padding)^2纹素，32x32的图集放不下
+    std::vector<unsigned int> chartBegin(1, 0);
+    std::vector<double> uv;
+    for (size_t c = 0; c < 300; ++c) {
+        const double corners[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+        for (const auto& p : corners) uv.insert(uv.end(), {p[0] + 2.0 * c, p[1]});
+        chartBegin.push_back(chartBegin.back() + 4);
+    }
+
+    AtlasPackOptions options;
+    options.padding = 2;
+    std::vector<float> texCoords;
+    AtlasPackResult result;
+    options.resolution = 32;
+    CHECK(!packAtlas(chartBegin, uv, options, texCoords, &result));
+
+    options.resolution = 256;
+    REQUIRE(packAtlas(chartBegin, uv, options, texCoords, &result));
+    CHECK(result.width <= options.resolution && result.height <= options.resolution);
+}
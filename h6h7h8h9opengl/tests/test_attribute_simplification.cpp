@@ -0,0 +1,102 @@
+#include "test_common.h"
+#include "attribute_simplification.h"
+#include "mesh_io.h"
+#include <cmath>
+
+using namespace meshcore;
+
+namespace {
+
+// 沿一条母线剪开的圆管：第rings列复制第0列的位置，u从0到1，接缝两侧的顶点重合
+FlatMesh cutTube(int rings, int sides, std::vector<float>& uv)
+{
+    FlatMesh mesh;
+    uv.clear();
+    for (int j = 0; j <= sides; ++j) {
+        for (int i = 0; i <= rings; ++i) {
+            const float u = 2.0f * static_cast<float>(M_PI) * (i % rings) / rings;
+            mesh.positions.insert(mesh.positions.end(), {std::cos(u), std::sin(u), 2.0f * j / sides});
+            uv.insert(uv.end(), {static_cast<float>(i) / rings, static_cast<float>(j) / sides});
+        }
+    }
+    for (int j = 0; j < sides; ++j) {
+        for (int i = 0; i < rings; ++i) {
+            const unsigned int a = j * (rings + 1) + i, b = a + 1;
+            const unsigned int c = a + rings + 1, d = c + 1;
+            mesh.triangles.insert(mesh.triangles.end(), {a, b, d, a, d, c});
+        }
+    }
+    return mesh;
+}
+
+// 位置与纹理坐标；锁定的顶点经过归一化往返，只差舍入误差
+struct Attributes {
+    float value[5];
+};
+
+Attributes attributes(const Mesh& mesh, Mesh::VertexHandle vh)
+{
+    const Mesh::Point& p = mesh.point(vh);
+    const Mesh::TexCoord2D& t = mesh.texcoord2D(vh);
+    return {{p[0], p[1], p[2], t[0], t[1]}};
+}
+
+bool contains(const std::vector<Attributes>& list, const Attributes& a)
+{
+    for (const Attributes& b : list) {
+        bool same = true;
+        for (int k = 0; k < 5; ++k) same = same && std::fabs(a.value[k] - b.value[k]) < 1e-5f;
+        if (same) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+MESHCORE_TEST(attributeQemKeepsSeams)
+{
+    std::vector<float> uv;
+    const FlatMesh tube = cutTube(32, 16, uv);
+    Mesh mesh;
+    REQUIRE(fromFlatMesh(tube, mesh));
+    mesh.request_vertex_texcoords2D();
+    for (auto vh : mesh.vertices()) {
+        mesh.set_texcoord2D(vh, Mesh::TexCoord2D(uv[2 * vh.idx()], uv[2 * vh.idx() + 1]));
+    }
+    std::vector<Attributes> seam;
+    for (auto vh : mesh.vertices()) {
+        if (mesh.is_boundary(vh)) seam.push_back(attributes(mesh, vh));
+    }
+
+    const size_t vertexCount = mesh.n_vertices();
+    REQUIRE(simplifyMeshWithAttributes(mesh, 0.75f));
+    REQUIRE(mesh.has_vertex_texcoords2D());
+    CHECK(mesh.n_vertices() == vertexCount / 4);
+
+    // 仍是一个圆盘：F = 2V - B - 2，面数随顶点数一起达到目标
+    size_t boundary = 0;
+    for (auto vh : mesh.vertices()) {
+        if (!mesh.is_boundary(vh)) continue;
+        ++boundary;
+        // 接缝顶点锁定：留下的位置与纹理坐标都是原来的某个接缝顶点
+        CHECK(contains(seam, attributes(mesh, vh)));
+    }
+    CHECK(mesh.n_faces() == 2 * mesh.n_vertices() - boundary - 2);
+    CHECK(mesh.n_faces() < tube.triangleCount() / 3);
+
+    // 接缝两侧的u仍是0与1，内部纹理坐标有限且没有翻转
+    size_t left = 0, right = 0;
+    std::vector<float> simplifiedUv(2 * mesh.n_vertices());
+    for (auto vh : mesh.vertices()) {
+        const Mesh::TexCoord2D& t = mesh.texcoord2D(vh);
+        CHECK(std::isfinite(t[0]) && std::isfinite(t[1]));
+        simplifiedUv[2 * vh.idx()] = t[0];
+        simplifiedUv[2 * vh.idx() + 1] = t[1];
+        if (std::fabs(t[0]) < 1e-6f) ++left;
+        if (std::fabs(t[0] - 1.0f) < 1e-6f) ++right;
+    }
+    CHECK(left >= 2 && right >= 2);
+    FlatMesh simplified;
+    toFlatMesh(mesh, simplified);
+    CHECK(flippedTriangles(simplified, simplifiedUv) == 0);
+}
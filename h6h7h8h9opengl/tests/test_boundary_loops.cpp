@@ -0,0 +1,104 @@
+#include "test_common.h"
+#include "boundary_loops.h"
+#include "mesh_io.h"
+#include "parameterization.h"
+#include <cmath>
+
+using namespace meshcore;
+
+namespace {
+
+const int kCells = 12;
+
+// 单位正方形上的网格，略微弯曲；去掉两块格子得到两个大小不同的洞
+bool inHole(int i, int j)
+{
+    const bool large = i >= 2 && i <= 4 && j >= 2 && j <= 4;
+    const bool small = i >= 7 && i <= 8 && j >= 6 && j <= 7;
+    return large || small;
+}
+
+FlatMesh diskWithTwoHoles()
+{
+    FlatMesh mesh;
+    for (int j = 0; j <= kCells; ++j) {
+        for (int i = 0; i <= kCells; ++i) {
+            const float x = static_cast<float>(i) / kCells, y = static_cast<float>(j) / kCells;
+            mesh.positions.insert(mesh.positions.end(), {x, y, 0.2f * std::sin(static_cast<float>(M_PI) * x)});
+        }
+    }
+    for (int j = 0; j < kCells; ++j) {
+        for (int i = 0; i < kCells; ++i) {
+            if (inHole(i, j)) continue;
+            const unsigned int a = j * (kCells + 1) + i, b = a + 1;
+            const unsigned int c = a + kCells + 1, d = c + 1;
+            mesh.triangles.insert(mesh.triangles.end(), {a, b, d, a, d, c});
+        }
+    }
+    removeUnreferencedVertices(mesh);
+    return mesh;
+}
+
+// 环在uv中围成的有向面积
+double signedArea(const Mesh& mesh, const BoundaryLoop& loop)
+{
+    double area = 0.0;
+    for (size_t i = 0; i < loop.vertices.size(); ++i) {
+        const Mesh::Point& a = mesh.point(loop.vertices[i]);
+        const Mesh::Point& b = mesh.point(loop.vertices[(i + 1) % loop.vertices.size()]);
+        area += 0.5 * (double(a[0]) * b[1] - double(b[0]) * a[1]);
+    }
+    return area;
+}
+
+} // namespace
+
+MESHCORE_TEST(boundaryLoopsDiskWithTwoHoles)
+{
+    const FlatMesh disk = diskWithTwoHoles();
+    REQUIRE(eulerCharacteristic(disk) == -1);
+    Mesh mesh;
+    REQUIRE(fromFlatMesh(disk, mesh));
+
+    // 外边界最长，其后是两个洞按周长排列；每个环的相邻顶点由边界半边相连
+    const std::vector<BoundaryLoop> loops = findBoundaryLoops(mesh);
+    REQUIRE(loops.size() == 3);
+    CHECK(loops[0].vertices.size() == 4 * kCells);
+    CHECK(loops[1].vertices.size() == 12);
+    CHECK(loops[2].vertices.size() == 8);
+    CHECK(loops[0].length > loops[1].length && loops[1].length > loops[2].length);
+    for (auto vh : loops[0].vertices) {
+        const Mesh::Point& p = mesh.point(vh);
+        CHECK(p[0] == 0.0f || p[0] == 1.0f || p[1] == 0.0f || p[1] == 1.0f);
+    }
+    for (const BoundaryLoop& loop : loops) {
+        for (size_t i = 0; i < loop.vertices.size(); ++i) {
+            const auto heh = mesh.find_halfedge(loop.vertices[i], loop.vertices[(i + 1) % loop.vertices.size()]);
+            CHECK(heh.is_valid() && mesh.is_boundary(heh));
+        }
+    }
+
+    // 外边界钉在单位圆上；洞边顶点由扇形补上后自由求解，落在圆内且不翻转
+    REQUIRE(parameterize(mesh, ParamBoundary::Circle));
+    std::vector<float> uv(2 * mesh.n_vertices());
+    for (auto vh : mesh.vertices()) {
+        const Mesh::Point& p = mesh.point(vh);
+        CHECK(std::isfinite(p[0]) && std::isfinite(p[1]));
+        uv[2 * vh.idx()] = p[0];
+        uv[2 * vh.idx() + 1] = p[1];
+    }
+    for (auto vh : loops[0].vertices) {
+        const Mesh::Point& p = mesh.point(vh);
+        CHECK(std::fabs(std::sqrt(p[0] * p[0] + p[1] * p[1]) - 1.0f) < 1e-5f);
+    }
+    for (size_t k = 1; k < loops.size(); ++k) {
+        for (auto vh : loops[k].vertices) {
+            const Mesh::Point& p = mesh.point(vh);
+            CHECK(std::sqrt(p[0] * p[0] + p[1] * p[1]) < 0.99f);
+        }
+        // 扇形与面的朝向一致，洞在uv中仍张开
+        CHECK(signedArea(mesh, loops[k]) > 0.0);
+    }
+    CHECK(signedArea(mesh, loops[0]) < 0.0);
+    CHECK(flippedTriangles(disk, uv) == 0);
+}
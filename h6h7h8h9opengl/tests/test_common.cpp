@@ -0,0 +1,124 @@
+#include "test_common.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <utility>
+
+using meshcore::FlatMesh;
+
+FlatMesh icosphere(int subdivisions)
+{
+    const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+    FlatMesh mesh;
+    mesh.positions = {-1, t, 0, 1, t, 0, -1, -t, 0, 1, -t, 0,
+                      0, -1, t, 0, 1, t, 0, -1, -t, 0, 1, -t,
+                      t, 0, -1, t, 0, 1, -t, 0, -1, -t, 0, 1};
+    mesh.triangles = {0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11,
+                      1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+                      3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9,
+                      4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1};
+
+    // 每次细分把三角形四等分，边中点按边共享
+    for (int s = 0; s < subdivisions; ++s) {
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> midpoints;
+        const auto midpoint = [&](unsigned int a, unsigned int b) {
+            const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midpoints.find(key);
+            if (it != midpoints.end()) return it->second;
+            const unsigned int index = static_cast<unsigned int>(mesh.vertexCount());
+            for (int k = 0; k < 3; ++k) {
+                mesh.positions.push_back((mesh.positions[3 * a + k] + mesh.positions[3 * b + k]) / 2.0f);
+            }
+            midpoints.emplace(key, index);
+            return index;
+        };
+        std::vector<unsigned int> triangles;
+        for (size_t f = 0; f < mesh.triangles.size(); f += 3) {
+            const unsigned int a = mesh.triangles[f], b = mesh.triangles[f + 1], c = mesh.triangles[f + 2];
+            const unsigned int ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+            triangles.insert(triangles.end(), {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca});
+        }
+        mesh.triangles.swap(triangles);
+    }
+
+    for (size_t i = 0; i < mesh.positions.size(); i += 3) {
+        float* p = &mesh.positions[i];
+        const float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        for (int k = 0; k < 3; ++k) p[k] /= length;
+    }
+    return mesh;
+}
+
+FlatMesh torus(int rings, int sides)
+{
+    FlatMesh mesh;
+    for (int j = 0; j < sides; ++j) {
+        for (int i = 0; i < rings; ++i) {
+            const float u = 2.0f * static_cast<float>(M_PI) * i / rings;
+            const float v = 2.0f * static_cast<float>(M_PI) * j / sides;
+            const float r = 1.0f + 0.4f * std::cos(v);
+            mesh.positions.insert(mesh.positions.end(), {r * std::cos(u), r * std::sin(u), 0.4f * std::sin(v)});
+        }
+    }
+    for (int j = 0; j < sides; ++j) {
+        for (int i = 0; i < rings; ++i) {
+            const unsigned int a = j * rings + i, b = j * rings + (i + 1) % rings;
+            const unsigned int c = ((j + 1) % sides) * rings + i, d = ((j + 1) % sides) * rings + (i + 1) % rings;
+            mesh.triangles.insert(mesh.triangles.end(), {a, b, d, a, d, c});
+        }
+    }
+    return mesh;
+}
+
+FlatMesh sphericalCap(int subdivisions, float minZ)
+{
+    FlatMesh sphere = icosphere(subdivisions);
+    FlatMesh cap;
+    cap.positions = sphere.positions;
+    for (size_t f = 0; f < sphere.triangles.size(); f += 3) {
+        const unsigned int* v = &sphere.triangles[f];
+        if (sphere.positions[3 * v[0] + 2] > minZ && sphere.positions[3 * v[1] + 2] > minZ &&
+            sphere.positions[3 * v[2] + 2] > minZ) {
+            cap.triangles.insert(cap.triangles.end(), v, v + 3);
+        }
+    }
+    meshcore::removeUnreferencedVertices(cap);
+    return cap;
+}
+
+bool isClosedManifold(const FlatMesh& mesh)
+{
+    std::set<std::pair<unsigned int, unsigned int>> directed;
+    for (size_t f = 0; f < mesh.triangles.size(); f += 3) {
+        const unsigned int* v = &mesh.triangles[f];
+        if (v[0] == v[1] || v[1] == v[2] || v[2] == v[0]) return false;
+        for (int k = 0; k < 3; ++k) {
+            if (!directed.insert({v[k], v[(k + 1) % 3]}).second) return false;
+        }
+    }
+    for (const auto& edge : directed) {
+        if (!directed.count({edge.second, edge.first})) return false;
+    }
+    return true;
+}
+
+int eulerCharacteristic(const FlatMesh& mesh)
+{
+    std::set<unsigned int> vertices;
+    std::set<std::pair<unsigned int, unsigned int>> edges;
+    for (size_t f = 0; f < mesh.triangles.size(); f += 3) {
+        const unsigned int* v = &mesh.triangles[f];
+        for (int k = 0; k < 3; ++k) {
+            vertices.insert(v[k]);
+            edges.insert({std::min(v[k], v[(k + 1) % 3]), std::max(v[k], v[(k + 1) % 3])});
+        }
+    }
+    return static_cast<int>(vertices.size()) - static_cast<int>(edges.size()) + static_cast<int>(mesh.triangleCount());
+}
+
+std::string temporaryPath(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / ("meshcore_tests_" + name)).string();
+}
@@ -0,0 +1,65 @@
+#ifndef MESHCORE_TEST_COMMON_H
+#define MESHCORE_TEST_COMMON_H
+
+#include "flat_mesh.h"
+#include <string>
+#include <vector>
+
+// Minimal test registry for meshcore_tests. Every MESHCORE_TEST registers itself by name;
+// CTest runs each one as "meshcore_tests <name>". CHECK records a failure and continues,
+// REQUIRE records it and leaves the test.
+// meshcore_tests的最小测试注册表。每个MESHCORE_TEST按名称自动注册，CTest以"meshcore_tests <name>"
+// 逐个运行。CHECK记录失败后继续，REQUIRE记录失败后退出该用例
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& testRegistry();
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*run)()) { testRegistry().push_back({name, run}); }
+};
+
+void reportFailure(const char* file, int line, const char* expression);
+
+#define MESHCORE_TEST(name) \
+    static void name(); \
+    static TestRegistrar name##Registrar(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { if (!(condition)) reportFailure(__FILE__, __LINE__, #condition); } while (0)
+
+#define REQUIRE(condition) \
+    do { if (!(condition)) { reportFailure(__FILE__, __LINE__, #condition); return; } } while (0)
+
+// Test shapes (测试用的网格)
+meshcore::FlatMesh icosphere(int subdivisions);                 // Unit sphere, closed (单位球，封闭)
+meshcore::FlatMesh torus(int rings, int sides);                 // Genus 1, closed (亏格1，封闭)
+meshcore::FlatMesh sphericalCap(int subdivisions, float minZ);  // Faces of icosphere above minZ, a disk (icosphere中z大于minZ的面，圆盘)
+
+// Every triangle is non-degenerate, every directed edge is used once and has its twin
+// 所有三角形非退化，每条有向边只出现一次且有反向边
+bool isClosedManifold(const meshcore::FlatMesh& mesh);
+int eulerCharacteristic(const meshcore::FlatMesh& mesh);        // V - E + F over referenced vertices (被引用顶点的V - E + F)
+
+// Triangles whose uv image (2 values per vertex) has non-positive signed area
+// uv像（每个顶点2个值）有向面积不为正的三角形数
+template <typename T>
+size_t flippedTriangles(const meshcore::FlatMesh& mesh, const std::vector<T>& uv)
+{
+    size_t flipped = 0;
+    for (size_t t = 0; t < mesh.triangleCount(); ++t) {
+        const unsigned int* v = &mesh.triangles[3 * t];
+        const double ax = double(uv[2 * v[1]]) - uv[2 * v[0]], ay = double(uv[2 * v[1] + 1]) - uv[2 * v[0] + 1];
+        const double bx = double(uv[2 * v[2]]) - uv[2 * v[0]], by = double(uv[2 * v[2] + 1]) - uv[2 * v[0] + 1];
+        if (ax * by - ay * bx <= 0.0) ++flipped;
+    }
+    return flipped;
+}
+
+std::string temporaryPath(const std::string& name);             // File in the system temp directory (系统临时目录中的文件)
+
+#endif // MESHCORE_TEST_COMMON_H
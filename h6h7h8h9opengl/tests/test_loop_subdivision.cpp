@@ -0,0 +1,90 @@
+#include "test_common.h"
+#include "loop_subdivision.h"
+#include <cmath>
+#include <set>
+
+using namespace meshcore;
+
+namespace {
+
+bool near(const float* p, float x, float y, float z)
+{
+    return std::fabs(p[0] - x) < 1e-6f && std::fabs(p[1] - y) < 1e-6f && std::fabs(p[2] - z) < 1e-6f;
+}
+
+} // namespace
+
+MESHCORE_TEST(loopSubdivisionCounts)
+{
+    // 封闭网格：V' = V + E，F' = 4F，E' = 2E + 3F
+    FlatMesh mesh = icosphere(0);
+    std::vector<unsigned int> edges;
+    REQUIRE(loopSubdivide(mesh, 1, &edges));
+    CHECK(mesh.vertexCount() == 12 + 30);
+    CHECK(mesh.triangleCount() == 4 * 20);
+    CHECK(edges.size() == 2 * (2 * 30 + 3 * 20));
+    CHECK(isClosedManifold(mesh));
+
+    REQUIRE(loopSubdivide(mesh, 2, &edges));
+    CHECK(mesh.vertexCount() == 42 + 120 + 480);
+    CHECK(mesh.triangleCount() == 80 * 16);
+    CHECK(edges.size() / 2 == mesh.vertexCount() + mesh.triangleCount() - 2);
+    CHECK(isClosedManifold(mesh));
+    CHECK(eulerCharacteristic(mesh) == 2);
+}
+
+MESHCORE_TEST(loopSubdivisionInteriorRule)
+{
+    // 内部旧顶点：(1 - nβ) p + β Σ 邻点（Loop 1987）
+    const FlatMesh control = icosphere(0);
+    std::set<unsigned int> ring;
+    for (size_t f = 0; f < control.triangles.size(); f += 3) {
+        for (int k = 0; k < 3; ++k) {
+            if (control.triangles[f + k] != 0) continue;
+            ring.insert(control.triangles[f + (k + 1) % 3]);
+            ring.insert(control.triangles[f + (k + 2) % 3]);
+        }
+    }
+    REQUIRE(ring.size() == 5);
+    // β(n) = (5/8 - (3/8 + cos(2π/n)/4)^2) / n
+    const float c = 0.375f + 0.25f * std::cos(2.0f * static_cast<float>(M_PI) / 5.0f);
+    const float beta = (0.625f - c * c) / 5.0f;
+    float expected[3];
+    for (int a = 0; a < 3; ++a) {
+        expected[a] = (1.0f - 5.0f * beta) * control.positions[a];
+        for (unsigned int v : ring) expected[a] += beta * control.positions[3 * v + a];
+    }
+
+    FlatMesh mesh = control;
+    REQUIRE(loopSubdivide(mesh, 1));
+    CHECK(near(&mesh.positions[0], expected[0], expected[1], expected[2]));
+}
+
+MESHCORE_TEST(loopSubdivisionBoundaryRules)
+{
+    // 单个三角形全是边界：旧顶点取3/4 p + 1/8 (两个边界邻点)，边中点取两端点的平均
+    FlatMesh mesh;
+    mesh.positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    mesh.triangles = {0, 1, 2};
+    std::vector<unsigned int> edges;
+    REQUIRE(loopSubdivide(mesh, 1, &edges));
+    REQUIRE(mesh.vertexCount() == 6);
+    CHECK(mesh.triangleCount() == 4);
+    CHECK(edges.size() == 2 * 9);
+    CHECK(near(&mesh.positions[0], 0.125f, 0.125f, 0.0f));
+    CHECK(near(&mesh.positions[3], 0.75f, 0.125f, 0.0f));
+    CHECK(near(&mesh.positions[6], 0.125f, 0.75f, 0.0f));
+    int midpoints = 0;
+    for (size_t v = 3; v < 6; ++v) {
+        const float* p = &mesh.positions[3 * v];
+        midpoints += near(p, 0.5f, 0.0f, 0.0f) || near(p, 0.5f, 0.5f, 0.0f) || near(p, 0.0f, 0.5f, 0.0f);
+    }
+    CHECK(midpoints == 3);
+
+    // 带边界的网格细分后仍是圆盘
+    FlatMesh cap = sphericalCap(2, 0.5f);
+    const size_t faces = cap.triangleCount();
+    REQUIRE(loopSubdivide(cap, 2));
+    CHECK(cap.triangleCount() == 16 * faces);
+    CHECK(eulerCharacteristic(cap) == 1);
+}
@@ -0,0 +1,43 @@
+#include "test_common.h"
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+int failures = 0;
+
+} // namespace
+
+std::vector<TestCase>& testRegistry()
+{
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+void reportFailure(const char* file, int line, const char* expression)
+{
+    std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+    ++failures;
+}
+
+// 无参数时运行全部用例，否则只运行给出名称的用例；有失败时返回非0
+int main(int argc, char* argv[])
+{
+    int run = 0;
+    for (const TestCase& test : testRegistry()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i) {
+            selected = std::strcmp(argv[i], test.name) == 0;
+        }
+        if (!selected) continue;
+        const int before = failures;
+        test.run();
+        std::cout << (failures == before ? "[pass] " : "[FAIL] ") << test.name << std::endl;
+        ++run;
+    }
+    if (run == 0) {
+        std::cerr << "No test matches the given names" << std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include "test_common.h"
+#include "mesh_cache.h"
+#include "mesh_io.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace meshcore;
+
+namespace {
+
+const char* kOctahedron =
+    "v 1 0 0\nv -1 0 0\nv 0 1 0\nv 0 -1 0\nv 0 0 1\nv 0 0 -1\n"
+    "f 1 3 5\nf 3 2 5\nf 2 4 5\nf 4 1 5\nf 3 1 6\nf 2 3 6\nf 4 2 6\nf 1 4 6\n";
+
+// 写出源OBJ，按查看器的方式加载并为其写入缓存
+bool writeCacheFor(const std::string& source, Mesh& mesh, std::vector<unsigned int>& faces,
+                   std::vector<unsigned int>& edges)
+{
+    std::ofstream(source) << kOctahedron;
+    mesh.clear();
+    if (!loadMesh(mesh, source)) return false;
+    mesh.update_normals();
+    buildFaceIndices(mesh, faces);
+    buildEdgeIndices(mesh, edges);
+    return writeMeshCache(meshCachePath(source), source, mesh, faces, edges);
+}
+
+void removeCache(const std::string& source)
+{
+    std::remove(meshCachePath(source).c_str());
+    std::remove(source.c_str());
+}
+
+} // namespace
+
+MESHCORE_TEST(meshCacheRoundTrip)
+{
+    const std::string source = temporaryPath("round_trip.obj");
+    Mesh mesh;
+    std::vector<unsigned int> faces, edges;
+    REQUIRE(writeCacheFor(source, mesh, faces, edges));
+
+    MappedMeshCache cache;
+    REQUIRE(cache.open(meshCachePath(source), source));
+    CHECK(cache.vertexCount() == mesh.n_vertices());
+    CHECK(cache.faceCount() == mesh.n_faces());
+    REQUIRE(cache.faceIndexCount() == faces.size());
+    REQUIRE(cache.edgeIndexCount() == edges.size());
+    CHECK(std::equal(faces.begin(), faces.end(), cache.faceIndices()));
+    CHECK(std::equal(edges.begin(), edges.end(), cache.edgeIndices()));
+
+    Mesh restored;
+    REQUIRE(cache.restoreMesh(restored));
+    REQUIRE(restored.n_vertices() == mesh.n_vertices());
+    CHECK(restored.n_faces() == mesh.n_faces());
+    CHECK(restored.n_edges() == mesh.n_edges());
+    for (auto vh : mesh.vertices()) {
+        CHECK(restored.point(vh) == mesh.point(vh));
+        CHECK(restored.normal(vh) == mesh.normal(vh));
+    }
+    for (auto heh : mesh.halfedges()) {
+        CHECK(restored.to_vertex_handle(heh) == mesh.to_vertex_handle(heh));
+        CHECK(restored.next_halfedge_handle(heh) == mesh.next_halfedge_handle(heh));
+    }
+    cache.close();
+    removeCache(source);
+}
+
+MESHCORE_TEST(meshCacheRejectsStaleSource)
+{
+    const std::string source = temporaryPath("stale.obj");
+    Mesh mesh;
+    std::vector<unsigned int> faces, edges;
+    REQUIRE(writeCacheFor(source, mesh, faces, edges));
+
+    MappedMeshCache cache;
+    CHECK(cache.open(meshCachePath(source), source));
+    cache.close();
+
+    // 源文件改变后缓存失效
+    std::ofstream(source, std::ios::app) << "# changed\n";
+    CHECK(!cache.open(meshCachePath(source), source));
+    CHECK(cache.vertexCount() == 0);
+    removeCache(source);
+}
+
+MESHCORE_TEST(meshCacheRejectsCorruptIndices)
+{
+    const std::string source = temporaryPath("corrupt.obj");
+    Mesh mesh;
+    std::vector<unsigned int> faces, edges;
+    REQUIRE(writeCacheFor(source, mesh, faces, edges));
+
+    // 在缓存文件中定位面索引段，把其中一个索引改为越界值
+    const std::string cachePath = meshCachePath(source);
+    std::vector<char> bytes;
+    {
+        std::ifstream in(cachePath, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const char* pattern = reinterpret_cast<const char*>(faces.data());
+    const size_t patternBytes = 12 * sizeof(unsigned int);
+    const auto found = std::search(bytes.begin(), bytes.end(), pattern, pattern + patternBytes);
+    REQUIRE(found != bytes.end());
+    const unsigned int outOfRange = static_cast<unsigned int>(mesh.n_vertices()) + 7;
+    std::memcpy(&*found + 4 * sizeof(unsigned int), &outOfRange, sizeof(outOfRange));
+    {
+        std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    MappedMeshCache cache;
+    CHECK(!cache.open(cachePath, source));
+    CHECK(cache.vertexCount() == 0);
+    removeCache(source);
+}
@@ -0,0 +1,59 @@
+#include "test_common.h"
+#include "arap_parameterization.h"
+#include "conformal_parameterization.h"
+#include <cmath>
+
+using namespace meshcore;
+
+namespace {
+
+// 圆盘上LSCM的初始映射：固定x方向上相距最远的两个边界顶点
+bool conformalMap(const FlatMesh& disk, std::vector<double>& uv)
+{
+    VertexCorners adjacency;
+    adjacency.build(disk);
+    std::vector<unsigned char> isBoundary;
+    markBoundaryVertices(disk, adjacency, isBoundary);
+    unsigned int pins[2] = {0, 0};
+    bool found = false;
+    for (unsigned int v = 0; v < disk.vertexCount(); ++v) {
+        if (!isBoundary[v]) continue;
+        if (!found || disk.positions[3 * v] < disk.positions[3 * pins[0]]) pins[0] = v;
+        if (!found || disk.positions[3 * v] > disk.positions[3 * pins[1]]) pins[1] = v;
+        found = true;
+    }
+    if (!found || pins[0] == pins[1]) return false;
+    const float* a = &disk.positions[3 * pins[0]];
+    const float* b = &disk.positions[3 * pins[1]];
+    const double distance = std::sqrt(double(b[0] - a[0]) * (b[0] - a[0]) + double(b[1] - a[1]) * (b[1] - a[1]) +
+                                      double(b[2] - a[2]) * (b[2] - a[2]));
+    const double pinValues[2][2] = {{0.0, 0.0}, {distance, 0.0}};
+    ConformalSolverCache cache;
+    return cache.solve(disk, pins, pinValues, uv);
+}
+
+} // namespace
+
+MESHCORE_TEST(lscmDiskHasNoFlips)
+{
+    const FlatMesh disk = sphericalCap(4, 0.2f);
+    REQUIRE(eulerCharacteristic(disk) == 1);
+    std::vector<double> uv;
+    REQUIRE(conformalMap(disk, uv));
+    REQUIRE(uv.size() == 2 * disk.vertexCount());
+    CHECK(flippedTriangles(disk, uv) == 0);
+}
+
+MESHCORE_TEST(arapDiskHasNoFlips)
+{
+    const FlatMesh disk = sphericalCap(4, 0.2f);
+    std::vector<double> uv;
+    REQUIRE(conformalMap(disk, uv));
+
+    std::vector<ArapIteration> log;
+    REQUIRE(arapParameterize(disk, uv, 10, &log));
+    REQUIRE(log.size() == 10);
+    CHECK(flippedTriangles(disk, uv) == 0);
+    CHECK(log.back().energy <= log.front().energy);
+    for (double value : uv) CHECK(std::isfinite(value));
+}
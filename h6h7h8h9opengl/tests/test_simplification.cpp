@@ -0,0 +1,94 @@
+#include "test_common.h"
+#include "parallel_simplification.h"
+#include "progressive_mesh.h"
+#include <set>
+
+using namespace meshcore;
+
+namespace {
+
+// 某层级的有效三角形；保留的顶点不移动，位置即源网格的位置
+FlatMesh activeMesh(const FlatMesh& source, const ProgressiveMesh& pm, const ProgressiveMesh::Level& level)
+{
+    FlatMesh mesh;
+    mesh.positions = source.positions;
+    mesh.triangles.assign(level.faces.begin(), level.faces.begin() + pm.faceIndexCount(level.collapses));
+    return mesh;
+}
+
+size_t referencedVertices(const FlatMesh& mesh)
+{
+    return std::set<unsigned int>(mesh.triangles.begin(), mesh.triangles.end()).size();
+}
+
+} // namespace
+
+MESHCORE_TEST(progressiveMeshSeekIsReversible)
+{
+    const FlatMesh sphere = icosphere(3);
+    ProgressiveMesh pm;
+    REQUIRE(pm.build(sphere));
+    const size_t target = pm.collapsesForRatio(0.5f);
+    REQUIRE(target > 0 && target < pm.maxCollapses());
+
+    ProgressiveMesh::Level direct;
+    pm.reset(direct);
+    pm.seek(direct, target);
+    const FlatMesh level = activeMesh(sphere, pm, direct);
+    CHECK(isClosedManifold(level));
+    CHECK(eulerCharacteristic(level) == 2);
+    CHECK(referencedVertices(level) == sphere.vertexCount() - target);
+
+    // 先越过目标再回到目标（向下），以及先停在目标之前再前进（向上），索引缓冲应与直接到达时完全相同
+    ProgressiveMesh::Level down;
+    pm.reset(down);
+    pm.seek(down, pm.maxCollapses());
+    pm.seek(down, target);
+    CHECK(down.collapses == target);
+    CHECK(down.faces == direct.faces);
+    CHECK(down.edges == direct.edges);
+
+    ProgressiveMesh::Level up;
+    pm.reset(up);
+    pm.seek(up, target / 3);
+    pm.seek(up, target);
+    CHECK(up.faces == direct.faces);
+    CHECK(up.edges == direct.edges);
+
+    // 回到第0层即为全分辨率
+    ProgressiveMesh::Level full;
+    pm.reset(full);
+    pm.seek(down, 0);
+    CHECK(down.faces == full.faces);
+    CHECK(down.edges == full.edges);
+    CHECK(pm.faceIndexCount(0) == sphere.triangles.size());
+}
+
+MESHCORE_TEST(parallelQemReachesTarget)
+{
+    for (const FlatMesh& source : {icosphere(4), torus(64, 32)}) {
+        const int chi = eulerCharacteristic(source);
+        for (float ratio : {0.5f, 0.9f}) {
+            FlatMesh mesh = source;
+            ParallelSimplifyStats stats;
+            std::vector<unsigned int> sourceVertex;
+            REQUIRE(simplifyFlatMesh(mesh, ratio, &stats, &sourceVertex));
+            const size_t target = static_cast<size_t>(source.vertexCount() * (1.0f - ratio));
+            CHECK(mesh.vertexCount() == target);
+            CHECK(stats.collapses == source.vertexCount() - target);
+            CHECK(stats.rounds > 0 && stats.rounds < stats.collapses);
+            CHECK(isClosedManifold(mesh));
+            CHECK(eulerCharacteristic(mesh) == chi);
+            CHECK(referencedVertices(mesh) == mesh.vertexCount());
+
+            // 幸存顶点按顺序对应到不同的输入顶点
+            REQUIRE(sourceVertex.size() == mesh.vertexCount());
+            bool increasing = true;
+            for (size_t v = 0; v < sourceVertex.size(); ++v) {
+                increasing = increasing && sourceVertex[v] < source.vertexCount() &&
+                             (v == 0 || sourceVertex[v] > sourceVertex[v - 1]);
+            }
+            CHECK(increasing);
+        }
+    }
+}
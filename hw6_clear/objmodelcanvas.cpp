@@ -7,6 +7,8 @@
 #include <QDebug>
 #include <QDir>
 #include <algorithm>  // 用于std::sort
+#include <charconv>
+#include <cstring>
 #include <mutex>
 #include <omp.h>
 #include <thread>
@@ -461,47 +463,76 @@ void ObjModelCanvas::parseObjFile(const QString &filePath)
         qWarning() << "OBJ file does not exist:" << absolutePath;
         return;
     }
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    QFile file(absolutePath);
+    if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Failed to open OBJ file:" << filePath;
         return;
     }
     
-    QTextStream in(&file);
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (line.isEmpty() || line.startsWith("#")) continue;
-        
-        QStringList tokens = line.split(" ", QString::SkipEmptyParts);
-        if (tokens.isEmpty()) continue;
-        
-        QString identifier = tokens[0];
-        
-        if (identifier == "v") {
-            if (tokens.size() >= 4) {
-                Vector3f vertex;
-                vertex[0] = tokens[1].toFloat();
-                vertex[1] = tokens[2].toFloat();
-                vertex[2] = tokens[3].toFloat();
+    // 直接映射文件并用from_chars解析，避免逐行构造QString
+    const qint64 fileSize = file.size();
+    uchar *mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    QByteArray fallback;
+    if (!mapped && fileSize > 0) {
+        fallback = file.readAll();
+    }
+    const char *p = mapped ? reinterpret_cast<const char *>(mapped) : fallback.constData();
+    const char *end = p + (mapped ? fileSize : fallback.size());
+    
+    auto skipSpaces = [&]() {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    };
+    auto atLineEnd = [&]() {
+        return p >= end || *p == '\n' || *p == '\r' || *p == '#';
+    };
+    
+    while (p < end) {
+        skipSpaces();
+        if (p + 1 < end && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+            p += 2;
+            Vector3f vertex;
+            int parsed = 0;
+            for (; parsed < 3; parsed++) {
+                skipSpaces();
+                if (p < end && *p == '+') ++p;
+                auto res = std::from_chars(p, end, vertex[parsed]);
+                if (res.ec != std::errc()) break;
+                p = res.ptr;
+            }
+            if (parsed == 3) {
                 model.vertices.push_back(vertex);
             }
-        } else if (identifier == "f") {
+        } else if (p + 1 < end && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            p += 2;
             Face face;
-            for (int i = 1; i < tokens.size(); i++) {
-                QStringList indices = tokens[i].split("/");
-                if (!indices.isEmpty()) {
-                    int vertexIndex = indices[0].toInt() - 1;
-                    if (vertexIndex >= 0 && vertexIndex < model.vertices.size()) {
+            const int vertexCount = static_cast<int>(model.vertices.size());
+            for (;;) {
+                skipSpaces();
+                if (atLineEnd()) break;
+                int index = 0;
+                auto res = std::from_chars(p, end, index);
+                if (res.ec == std::errc()) {
+                    p = res.ptr;
+                    // 负索引相对于已读入的顶点
+                    int vertexIndex = index > 0 ? index - 1 : vertexCount + index;
+                    if (index != 0 && vertexIndex >= 0 && vertexIndex < vertexCount) {
                         face.vertexIndices.push_back(vertexIndex);
                     }
                 }
+                // 跳过纹理/法线索引
+                while (p < end && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') ++p;
             }
             if (!face.vertexIndices.empty()) {
                 model.faces.push_back(face);
             }
         }
+        const char *nl = static_cast<const char *>(memchr(p, '\n', end - p));
+        p = nl ? nl + 1 : end;
     }
     
+    if (mapped) {
+        file.unmap(mapped);
+    }
     file.close();
     
     // 计算法向量